@@ -0,0 +1,65 @@
+#include "ReceiverConfiguration.h"
+#include <RF24.h>
+#include <Servo.h>
+
+#include <PayloadCodec.h>
+#include "ReceiverLink.h"
+#include "ServoOutput.h"
+
+
+
+static_assert(N_CHANNELS == PAYLOAD_N_CHANNELS, "Wire format must carry every channel");
+static_assert(FAILSAFE_TIMEOUT_MS < RF_RECEIVER_LINK_LOST_MS, "Outputs must go to failsafe before the link is given up");
+
+RF24          Radio;
+uint16_t      u16_Channels[N_CHANNELS];   // Values of the last channel frame decoded
+unsigned long u32_LastFrameTime = 0ul;    // millis() of the last channel frame decoded
+unsigned long u32_LoopStartTime = 0ul;    // micros()
+
+
+boolean b_initRadio(RF24* pRadio)
+{
+  *pRadio = RF24(RX_RF24_CE_PIN, RX_RF24_CSN_PIN);
+  bool b_Success = pRadio->begin();
+  if(b_Success)
+  {
+    pRadio->enableDynamicPayloads(); // Same frame sizes as the transmitter sends
+    pRadio->enableAckPayload();      // Telemetry goes back with the ACKs
+    pRadio->setAddressWidth(RF_ADDRESS_SIZE);
+    pRadio->openReadingPipe(1, RF_Address);
+    pRadio->startListening(); // Turn on RX Mode, the chip ACKs on its own from now on
+  }
+  else
+  {
+    Serial.println("Failed init radio");
+  }
+
+  return b_Success;
+}
+
+
+void setup()
+{
+  Serial.begin(115200);
+  v_Srv_init(ServoPins, FailsafeValues); // Failsafe outputs until the first frame
+  b_initRadio(&Radio);
+  v_Rxl_init(&Radio);
+}
+
+void loop()
+{
+  unsigned long u32_Now      = micros();
+  uint16_t      u16_LoopTime = (uint16_t)min(u32_Now - u32_LoopStartTime, 0xFFFFul);
+  u32_LoopStartTime = u32_Now;
+
+  if(b_Rxl_poll(u16_Channels, u16_LoopTime))
+  {
+    v_Srv_write(u16_Channels);
+    u32_LastFrameTime = millis();
+  }
+  else if(!b_Srv_isFailsafe() && ((millis() - u32_LastFrameTime) > FAILSAFE_TIMEOUT_MS))
+  {
+    v_Srv_enterFailsafe();
+    Serial.println(F("Failsafe"));
+  }
+}
@@ -0,0 +1,50 @@
+/**
+ * @file ReceiverConfiguration.h
+ * @author Marcelo Fraga
+ * @brief Arduino pinout definition and configuration of the receiver module of the RC Transmitter.
+ *        Everything both ends must agree on (channels, radio link, FREQUENCY_HOPPING, RATE_CONTROL) comes from
+ *        LinkConfiguration.h and the wire format from PayloadCodec, in the RCLink library the transmitter builds with
+ *        as well: flash both after a change there.
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef RECEIVERCONFIGURATION_H
+#define RECEIVERCONFIGURATION_H
+#include <LinkConfiguration.h>
+
+
+/* 
+ *  PIN Definitions  
+*/
+
+#define RX_RF24_CE_PIN            9
+#define RX_RF24_CSN_PIN           10 // SPI on 11 (MOSI), 12 (MISO) and 13 (SCK)
+
+// Servo output of each channel, in payload order. The Servo library takes Timer1 (no PWM on pins 9 and 10)
+const uint8_t ServoPins[N_CHANNELS] = {2, 3, 4, 5, 6, 7, 8, A0};
+
+
+/* Servo outputs */
+#define SERVO_PULSE_MIN_US 1000u // Channel value ANALOG_MIN_VALUE
+#define SERVO_PULSE_MAX_US 2000u // Channel value ANALOG_MAX_VALUE
+
+/* Failsafe */
+#define FAILSAFE_TIMEOUT_MS 250u     // No channel frame for this long: the outputs go to their failsafe values
+#define FAILSAFE_HOLD       0xFFFFu  // Failsafe value of a channel that keeps the last value received
+
+// Failsafe value of each channel, in payload order: throttle cut, sticks centered, pots and switches held.
+// Until the first frame, held channels are centered
+const uint16_t FailsafeValues[N_CHANNELS] =
+                  // JLX,             JLY (throttle),   JRX,               JRY,               PL,            PR,            SWL,           SWR
+                  {ANALOG_HALF_VALUE, ANALOG_MIN_VALUE, ANALOG_HALF_VALUE, ANALOG_HALF_VALUE, FAILSAFE_HOLD, FAILSAFE_HOLD, FAILSAFE_HOLD, FAILSAFE_HOLD};
+
+/* Radio configuration */
+#define RX_TX_PERIOD_US   (1000000ul / TX_RATE_HZ)
+#define RX_HOP_TIMEOUT_US ((3u * RX_TX_PERIOD_US) / 2u) // No frame for 1.5 TX periods after the last one: it was lost, the receiver moves on to the next hop channel
+#define RX_HOP_MAX_MISSED_SLOTS ((uint8_t)((FAILSAFE_TIMEOUT_MS * 1000ul) / RX_TX_PERIOD_US)) // Slots it keeps hopping in step for, then it stays on its channel in case the slots were off
+
+#endif
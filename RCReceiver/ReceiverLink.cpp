@@ -0,0 +1,189 @@
+/**
+ * @file ReceiverLink.cpp
+ * @author Marcelo Fraga
+ * @brief Receiver side of the radio link. See ReceiverLink.h
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ReceiverLink.h"
+#include <LinkSetting.h> // The rate controller itself runs on the transmitter
+
+static_assert(PAYLOAD_BIND_SIZE(PAYLOAD_MAX_HOP_CHANNELS) <= RF24_MAX_PAYLOAD_SIZE, "Frames are read into one radio payload");
+
+static RF24*         rxlRadio;
+static RxlState      rxlState;
+static PldDecoder_t  rxlDecoder;
+static unsigned long rxlLastFrameTime;   // millis() of the last frame, bind or channel
+static bool          rxlLinkUp;          // A frame came within RF_RECEIVER_LINK_LOST_MS
+#if FREQUENCY_HOPPING == ON
+static uint8_t       rxlHopChannels[PAYLOAD_MAX_HOP_CHANNELS];
+static uint8_t       rxlNHopChannels;
+static uint8_t       rxlNextSequence;    // Sequence number of the frame expected on the current channel
+static uint8_t       rxlFirstSequence;   // Sent on the first hop channel, see FrequencyHopping.h
+static bool          rxlBound;           // Waiting on the first hop channel for the first frame after the bind
+static uint8_t       rxlMissedSlots;     // TX periods without a frame since the last one
+static unsigned long rxlHopTime;         // micros() of the last channel frame, plus a TX period per slot missed since
+#endif
+
+
+/** Internal functions **/
+// Returns whether <pChannels> got new values
+static bool b_Rxl_handleFrame(const uint8_t* pFrame, uint8_t size, uint16_t* pChannels, uint16_t loopTime);
+// Hop timeout and link lost
+static void v_Rxl_checkLink();
+// Base settings, bind channel
+static void v_Rxl_resetLink();
+#if RATE_CONTROL == ON
+static void v_Rxl_applySetting(uint8_t setting);
+#endif
+#if FREQUENCY_HOPPING == ON
+static void v_Rxl_listenFor(uint8_t sequence);
+#endif
+
+
+void v_Rxl_init(RF24* pRadio)
+{
+    rxlRadio = pRadio;
+    v_Pld_initDecoder(&rxlDecoder);
+    v_Rxl_resetLink();
+}
+
+bool b_Rxl_poll(uint16_t* pChannels, uint16_t loopTime)
+{
+    uint8_t frame[RF24_MAX_PAYLOAD_SIZE];
+    bool    updated = false;
+
+    while(rxlRadio->available())
+    {
+        uint8_t size = rxlRadio->getDynamicPayloadSize();
+        if((size == 0u) || (size > RF24_MAX_PAYLOAD_SIZE))
+        {
+            rxlRadio->flush_rx(); // Corrupt payload length, same as the library advises
+            break;
+        }
+        rxlRadio->read(frame, size);
+        updated |= b_Rxl_handleFrame(frame, size, pChannels, loopTime);
+    }
+    v_Rxl_checkLink();
+    return updated;
+}
+
+RxlState e_Rxl_getState()
+{
+    return rxlState;
+}
+
+const PldDecoder_t* p_Rxl_getDecoder()
+{
+    return &rxlDecoder;
+}
+
+
+static bool b_Rxl_handleFrame(const uint8_t* pFrame, uint8_t size, uint16_t* pChannels, uint16_t loopTime)
+{
+    PldTelemetry_t telemetry;
+    uint8_t        telemetryFrame[PAYLOAD_TELEMETRY_SIZE];
+    uint16_t       received = rxlDecoder.u16_Received;
+    bool           decoded;
+
+#if FREQUENCY_HOPPING == ON
+    if(b_Pld_decodeBind(pFrame, size, rxlHopChannels, &rxlNHopChannels))
+    {
+        rxlState         = RXL_HOPPING; // Acknowledged by the chip already: the transmitter starts hopping
+        rxlLastFrameTime = millis();
+        rxlLinkUp        = true;
+        rxlBound         = true;
+        rxlFirstSequence = 0u; // Sequence numbers count the slots since the bind until the first frame
+        rxlMissedSlots   = 0u;
+        rxlHopTime       = micros();
+        v_Rxl_listenFor(0u);
+        return false;
+    }
+#endif
+    decoded = b_Pld_decode(&rxlDecoder, pFrame, size, pChannels);
+    if(rxlDecoder.u16_Received == received)
+    {
+        return false; // Not a channel frame of this format version
+    }
+    rxlLastFrameTime = millis();
+    rxlLinkUp        = true;
+#if FREQUENCY_HOPPING == ON
+    if(rxlState == RXL_HOPPING)
+    {
+        if(rxlBound)
+        {
+            rxlFirstSequence = rxlDecoder.u8_LastSequence - rxlNextSequence;
+            rxlBound         = false;
+        }
+        rxlMissedSlots = 0u;
+        rxlHopTime     = micros();
+        v_Rxl_listenFor(rxlDecoder.u8_LastSequence + 1u);
+    }
+#endif
+#if RATE_CONTROL == ON
+    uint8_t setting;
+    if(b_Pld_decodeLinkSetting(pFrame, size, &setting))
+    {
+        v_Rxl_applySetting(setting); // The next frame comes on it
+    }
+#endif
+
+    telemetry.u8_LastSequence = rxlDecoder.u8_LastSequence;
+    telemetry.u16_Received    = rxlDecoder.u16_Received;
+    telemetry.u16_Lost        = rxlDecoder.u16_Lost;
+    telemetry.u16_LoopTime    = loopTime;
+    telemetry.u16_Voltage     = 0u; // Not measured
+    rxlRadio->writeAckPayload(1, telemetryFrame, u8_Pld_encodeTelemetry(&telemetry, telemetryFrame));
+    return decoded;
+}
+
+static void v_Rxl_checkLink()
+{
+    if(rxlLinkUp && ((millis() - rxlLastFrameTime) > RF_RECEIVER_LINK_LOST_MS))
+    {
+        v_Rxl_resetLink();
+        return;
+    }
+#if FREQUENCY_HOPPING == ON
+    // Past its slot, the frame was lost: on to the channel of the next one, one TX period later. Without a frame for
+    // RX_HOP_MAX_MISSED_SLOTS the slots may be off, the receiver stays where it is and the transmitter comes by within
+    // n frames
+    if((rxlState == RXL_HOPPING) && (rxlMissedSlots < RX_HOP_MAX_MISSED_SLOTS) && ((micros() - rxlHopTime) > RX_HOP_TIMEOUT_US))
+    {
+        rxlMissedSlots++;
+        rxlHopTime += RX_TX_PERIOD_US;
+        v_Rxl_listenFor(rxlNextSequence + 1u);
+    }
+#endif
+}
+
+static void v_Rxl_resetLink()
+{
+    rxlState  = RXL_BINDING;
+    rxlLinkUp = false;
+    rxlRadio->setChannel(RF_CHANNEL);
+#if RATE_CONTROL == ON
+    v_Rxl_applySetting(RCT_BASE_SETTING);
+#endif
+}
+
+#if RATE_CONTROL == ON
+static void v_Rxl_applySetting(uint8_t setting)
+{
+    rxlRadio->setDataRate(RCT_SETTING_DATA_RATE(setting));
+    rxlRadio->setPALevel(RCT_SETTING_PA_LEVEL(setting)); // ACKs go out on it
+}
+#endif
+
+#if FREQUENCY_HOPPING == ON
+// The chip keeps listening, only the channel register changes
+static void v_Rxl_listenFor(uint8_t sequence)
+{
+    rxlNextSequence = sequence;
+    rxlRadio->setChannel(rxlHopChannels[(uint8_t)(sequence - rxlFirstSequence) & (rxlNHopChannels - 1u)]);
+}
+#endif
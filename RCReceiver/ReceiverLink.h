@@ -0,0 +1,50 @@
+/**
+ * @file ReceiverLink.h
+ * @author Marcelo Fraga
+ * @brief Receiver side of the radio link. Reads the frames the nRF24 received and follows the transmitter:
+ *  - Bind (FREQUENCY_HOPPING): listens on RF_CHANNEL for a bind frame. Its ACK tells the transmitter to start
+ *    hopping, the receiver then listens on the first hop channel, where the first channel frame goes, and goes on
+ *    from there as below.
+ *  - Hopping: after the frame of sequence number s, listens on the hop channel of s + 1. With nothing for
+ *    RX_HOP_TIMEOUT_US, that frame was lost: it moves on to the channel of s + 2, and so on every TX period, in step
+ *    with the transmitter (one frame per period, failed ones included, see RF_RETRY_COUNT). After RX_HOP_MAX_MISSED_SLOTS
+ *    slots without a frame it stays on its channel until the transmitter comes by. Any frame received gives the
+ *    sequence number back.
+ *  - Link settings (RATE_CONTROL): a channel frame carrying a link setting switches the data rate and PA level once
+ *    received. The transmitter does the same once it is acknowledged, see RCRemote/RateControl.h.
+ *  - Link lost: nothing received for RF_RECEIVER_LINK_LOST_MS, back to the base settings and to binding, where the
+ *    transmitter ends up as well.
+ * Channel frames are decoded by PayloadCodec. Telemetry (PldTelemetry_t) is preloaded as ACK payload after each one.
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef RECEIVERLINK_H
+#define RECEIVERLINK_H
+#include "ReceiverConfiguration.h"
+#include <PayloadCodec.h>
+#include <RF24.h>
+
+enum RxlState
+{
+    RXL_BINDING,    // Waiting for a bind frame on RF_CHANNEL. Without FREQUENCY_HOPPING, never left
+    RXL_HOPPING
+};
+
+
+/// @brief Takes over <pRadio>, which must be initialized and listening with ACK payloads enabled. Starts binding.
+void     v_Rxl_init(RF24* pRadio);
+
+/// @brief Reads every frame received so far. Returns true when <pChannels> (PAYLOAD_N_CHANNELS) got the values of a
+///        new channel frame. <loopTime> (uSeconds) goes into the telemetry.
+bool     b_Rxl_poll(uint16_t* pChannels, uint16_t loopTime);
+
+RxlState e_Rxl_getState();
+
+/// @brief Decoder counters (frames received, lost), see PldDecoder_t.
+const PldDecoder_t* p_Rxl_getDecoder();
+
+#endif
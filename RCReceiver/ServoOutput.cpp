@@ -0,0 +1,66 @@
+/**
+ * @file ServoOutput.cpp
+ * @author Marcelo Fraga
+ * @brief Servo PWM outputs of the receiver. See ServoOutput.h
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ServoOutput.h"
+#include <Servo.h>
+
+static_assert(N_CHANNELS <= MAX_SERVOS, "One servo timer drives up to MAX_SERVOS outputs");
+
+static Servo           srvServos[N_CHANNELS];
+static const uint16_t* srvFailsafeValues;
+static bool            srvFailsafe;
+
+
+void v_Srv_init(const uint8_t* pPins, const uint16_t* pFailsafeValues)
+{
+    uint8_t i;
+
+    srvFailsafeValues = pFailsafeValues;
+    for(i = 0; i < N_CHANNELS; i++)
+    {
+        srvServos[i].attach(pPins[i], SERVO_PULSE_MIN_US, SERVO_PULSE_MAX_US);
+        srvServos[i].writeMicroseconds(u16_Srv_toPulse(ANALOG_HALF_VALUE)); // Held channels, until the first frame
+    }
+    v_Srv_enterFailsafe();
+}
+
+void v_Srv_write(const uint16_t* pChannels)
+{
+    uint8_t i;
+    for(i = 0; i < N_CHANNELS; i++)
+    {
+        srvServos[i].writeMicroseconds(u16_Srv_toPulse(pChannels[i]));
+    }
+    srvFailsafe = false;
+}
+
+void v_Srv_enterFailsafe()
+{
+    uint8_t i;
+    for(i = 0; i < N_CHANNELS; i++)
+    {
+        if(srvFailsafeValues[i] != FAILSAFE_HOLD)
+        {
+            srvServos[i].writeMicroseconds(u16_Srv_toPulse(srvFailsafeValues[i]));
+        }
+    }
+    srvFailsafe = true;
+}
+
+bool b_Srv_isFailsafe()
+{
+    return srvFailsafe;
+}
+
+uint16_t u16_Srv_toPulse(uint16_t value)
+{
+    return (uint16_t)map(min(value, (uint16_t)ANALOG_MAX_VALUE), ANALOG_MIN_VALUE, ANALOG_MAX_VALUE, SERVO_PULSE_MIN_US, SERVO_PULSE_MAX_US);
+}
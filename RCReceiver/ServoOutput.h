@@ -0,0 +1,31 @@
+/**
+ * @file ServoOutput.h
+ * @author Marcelo Fraga
+ * @brief Servo PWM outputs of the receiver, one per channel. Channel values (ANALOG_MIN_VALUE - ANALOG_MAX_VALUE) are
+ * mapped to SERVO_PULSE_MIN_US - SERVO_PULSE_MAX_US pulses, generated by the Servo library (Timer1 interrupt, 50Hz).
+ * In failsafe, every channel with a failsafe value other than FAILSAFE_HOLD goes to it, the others keep their pulse.
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef SERVOOUTPUT_H
+#define SERVOOUTPUT_H
+#include "ReceiverConfiguration.h"
+
+/// @brief Attaches a servo to each of the N_CHANNELS <pPins> and starts in failsafe. <pFailsafeValues> must stay valid.
+void     v_Srv_init(const uint8_t* pPins, const uint16_t* pFailsafeValues);
+
+/// @brief Outputs the N_CHANNELS values of <pChannels>. Leaves failsafe.
+void     v_Srv_write(const uint16_t* pChannels);
+
+void     v_Srv_enterFailsafe();
+
+bool     b_Srv_isFailsafe();
+
+/// @brief Pulse width of a channel value, in uSeconds.
+uint16_t u16_Srv_toPulse(uint16_t value);
+
+#endif
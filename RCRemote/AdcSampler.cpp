@@ -0,0 +1,118 @@
+/**
+ * @file AdcSampler.cpp
+ * @author Marcelo Fraga
+ * @brief Interrupt driven analog sampling. See AdcSampler.h
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "AdcSampler.h"
+
+#if ADC_SAMPLER == ON
+
+static_assert(ADC_OVERSAMPLING_BITS <= 3u, "Accumulator is 16 bits: at most 64 samples of 10 bits");
+
+static uint8_t           adcPins[ADC_MAX_PINS];
+static uint8_t           adcNPins;
+
+// Round <adcRound> is published in adcResults[adcRound & 1], the ISR fills the other buffer
+static uint16_t          adcResults[2][ADC_MAX_PINS];
+static volatile uint8_t  adcRound;
+
+#if defined(__AVR__)
+static uint8_t           adcSlot;        // Pin currently being converted
+static uint8_t           adcSampleCount;
+static uint16_t          adcAccumulator;
+static bool              adcDiscard;
+
+ISR(ADC_vect)
+{
+    uint16_t sample = ADC;
+    if(adcDiscard)
+    {
+        adcDiscard = false;
+        return;
+    }
+
+    adcAccumulator += sample;
+    if(++adcSampleCount < ADC_SAMPLES_PER_RESULT)
+    {
+        return;
+    }
+    adcResults[(adcRound + 1u) & 1u][adcSlot] = adcAccumulator >> ADC_OVERSAMPLING_BITS;
+    adcAccumulator = 0;
+    adcSampleCount = 0;
+    if(++adcSlot >= adcNPins)
+    {
+        adcSlot = 0;
+        adcRound++; // Publishes the buffer just completed
+    }
+
+    // Takes effect on the next conversion, the one already running is still on the previous pin
+    ADMUX      = (ADMUX & 0xF0u) | ((adcPins[adcSlot] - A0) & 0x07u);
+    adcDiscard = true;
+}
+#endif
+
+
+void v_Adc_init(const uint8_t* pPins, uint8_t nPins)
+{
+    uint8_t i;
+
+    adcNPins = min(nPins, ADC_MAX_PINS);
+    for(i = 0; i < adcNPins; i++)
+    {
+        adcPins[i]       = pPins[i];
+        adcResults[0][i] = (uint16_t)analogRead(pPins[i]) << ADC_OVERSAMPLING_BITS;
+        adcResults[1][i] = adcResults[0][i];
+    }
+    adcRound = 0;
+
+#if defined(__AVR__)
+    noInterrupts();
+    adcSlot        = 0;
+    adcSampleCount = 0;
+    adcAccumulator = 0;
+    adcDiscard     = true;
+    for(i = 0; i < adcNPins; i++)
+    {
+        if((adcPins[i] - A0) < 6u) // A6 and A7 have no digital input buffer
+        {
+            DIDR0 |= (1u << (adcPins[i] - A0));
+        }
+    }
+    ADMUX  = (1 << REFS0) | ((adcPins[0] - A0) & 0x07u);                  // AVcc reference, same as analogRead
+    ADCSRB = 0;                                                             // Free running trigger
+    ADCSRA = (1 << ADEN) | (1 << ADSC) | (1 << ADATE) | (1 << ADIE) |
+             (1 << ADPS2) | (1 << ADPS1);                                   // clk/64: 250kHz ADC clock, 52us per conversion
+    interrupts();
+#endif
+}
+
+uint8_t u8_Adc_getResults(uint16_t* pResults)
+{
+    uint8_t round;
+#if defined(__AVR__)
+    // The ISR only writes the published buffer again a whole round later, a copy never takes that long. The round is
+    // checked anyway, so a copy interrupted for that long is simply retried.
+    do
+    {
+        round = adcRound;
+        memcpy(pResults, adcResults[round & 1u], adcNPins * sizeof(uint16_t));
+    } while(round != adcRound);
+#else
+    uint8_t i;
+    for(i = 0; i < adcNPins; i++) // No ADC interrupt on the host, every call is a new round of plain reads
+    {
+        adcResults[0][i] = (uint16_t)analogRead(adcPins[i]) << ADC_OVERSAMPLING_BITS;
+        pResults[i]      = adcResults[0][i];
+    }
+    round = ++adcRound;
+#endif
+    return round;
+}
+
+#endif
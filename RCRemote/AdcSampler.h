@@ -0,0 +1,46 @@
+/**
+ * @file AdcSampler.h
+ * @author Marcelo Fraga
+ * @brief Interrupt driven analog sampling. The ADC runs in free running mode and the conversion complete ISR
+ * round-robins the configured pins: the first conversion after each mux switch is discarded (it was already running
+ * on the previous pin), then 4^ADC_OVERSAMPLING_BITS conversions are summed and decimated to 10 + ADC_OVERSAMPLING_BITS
+ * bits. Results are double buffered and published once per complete round, so the main loop reads a consistent set
+ * without blocking and without waiting for a conversion.
+ * analogRead() can't be used while the sampler runs.
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef ADCSAMPLER_H
+#define ADCSAMPLER_H
+#include "Configuration.h"
+
+#if (ADC_SAMPLER == ON) && (BATTERY_INDICATION == ON)
+#error "Battery indication uses analogRead, which doesn't work while the ADC sampler runs"
+#endif
+
+#define ADC_MAX_PINS           8u
+#define ADC_RESULT_BITS        (10u + ADC_OVERSAMPLING_BITS)
+#define ADC_SAMPLES_PER_RESULT (1u << (2u * ADC_OVERSAMPLING_BITS))
+
+
+/// @brief Starts sampling <nPins> analog pins (A0 - A7) in the given order. Each pin is read once with analogRead first,
+///        so results are valid from the start.
+void    v_Adc_init(const uint8_t* pPins, uint8_t nPins);
+
+/// @brief Copies the last complete round of results (ADC_RESULT_BITS each, in pin order) to <pResults>.
+///        Returns the round number, which changes whenever new results were published.
+uint8_t u8_Adc_getResults(uint16_t* pResults);
+
+/// @brief Converts a result to the 10 bit range of the processing chain. Rounded, the extra oversampled bits still
+///        average out the noise. Inline, it runs for every channel on every sample.
+static inline uint16_t u16_Adc_toAnalog(uint16_t result)
+{
+    uint16_t value = (result + ((1u << ADC_OVERSAMPLING_BITS) >> 1)) >> ADC_OVERSAMPLING_BITS;
+    return min(value, (uint16_t)ANALOG_MAX_VALUE);
+}
+
+#endif
@@ -0,0 +1,182 @@
+/**
+ * @file ButtonEvents.cpp
+ * @author Marcelo Fraga
+ * @brief Interrupt driven button input. See ButtonEvents.h
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ButtonEvents.h"
+
+#if BUTTON_EVENTS == ON
+
+static_assert((BTN_QUEUE_SIZE & (BTN_QUEUE_SIZE - 1u)) == 0u, "Queue indices wrap with a mask");
+static_assert(BUTTON_DEBOUNCE_MS < 0x8000u, "Times are 16 bit");
+
+static uint8_t           btnPins[BTN_MAX_BUTTONS];
+static uint8_t           btnNPins;
+
+static BtnEvent_t        btnQueue[BTN_QUEUE_SIZE];
+static volatile uint8_t  btnHead;                       // Producer only
+static volatile uint8_t  btnTail;                       // Consumer only
+static volatile uint8_t  btnDropped;
+
+// Producer state. Bit i is button i
+static volatile uint8_t  btnPressed;                    // Debounced
+static volatile uint8_t  btnPending;                    // Changed while locked, to be resampled
+static uint16_t          btnEdgeTime[BTN_MAX_BUTTONS];  // Last debounced transition
+static uint16_t          btnRawTime[BTN_MAX_BUTTONS];   // Last edge seen while locked, when a pending change settled
+
+
+/** Internal functions **/
+static uint8_t u8_Btn_readPins();
+// Producer. Runs in the interrupt, or with interrupts disabled
+static void    v_Btn_sample(uint16_t now);
+static void    v_Btn_push(uint8_t button, uint8_t type, uint16_t time);
+
+
+#if defined(__AVR__)
+ISR(PCINT2_vect)
+{
+    v_Btn_sample((uint16_t)millis());
+}
+#endif
+
+
+void v_Btn_init(const uint8_t* pPins, uint8_t nPins)
+{
+    uint16_t now = (uint16_t)millis();
+    uint8_t  i;
+
+    noInterrupts();
+    btnNPins = min(nPins, BTN_MAX_BUTTONS);
+    for(i = 0; i < btnNPins; i++)
+    {
+        btnPins[i]     = pPins[i];
+        btnEdgeTime[i] = now - BUTTON_DEBOUNCE_MS; // Not locked
+    }
+    btnHead    = 0;
+    btnTail    = 0;
+    btnDropped = 0;
+    btnPressed = u8_Btn_readPins();
+    btnPending = 0;
+#if defined(__AVR__)
+    for(i = 0; i < btnNPins; i++)
+    {
+        PCMSK2 |= (uint8_t)(1u << btnPins[i]); // Port D pin n is PCINT(16 + n)
+    }
+    PCIFR  = (1 << PCIF2);
+    PCICR |= (1 << PCIE2);
+#endif
+    interrupts();
+}
+
+bool b_Btn_takeEvent(BtnEvent_t* pEvent)
+{
+#if defined(__AVR__)
+    // The end of a lock comes with no pin change, it is checked here. Nothing to do while no change is pending
+    if(btnPending != 0u)
+#endif
+    {
+        noInterrupts();
+        v_Btn_sample((uint16_t)millis());
+        interrupts();
+    }
+
+    uint8_t tail = btnTail;
+    if(tail == btnHead)
+    {
+        return false;
+    }
+    *pEvent = btnQueue[tail];
+    btnTail = (tail + 1u) & (BTN_QUEUE_SIZE - 1u);
+    return true;
+}
+
+uint8_t u8_Btn_getPressed()
+{
+    return btnPressed;
+}
+
+uint8_t u8_Btn_getDroppedEvents()
+{
+    return btnDropped;
+}
+
+
+static uint8_t u8_Btn_readPins()
+{
+    uint8_t pressed = 0;
+    uint8_t i;
+#if defined(__AVR__)
+    uint8_t port = PIND; // One read, every button sampled at the same time
+    for(i = 0; i < btnNPins; i++)
+    {
+        if(!(port & (1u << btnPins[i])))
+        {
+            pressed |= (uint8_t)(1u << i);
+        }
+    }
+#else
+    for(i = 0; i < btnNPins; i++)
+    {
+        if(!digitalRead(btnPins[i]))
+        {
+            pressed |= (uint8_t)(1u << i);
+        }
+    }
+#endif
+    return pressed;
+}
+
+static void v_Btn_sample(uint16_t now)
+{
+    uint8_t pressed = u8_Btn_readPins();
+    uint8_t changed = pressed ^ btnPressed;
+    uint8_t settled = btnPending;
+    uint8_t pending = 0;
+    uint8_t i;
+
+    for(i = 0; i < btnNPins; i++)
+    {
+        uint8_t mask = (uint8_t)(1u << i);
+        if(changed & mask)
+        {
+            if((uint16_t)(now - btnEdgeTime[i]) < BUTTON_DEBOUNCE_MS)
+            {
+                pending      |= mask; // Bouncing
+                btnRawTime[i] = now;
+                continue;
+            }
+            // A change resampled after the lock happened at its last edge, not now
+            uint16_t time  = (settled & mask) ? btnRawTime[i] : now;
+            btnEdgeTime[i] = time;
+            btnPressed    ^= mask;
+            v_Btn_push(i, (pressed & mask) ? BTN_EVENT_PRESS : BTN_EVENT_RELEASE, time);
+        }
+    }
+    btnPending = pending;
+}
+
+static void v_Btn_push(uint8_t button, uint8_t type, uint16_t time)
+{
+    uint8_t head = btnHead;
+    uint8_t next = (head + 1u) & (BTN_QUEUE_SIZE - 1u);
+    if(next == btnTail)
+    {
+        if(btnDropped < 0xFFu)
+        {
+            btnDropped++;
+        }
+        return;
+    }
+    btnQueue[head].u8_Button = button;
+    btnQueue[head].u8_Type   = type;
+    btnQueue[head].u16_Time  = time;
+    btnHead = next; // Published once written
+}
+
+#endif
@@ -0,0 +1,57 @@
+/**
+ * @file ButtonEvents.h
+ * @author Marcelo Fraga
+ * @brief Interrupt driven button input. A pin change interrupt samples the buttons on every transition, debounces them
+ * and queues press and release events, timestamped in millis(). Nothing is polled: a press is queued when it happens,
+ * even while the loop is busy elsewhere, and read whenever the Ui gets to it. Gestures (hold, auto repeat, double
+ * click) are left to UiM, which gets the time of each press and release.
+ *
+ *  - Debouncing: a transition is taken at its first edge, then the button is locked for BUTTON_DEBOUNCE_MS and its
+ *    bounces are ignored. A button left in another state when the lock ends (e.g. a spike shorter than the lock) is
+ *    resampled by the next b_Btn_takeEvent.
+ *
+ * Events go through a lock-free single producer / single consumer ring: the interrupt (or b_Btn_takeEvent, with
+ * interrupts disabled) produces, b_Btn_takeEvent consumes. Buttons are active low, on port D (PCINT2).
+ * The host build has no pin change interrupt: every b_Btn_takeEvent samples the pins.
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef BUTTONEVENTS_H
+#define BUTTONEVENTS_H
+#include "Configuration.h"
+
+#define BTN_MAX_BUTTONS 8u
+#define BTN_QUEUE_SIZE  16u // Events. Power of 2
+
+enum BtnEventType
+{
+    BTN_EVENT_PRESS,
+    BTN_EVENT_RELEASE
+};
+
+typedef struct BtnEvent_t
+{
+    uint8_t  u8_Button;     // Index in the pins given to v_Btn_init
+    uint8_t  u8_Type;       // BtnEventType
+    uint16_t u16_Time;      // millis() of the event, low 16 bits
+}BtnEvent_t;
+
+
+/// @brief Starts watching <nPins> button pins (port D, set up as INPUT_PULLUP). Buttons already pressed are not
+///        reported until they are released.
+void    v_Btn_init(const uint8_t* pPins, uint8_t nPins);
+
+/// @brief Gives the oldest queued event in <pEvent>. Returns false, and leaves <pEvent> alone, if there is none.
+bool    b_Btn_takeEvent(BtnEvent_t* pEvent);
+
+/// @brief Debounced state of the buttons, bit i set while button i is pressed.
+uint8_t u8_Btn_getPressed();
+
+/// @brief Events dropped because the queue was full, saturated at 255.
+uint8_t u8_Btn_getDroppedEvents();
+
+#endif
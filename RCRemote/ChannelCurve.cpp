@@ -0,0 +1,232 @@
+/**
+ * @file ChannelCurve.cpp
+ * @author Marcelo Fraga
+ * @brief Per channel expo/rate curve tables. See ChannelCurve.h
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ChannelCurve.h"
+
+#define CURVE_LUT_FRACTION_BITS (15u - CURVE_LUT_SEGMENT_BITS) // Bits of a Q15 magnitude that fall inside one segment
+#define CURVE_LUT_NO_RAM_TABLE  0xFFu
+
+// Curve state of each channel. Expo and rate are the values the current curve was set up for.
+typedef struct CurveState_t
+{
+    uint8_t  u8_Expo;
+    uint8_t  u8_Rate;
+    uint8_t  u8_RamTableIdx; // Index in ramTables, CURVE_LUT_NO_RAM_TABLE if the channel has no RAM table
+    bool     b_Default;      // Default curve, read from the table in flash
+    uint16_t u16_ExpoQ15;    // Non default curve without a RAM table: evaluated for each sample with these
+    uint16_t u16_RateQ15;
+}CurveState_t;
+
+
+/** Curve point generation. Integer only and constexpr, so the exact same math builds the flash table at compile time and the RAM tables at runtime **/
+
+static constexpr uint32_t u32_percentToQ15(uint8_t percent)
+{
+    return ((uint32_t)percent * Q15_ONE + 50u) / 100u;
+}
+
+static constexpr uint32_t u32_lutPointToQ15(uint8_t pointIdx)
+{
+    return (uint32_t)pointIdx << CURVE_LUT_FRACTION_BITS;
+}
+
+// n * n * (E + n * (1 - E)) * Rate, n = pointIdx / CURVE_LUT_SEGMENTS. Same curve as the float chain, for n >= 0.
+static constexpr uint16_t u16_curvePointQ15(uint8_t pointIdx, uint8_t expo, uint8_t rate)
+{
+    return (uint16_t)(((((((u32_lutPointToQ15(pointIdx) * u32_lutPointToQ15(pointIdx)) >> 15) *
+                          (u32_percentToQ15(expo) + ((u32_lutPointToQ15(pointIdx) * (Q15_ONE - u32_percentToQ15(expo))) >> 15))) >> 15) * rate) + 50u) / 100u);
+}
+
+// Minimal index sequence (no STL on AVR), used to expand u16_curvePointQ15 over every table point
+template<uint8_t... Indices> struct CurveLutIndices {};
+template<uint8_t N, uint8_t... Indices> struct CurveLutIndexBuilder : CurveLutIndexBuilder<N - 1, N - 1, Indices...> {};
+template<uint8_t... Indices> struct CurveLutIndexBuilder<0, Indices...> { typedef CurveLutIndices<Indices...> type; };
+
+template<uint8_t... Indices>
+static constexpr CurveLut_t t_buildCurveLut(uint8_t expo, uint8_t rate, CurveLutIndices<Indices...>)
+{
+    return CurveLut_t{{u16_curvePointQ15(Indices, expo, rate)...}};
+}
+
+static constexpr CurveLut_t defaultCurveLut PROGMEM = t_buildCurveLut(DEFAULT_EXPO_PERCENT, DEFAULT_RATE_PERCENT, CurveLutIndexBuilder<CURVE_LUT_POINTS>::type());
+
+static_assert(defaultCurveLut.u16_Points[0] == 0u, "Curve must go through the center");
+static_assert(defaultCurveLut.u16_Points[CURVE_LUT_SEGMENTS] == u32_percentToQ15(DEFAULT_RATE_PERCENT), "Curve endpoint must match the rate");
+
+
+#if CURVE_LUT_RAM_TABLES > 0
+static CurveLut_t   ramTables[CURVE_LUT_RAM_TABLES];
+static bool         ramTableInUse[CURVE_LUT_RAM_TABLES];
+#endif
+static CurveState_t curveStates[N_CHANNELS];
+
+
+/** Internal functions **/
+static bool     b_Crv_isDefault(uint8_t expo, uint8_t rate);
+#if CURVE_LUT_RAM_TABLES > 0
+static uint8_t  u8_Crv_acquireRamTable(CurveState_t* pState);
+static void     v_Crv_releaseRamTable(CurveState_t* pState);
+static void     v_Crv_buildRamTable(CurveLut_t* pLut, uint8_t expo, uint8_t rate);
+#endif
+// Same curve as u16_curvePointQ15 at any <magnitude> (UQ1.15), from the coefficients of <pState>: 4 multiplies, no division
+static uint16_t u16_Crv_evaluate(const CurveState_t* pState, uint16_t magnitude);
+static void     v_Crv_updateChannel(CurveState_t* pState, uint8_t expo, uint8_t rate);
+
+
+void v_Crv_init(const RemoteChannelInput_t* pChannels)
+{
+    uint8_t i;
+#if CURVE_LUT_RAM_TABLES > 0
+    for(i = 0; i < CURVE_LUT_RAM_TABLES; i++)
+    {
+        ramTableInUse[i] = false;
+    }
+#endif
+
+    for(i = 0; i < N_CHANNELS; i++)
+    {
+        curveStates[i].u8_Expo        = DEFAULT_EXPO_PERCENT;
+        curveStates[i].u8_Rate        = DEFAULT_RATE_PERCENT;
+        curveStates[i].u8_RamTableIdx = CURVE_LUT_NO_RAM_TABLE;
+        curveStates[i].b_Default      = true;
+    }
+    v_Crv_sync(pChannels);
+}
+
+void v_Crv_sync(const RemoteChannelInput_t* pChannels)
+{
+    uint8_t i;
+    for(i = 0; i < N_CHANNELS; i++)
+    {
+        if((pChannels[i].u8_Expo != curveStates[i].u8_Expo) || (pChannels[i].u8_Rate != curveStates[i].u8_Rate))
+        {
+            v_Crv_updateChannel(&curveStates[i], pChannels[i].u8_Expo, pChannels[i].u8_Rate);
+        }
+    }
+}
+
+uint16_t u16_Crv_apply(uint8_t channelIdx, uint16_t rawValue)
+{
+    const CurveState_t* pState  = &curveStates[channelIdx];
+    int32_t  normalizedValue    = ((int32_t)rawValue - ANALOG_HALF_VALUE) << 6; // ANALOG_HALF_VALUE is 2^9, Q15 is a plain shift
+    uint16_t magnitude          = (uint16_t)((normalizedValue < 0) ? -normalizedValue : normalizedValue);
+    uint8_t  segment            = magnitude >> CURVE_LUT_FRACTION_BITS;
+    uint16_t fraction           = magnitude & ((1u << CURVE_LUT_FRACTION_BITS) - 1u);
+    uint16_t p0;
+    uint16_t p1;
+    int32_t  curveValue;
+
+    if(segment >= CURVE_LUT_SEGMENTS) // Only the full negative deflection (-1.0) lands exactly on the last point
+    {
+        segment  = CURVE_LUT_SEGMENTS - 1u;
+        fraction = (1u << CURVE_LUT_FRACTION_BITS);
+    }
+
+    if(pState->b_Default)
+    {
+        p0 = pgm_read_word(&defaultCurveLut.u16_Points[segment]);
+        p1 = pgm_read_word(&defaultCurveLut.u16_Points[segment + 1u]);
+    }
+#if CURVE_LUT_RAM_TABLES > 0
+    else if(pState->u8_RamTableIdx != CURVE_LUT_NO_RAM_TABLE)
+    {
+        p0 = ramTables[pState->u8_RamTableIdx].u16_Points[segment];
+        p1 = ramTables[pState->u8_RamTableIdx].u16_Points[segment + 1u];
+    }
+#endif
+    else
+    {
+        p0 = u16_Crv_evaluate(pState, magnitude); // Exact curve, nothing to interpolate
+        p1 = p0;
+    }
+
+    // Curve is monotonic, so p1 >= p0 and the lerp stays unsigned
+    curveValue = p0 + (int32_t)(((uint32_t)(p1 - p0) * fraction) >> CURVE_LUT_FRACTION_BITS);
+    curveValue = (normalizedValue < 0) ? -curveValue : curveValue;
+    curveValue = (curveValue + Q15_ONE) >> 6;
+    return (curveValue > ANALOG_MAX_VALUE) ? ANALOG_MAX_VALUE : (uint16_t)curveValue;
+}
+
+
+static bool b_Crv_isDefault(uint8_t expo, uint8_t rate)
+{
+    return (expo == DEFAULT_EXPO_PERCENT) && (rate == DEFAULT_RATE_PERCENT);
+}
+
+#if CURVE_LUT_RAM_TABLES > 0
+static uint8_t u8_Crv_acquireRamTable(CurveState_t* pState)
+{
+    uint8_t i;
+    if(pState->u8_RamTableIdx != CURVE_LUT_NO_RAM_TABLE) // Channel already owns a table, rebuild it in place
+    {
+        return pState->u8_RamTableIdx;
+    }
+
+    for(i = 0; i < CURVE_LUT_RAM_TABLES; i++)
+    {
+        if(!ramTableInUse[i])
+        {
+            ramTableInUse[i] = true;
+            return i;
+        }
+    }
+    return CURVE_LUT_NO_RAM_TABLE;
+}
+
+static void v_Crv_releaseRamTable(CurveState_t* pState)
+{
+    if(pState->u8_RamTableIdx != CURVE_LUT_NO_RAM_TABLE)
+    {
+        ramTableInUse[pState->u8_RamTableIdx] = false;
+        pState->u8_RamTableIdx = CURVE_LUT_NO_RAM_TABLE;
+    }
+}
+
+static void v_Crv_buildRamTable(CurveLut_t* pLut, uint8_t expo, uint8_t rate)
+{
+    uint8_t i;
+    for(i = 0; i < CURVE_LUT_POINTS; i++)
+    {
+        pLut->u16_Points[i] = u16_curvePointQ15(i, expo, rate);
+    }
+}
+#endif
+
+static uint16_t u16_Crv_evaluate(const CurveState_t* pState, uint16_t magnitude)
+{
+    uint32_t squared = ((uint32_t)magnitude * magnitude) >> 15;
+    uint32_t weight  = pState->u16_ExpoQ15 + (((uint32_t)magnitude * (Q15_ONE - pState->u16_ExpoQ15)) >> 15);
+    return (uint16_t)((((squared * weight) >> 15) * pState->u16_RateQ15) >> 15);
+}
+
+static void v_Crv_updateChannel(CurveState_t* pState, uint8_t expo, uint8_t rate)
+{
+    pState->b_Default = b_Crv_isDefault(expo, rate);
+#if CURVE_LUT_RAM_TABLES > 0
+    if(pState->b_Default)
+    {
+        v_Crv_releaseRamTable(pState);
+    }
+    else
+    {
+        // Without a free RAM table the curve is evaluated for each sample
+        pState->u8_RamTableIdx = u8_Crv_acquireRamTable(pState);
+        if(pState->u8_RamTableIdx != CURVE_LUT_NO_RAM_TABLE)
+        {
+            v_Crv_buildRamTable(&ramTables[pState->u8_RamTableIdx], min(expo, CURVE_MAX_PERCENT), min(rate, CURVE_MAX_PERCENT));
+        }
+    }
+#endif
+    pState->u16_ExpoQ15 = (uint16_t)u32_percentToQ15(min(expo, CURVE_MAX_PERCENT));
+    pState->u16_RateQ15 = (uint16_t)u32_percentToQ15(min(rate, CURVE_MAX_PERCENT));
+    pState->u8_Expo     = expo;
+    pState->u8_Rate     = rate;
+}
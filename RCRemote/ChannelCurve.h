@@ -0,0 +1,40 @@
+/**
+ * @file ChannelCurve.h
+ * @author Marcelo Fraga
+ * @brief Per channel expo/rate curves evaluated through interpolated lookup tables.
+ * The curve is odd (f(-n) = -f(n)), so a table only holds the positive half, from the center to the endpoint, in UQ1.15.
+ * The table for the default expo/rate is generated at compile time and lives in flash: evaluating a sample is a table
+ * lookup plus one linear interpolation. Channels whose settings differ from the default evaluate the curve for each
+ * sample instead (4 32 bit multiplies), from coefficients only computed when their settings change. CURVE_LUT_RAM_TABLES
+ * of them can get a table in RAM instead, at 2 * CURVE_LUT_POINTS bytes each.
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef CHANNELCURVE_H
+#define CHANNELCURVE_H
+#include "Configuration.h"
+
+#define CURVE_LUT_SEGMENTS (1u << CURVE_LUT_SEGMENT_BITS)
+#define CURVE_LUT_POINTS   (CURVE_LUT_SEGMENTS + 1u)
+
+typedef struct CurveLut_t
+{
+    uint16_t u16_Points[CURVE_LUT_POINTS]; // f(i / CURVE_LUT_SEGMENTS) in UQ1.15, i = 0..CURVE_LUT_SEGMENTS
+}CurveLut_t;
+
+
+/// @brief Builds the curve table of every channel from its current expo and rate. Must be called once at startup.
+void     v_Crv_init(const RemoteChannelInput_t* pChannels);
+
+/// @brief Rebuilds the tables of the channels whose expo or rate changed since the last call. Cheap when nothing changed,
+///        meant to be called whenever the configuration was updated.
+void     v_Crv_sync(const RemoteChannelInput_t* pChannels);
+
+/// @brief Applies the curve of channel <channelIdx> to a raw (ANALOG_MIN_VALUE - ANALOG_MAX_VALUE) value.
+uint16_t u16_Crv_apply(uint8_t channelIdx, uint16_t rawValue);
+
+#endif
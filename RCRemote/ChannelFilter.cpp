@@ -0,0 +1,132 @@
+/**
+ * @file ChannelFilter.cpp
+ * @author Marcelo Fraga
+ * @brief Input filter chain of the analog channels. See ChannelFilter.h
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ChannelFilter.h"
+
+#define FLT_ALPHA_ONE          (1ul << FLT_ALPHA_SHIFT)
+// 1-Euro alpha (Q12) = 2*pi*fc/SAMPLE_RATE_HZ, split in its two terms:
+//   min cutoff (0.1Hz):          alpha = min cutoff * FLT_EURO_CUTOFF_GAIN >> 8
+//   beta (0.001Hz per LSB/s) and speed (state units per sample, so LSB/s * 2^FLT_STATE_SHIFT / SAMPLE_RATE_HZ):
+//                                alpha = beta * speed * FLT_EURO_SPEED_GAIN >> 12, the sample rate cancels out
+#define FLT_EURO_CUTOFF_GAIN   ((uint16_t)((2.0 * PI * FLT_ALPHA_ONE * 256.0) / (10.0 * SAMPLE_RATE_HZ) + 0.5))
+#define FLT_EURO_SPEED_GAIN    ((uint16_t)((2.0 * PI * FLT_ALPHA_ONE * 4096.0) / (1000.0 * (1ul << FLT_STATE_SHIFT)) + 0.5))
+#define FLT_EURO_MAX_SPEED     0xFFFFu // Speed estimates are saturated here, the alpha is already 1 well before
+
+static_assert(N_ANALOG_CHANNELS <= 8u, "Primed channels are a 8 bit mask");
+static_assert(((uint32_t)ANALOG_MAX_VALUE << FLT_STATE_SHIFT) * FLT_ALPHA_ONE < 0x80000000ul, "Smoothing products must fit in 32 bits");
+static_assert((unsigned long long)FLT_EURO_MAX_SPEED * 255u * FLT_EURO_SPEED_GAIN <= 0xFFFFFFFFull, "Speed term must fit in 32 bits");
+
+static const FltConfig_t* fltConfigs;
+static uint16_t fltHistory[N_ANALOG_CHANNELS][FLT_MEDIAN_MAX_SAMPLES];  // Last samples, for the median
+static uint8_t  fltHistoryNext[N_ANALOG_CHANNELS];
+static int32_t  fltSmoothed[N_ANALOG_CHANNELS];    // FLT_STATE_SHIFT fraction bits
+static int32_t  fltSpeed[N_ANALOG_CHANNELS];       // 1-Euro, filtered change per sample. FLT_STATE_SHIFT fraction bits
+static uint8_t  fltPrimedMask;                     // Bit c set: channel c has its state filled
+
+
+/** Internal functions **/
+static uint16_t u16_Flt_median(uint8_t channel, uint16_t sample, uint8_t nSamples);
+static int32_t  i32_Flt_lowPass(int32_t state, int32_t target, uint16_t alpha);
+static uint16_t u16_Flt_euroAlpha(uint8_t minCutoff, uint8_t beta, int32_t speed);
+
+
+void v_Flt_init(const FltConfig_t* pConfigs)
+{
+    fltConfigs    = pConfigs;
+    fltPrimedMask = 0u;
+}
+
+void v_Flt_reset(uint8_t channel)
+{
+    fltPrimedMask &= (uint8_t)~(1u << channel);
+}
+
+uint16_t u16_Flt_apply(uint8_t channel, uint16_t sample)
+{
+    const FltConfig_t* pConfig = &fltConfigs[channel];
+    uint8_t            i;
+
+    if(!(fltPrimedMask & (1u << channel)))
+    {
+        for(i = 0; i < FLT_MEDIAN_MAX_SAMPLES; i++)
+        {
+            fltHistory[channel][i] = sample;
+        }
+        fltSmoothed[channel] = (int32_t)sample << FLT_STATE_SHIFT;
+        fltSpeed[channel]    = 0;
+        fltPrimedMask       |= (uint8_t)(1u << channel);
+        return sample;
+    }
+
+    if(pConfig->u8_Median > FLT_MEDIAN_NONE)
+    {
+        sample = u16_Flt_median(channel, sample, pConfig->u8_Median);
+    }
+
+    int32_t target = (int32_t)sample << FLT_STATE_SHIFT;
+    switch(pConfig->u8_Smoothing)
+    {
+        case FLT_SMOOTHING_EMA:
+            fltSmoothed[channel] = i32_Flt_lowPass(fltSmoothed[channel], target, (uint16_t)pConfig->u8_EmaAlpha << (FLT_ALPHA_SHIFT - 8u));
+            break;
+        case FLT_SMOOTHING_ONE_EURO:
+            // Speed is the change from the last output, low passed at a fixed cutoff. It then sets the cutoff of the output
+            fltSpeed[channel]    = i32_Flt_lowPass(fltSpeed[channel], target - fltSmoothed[channel],
+                                                   ((uint16_t)FLT_EURO_DERIVATIVE_CUTOFF_X10 * FLT_EURO_CUTOFF_GAIN) >> 8);
+            fltSmoothed[channel] = i32_Flt_lowPass(fltSmoothed[channel], target,
+                                                   u16_Flt_euroAlpha(pConfig->u8_MinCutoff, pConfig->u8_Beta, fltSpeed[channel]));
+            break;
+        default:
+            return sample;
+    }
+    return (uint16_t)((fltSmoothed[channel] + (1l << (FLT_STATE_SHIFT - 1u))) >> FLT_STATE_SHIFT);
+}
+
+
+// Median of the last <nSamples> samples, <sample> included. Insertion sort, the window is at most 5 samples
+static uint16_t u16_Flt_median(uint8_t channel, uint16_t sample, uint8_t nSamples)
+{
+    uint16_t window[FLT_MEDIAN_MAX_SAMPLES];
+    uint8_t  index = fltHistoryNext[channel];
+    uint8_t  i;
+
+    fltHistory[channel][index] = sample;
+    fltHistoryNext[channel]    = (index + 1u) % FLT_MEDIAN_MAX_SAMPLES;
+
+    for(i = 0; i < nSamples; i++)
+    {
+        uint16_t value = fltHistory[channel][index];
+        uint8_t  j     = i;
+        while((j > 0u) && (window[j - 1u] > value))
+        {
+            window[j] = window[j - 1u];
+            j--;
+        }
+        window[j] = value;
+        index     = (index == 0u) ? (FLT_MEDIAN_MAX_SAMPLES - 1u) : (index - 1u);
+    }
+    return window[nSamples / 2u];
+}
+
+// state + alpha * (target - state), rounded. Alpha is Q12
+static int32_t i32_Flt_lowPass(int32_t state, int32_t target, uint16_t alpha)
+{
+    return state + (((target - state) * (int32_t)alpha + (int32_t)(FLT_ALPHA_ONE / 2u)) >> FLT_ALPHA_SHIFT);
+}
+
+static uint16_t u16_Flt_euroAlpha(uint8_t minCutoff, uint8_t beta, int32_t speed)
+{
+    uint32_t absSpeed = (speed < 0) ? (uint32_t)(-speed) : (uint32_t)speed;
+    uint32_t alpha    = ((uint32_t)minCutoff * FLT_EURO_CUTOFF_GAIN) >> 8;
+    absSpeed          = min(absSpeed, (uint32_t)FLT_EURO_MAX_SPEED);
+    alpha            += (absSpeed * beta * FLT_EURO_SPEED_GAIN) >> FLT_ALPHA_SHIFT;
+    return (uint16_t)min(alpha, (uint32_t)FLT_ALPHA_ONE);
+}
@@ -0,0 +1,77 @@
+/**
+ * @file ChannelFilter.h
+ * @author Marcelo Fraga
+ * @brief Input filter chain of the analog channels, applied to each new sample before any processing. Every channel has
+ * its own chain of up to two stages, in this order:
+ *
+ *  - Median of the last 3 or 5 samples (optional). Rejects single sample spikes, at the cost of 1 or 2 samples of lag.
+ *  - Smoothing (optional):
+ *      EMA:    out += alpha * (in - out). Constant smoothing, constant lag.
+ *      1-Euro: EMA whose cutoff follows the speed of the input, fc = min cutoff + beta * |speed|. Heavily smoothed at
+ *              rest, where jitter shows, and almost no lag on fast moves, where it doesn't.
+ *
+ * Everything runs in fixed point. The state keeps FLT_STATE_SHIFT fraction bits so slow cutoffs still converge. The
+ * 1-Euro alpha is 2*pi*fc*Te instead of 1 / (1 + 1 / (2*pi*fc*Te)): within 10% up to fc = SAMPLE_RATE_HZ / 60, no
+ * division, and smoothing simply stops a bit sooner on fast moves. Te is one sample at SAMPLE_RATE_HZ, the rate the
+ * filters are tuned for.
+ * The filtered value is also the raw value, the scroll wheels get the filter of their channel.
+ * host/filter_bench.cpp measures the lag and the noise of each filter over synthetic or recorded traces.
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef CHANNELFILTER_H
+#define CHANNELFILTER_H
+#include "Configuration.h"
+
+#define FLT_MEDIAN_MAX_SAMPLES 5u
+#define FLT_STATE_SHIFT        9u  // Fraction bits of the smoothing state. Largest for which (difference * alpha) fits in 32 bits
+#define FLT_ALPHA_SHIFT        12u // Smoothing alphas are Q12
+// 1-Euro speed estimate, low passed at 5Hz. At the usual 1Hz, the direction changes of a stick moved fast average out
+// and the output lags behind them
+#define FLT_EURO_DERIVATIVE_CUTOFF_X10 50u
+
+// Parameter conversions, for the filter table
+#define FLT_EMA_ALPHA_Q8(alpha)  ((uint8_t)((alpha) * 256.0f + 0.5f))   // alpha < 1
+#define FLT_MIN_CUTOFF_X10(hz)   ((uint8_t)((hz) * 10.0f + 0.5f))       // 0.1 - 25.5Hz
+#define FLT_BETA_MILLI(beta)     ((uint8_t)((beta) * 1000.0f + 0.5f))   // 0.001 - 0.255 Hz per LSB/s
+
+enum FltMedian
+{
+    FLT_MEDIAN_NONE = 1,    // Values are the window size
+    FLT_MEDIAN_3    = 3,
+    FLT_MEDIAN_5    = 5
+};
+
+enum FltSmoothing
+{
+    FLT_SMOOTHING_NONE,
+    FLT_SMOOTHING_EMA,
+    FLT_SMOOTHING_ONE_EURO
+};
+
+typedef struct FltConfig_t
+{
+    uint8_t u8_Median;          // FltMedian
+    uint8_t u8_Smoothing;       // FltSmoothing
+    uint8_t u8_EmaAlpha;        // EMA: weight of the new sample, Q8 (FLT_EMA_ALPHA_Q8)
+    uint8_t u8_MinCutoff;       // 1-Euro: cutoff at rest, in 0.1Hz (FLT_MIN_CUTOFF_X10)
+    uint8_t u8_Beta;            // 1-Euro: cutoff increase with speed, in 0.001Hz per LSB/s (FLT_BETA_MILLI)
+}FltConfig_t;
+
+
+/// @brief Uses the N_ANALOG_CHANNELS filter configurations of <pConfigs>, kept by pointer. Every filter restarts from
+///        its next sample.
+void     v_Flt_init(const FltConfig_t* pConfigs);
+
+/// @brief Restarts the filter of <channel> from its next sample. Needed after its configuration changed.
+void     v_Flt_reset(uint8_t channel);
+
+/// @brief Filters a new <sample> (ANALOG_MIN_VALUE - ANALOG_MAX_VALUE) of analog channel <channel>.
+///        The first sample after a reset goes through unchanged and fills the filter state.
+uint16_t u16_Flt_apply(uint8_t channel, uint16_t sample);
+
+#endif
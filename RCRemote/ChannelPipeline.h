@@ -0,0 +1,139 @@
+/**
+ * @file ChannelPipeline.h
+ * @author Marcelo Fraga
+ * @brief Read and process routine of every channel, generated at compile time from the channel layout. The layout is a
+ * list of channel kinds in RemoteInputs order, e.g.
+ *
+ *      typedef PipPipeline<PipAnalogCurve, PipAnalogCurve, PipAnalogLinear, PipDigital> ChannelPipeline_t;
+ *
+ * ChannelPipeline_t::read() is then fully unrolled: each analog channel is filtered, curved only if its kind says so,
+ * inverted, trimmed and clamped to its endpoints inline, each digital channel is read and inverted. There is no loop,
+ * no analog/digital or exp control test and no call per stage. Invert, trim and clamp are branch free.
+ * The kind of each channel (analog or digital, exp control) is wiring and comes from the layout. Invert, trim, endpoints
+ * and expo/rate are still read from RemoteInputs on every sample, so they stay tunable at runtime.
+ * It implements the fixed point chain (v_processAnalogChannelFixed) and gives the same results.
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef CHANNELPIPELINE_H
+#define CHANNELPIPELINE_H
+#include "Configuration.h"
+#include "ChannelFilter.h"
+#include "ChannelCurve.h"
+#include "AdcSampler.h"
+
+#if (CHANNEL_PIPELINE == ON) && (FIXED_POINT_PROCESSING == OFF)
+#error "The channel pipeline implements the fixed point processing chain only"
+#endif
+
+static_assert(ANALOG_MIN_VALUE == 0, "Invert is an XOR with ANALOG_MAX_VALUE");
+static_assert((ANALOG_MAX_VALUE & (ANALOG_MAX_VALUE + 1)) == 0, "Invert is an XOR with ANALOG_MAX_VALUE");
+
+#define PIP_INLINE inline __attribute__((always_inline))
+
+// Channel kinds
+template<bool Curve> struct PipAnalog { static const bool b_Analog = true;  static const bool b_Curve = Curve; };
+struct PipDigital                     { static const bool b_Analog = false; static const bool b_Curve = false; };
+typedef PipAnalog<true>  PipAnalogCurve;    // Expo/rate curve applied (b_expControl)
+typedef PipAnalog<false> PipAnalogLinear;
+
+
+// ANALOG_MAX_VALUE - value when inverted, without a branch
+static PIP_INLINE uint16_t u16_Pip_invert(uint16_t value, bool invert)
+{
+    return value ^ ((uint16_t)(-(int16_t)invert) & ANALOG_MAX_VALUE);
+}
+
+// One channel, specialized on its kind
+template<uint8_t Index, typename Kind, bool Analog = Kind::b_Analog> struct PipChannel;
+
+template<uint8_t Index, typename Kind> struct PipChannel<Index, Kind, true>
+{
+    static PIP_INLINE void v_read(RemoteChannelInput_t* pChannel, const uint16_t* pAdcResults)
+    {
+#if ADC_SAMPLER == ON
+        uint16_t value = u16_Flt_apply(Index, u16_Adc_toAnalog(pAdcResults[Index]));
+#else
+        (void)pAdcResults;
+        uint16_t value = u16_Flt_apply(Index, (uint16_t)analogRead(pChannel->u8_Pin));
+#endif
+        pChannel->u16_RawValue = value;
+        if(Kind::b_Curve)
+        {
+            value = u16_Crv_apply(Index, value);
+        }
+        // Same as floor at 0 then clamp to the endpoints: the endpoints are never negative
+        int16_t trimmed = (int16_t)u16_Pip_invert(value, pChannel->b_InvertInput) + ((int16_t)pChannel->u16_Trim - ANALOG_HALF_VALUE);
+        trimmed         = (trimmed > (int16_t)pChannel->u16_MaxValue) ? (int16_t)pChannel->u16_MaxValue : trimmed;
+        trimmed         = (trimmed < (int16_t)pChannel->u16_MinValue) ? (int16_t)pChannel->u16_MinValue : trimmed;
+        pChannel->u16_Value = (uint16_t)trimmed;
+    }
+};
+
+template<uint8_t Index, typename Kind> struct PipChannel<Index, Kind, false>
+{
+    static PIP_INLINE void v_read(RemoteChannelInput_t* pChannel, const uint16_t* /* pAdcResults */)
+    {
+        uint16_t value = digitalRead(pChannel->u8_Pin) ? ANALOG_MAX_VALUE : ANALOG_MIN_VALUE;
+        pChannel->u16_Value = u16_Pip_invert(value, pChannel->b_InvertInput);
+    }
+};
+
+// Unrolls the layout, channel <Index> onwards
+template<uint8_t Index, typename... Kinds> struct PipChannels
+{
+    static PIP_INLINE void v_read(RemoteChannelInput_t* /* pChannels */, const uint16_t* /* pAdcResults */) {}
+    static bool b_matches(const RemoteChannelInput_t* /* pChannels */) { return true; }
+    static constexpr uint8_t u8_analogCount() { return 0u; }
+    static constexpr bool    b_analogFirst(bool /* digitalSeen */) { return true; }
+};
+
+template<uint8_t Index, typename Kind, typename... Rest> struct PipChannels<Index, Kind, Rest...>
+{
+    static PIP_INLINE void v_read(RemoteChannelInput_t* pChannels, const uint16_t* pAdcResults)
+    {
+        PipChannel<Index, Kind>::v_read(&pChannels[Index], pAdcResults);
+        PipChannels<Index + 1u, Rest...>::v_read(pChannels, pAdcResults);
+    }
+    static bool b_matches(const RemoteChannelInput_t* pChannels)
+    {
+        return (pChannels[Index].b_Analog == Kind::b_Analog) && (!Kind::b_Analog || (pChannels[Index].b_expControl == Kind::b_Curve)) &&
+               PipChannels<Index + 1u, Rest...>::b_matches(pChannels);
+    }
+    static constexpr uint8_t u8_analogCount() { return (Kind::b_Analog ? 1u : 0u) + PipChannels<Index + 1u, Rest...>::u8_analogCount(); }
+    static constexpr bool    b_analogFirst(bool digitalSeen)
+    {
+        return !(digitalSeen && Kind::b_Analog) && PipChannels<Index + 1u, Rest...>::b_analogFirst(digitalSeen || !Kind::b_Analog);
+    }
+};
+
+template<typename... Kinds> struct PipPipeline
+{
+    static_assert(sizeof...(Kinds) == N_CHANNELS, "The layout must list every channel");
+    static_assert(PipChannels<0u, Kinds...>::u8_analogCount() == N_ANALOG_CHANNELS, "The layout must have N_ANALOG_CHANNELS analog channels");
+    static_assert(PipChannels<0u, Kinds...>::b_analogFirst(false), "Analog channels come first, they are sampled in that order");
+
+    /// @brief Reads and processes every channel of <pChannels>. Not inlined, the unrolled code exists once.
+    static void v_read(RemoteChannelInput_t* pChannels)
+    {
+#if ADC_SAMPLER == ON
+        uint16_t adcResults[N_ANALOG_CHANNELS];
+        u8_Adc_getResults(adcResults); // Never waits for a conversion
+#else
+        const uint16_t* adcResults = NULL;
+#endif
+        PipChannels<0u, Kinds...>::v_read(pChannels, adcResults);
+    }
+
+    /// @brief Whether the kinds of <pChannels> (analog, exp control) are the ones of the layout.
+    static bool b_matches(const RemoteChannelInput_t* pChannels)
+    {
+        return PipChannels<0u, Kinds...>::b_matches(pChannels);
+    }
+};
+
+#endif
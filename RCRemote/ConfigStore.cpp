@@ -0,0 +1,471 @@
+/**
+ * @file ConfigStore.cpp
+ * @author Marcelo Fraga
+ * @brief Persistence of the channel configuration in the EEPROM. See ConfigStore.h
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ConfigStore.h"
+#include <avr/eeprom.h>
+
+#define CFG_NO_SLOT              0xFFu
+#define CFG_FLAG_INVERT          0x01u
+#define CFG_FLAG_EXP_CONTROL     0x02u
+#define CFG_PAYLOAD_END          (CFG_HEADER_SIZE + CFG_PAYLOAD_SIZE)
+#define CFG_CRC_INIT             0xFFFFu
+
+// The payload is a sequence of blocks: every channel, then every mix rule, then every mix curve
+#define CFG_FIRST_RULE_BLOCK     N_CHANNELS
+#define CFG_FIRST_CURVE_BLOCK    (CFG_FIRST_RULE_BLOCK + MIX_MAX_RULES)
+#define CFG_N_BLOCKS             (CFG_FIRST_CURVE_BLOCK + MIX_N_CURVES)
+#define CFG_STAGING_SIZE         CFG_CHANNEL_RECORD_SIZE // Largest block
+
+static_assert(CFG_SLOT_COUNT < CFG_NO_SLOT, "Slot indexes are 8 bits");
+static_assert(CFG_SLOT_COUNT * CFG_SLOT_SIZE <= (E2END + 1u), "Slots must fit in the EEPROM");
+static_assert(CFG_RECORD_SIZE <= 255u, "Write offset is 8 bits");
+static_assert((CFG_RULE_RECORD_SIZE <= CFG_STAGING_SIZE) && (CFG_CURVE_RECORD_SIZE <= CFG_STAGING_SIZE), "Every block must fit in the staging buffer");
+static_assert(N_CHANNELS <= 16u, "Rule source and destination are stored as nibbles");
+
+static uint8_t       cfgNewestSlot[N_MODELS];         // Slot holding the newest record of each model, never overwritten
+static uint8_t       cfgNextSlot;                     // Where the round robin continues
+static uint16_t      cfgSequence;                     // Sequence number of the next record written
+static bool          cfgSavePending;
+static unsigned long cfgSaveRequestTime;
+static uint8_t       cfgActiveModel;
+static uint8_t       cfgRequestedModel;
+static bool          cfgActiveModelDirty;             // The active model changed, its EEPROM copy wasn't written yet
+
+// Write in progress. A block is copied to the staging buffer when its first byte is written, so a channel or a rule
+// changed in the middle of a save is stored either as it was or as it is, never half and half
+static bool          cfgWriting;
+static uint8_t       cfgWriteModel;
+static uint8_t       cfgWriteSlot;
+static uint8_t       cfgWriteOffset;
+static uint8_t       cfgWriteBlock;
+static uint8_t       cfgWriteBlockOffset;
+static uint8_t       cfgWriteBlockSize;
+static uint16_t      cfgWriteCrc;
+static uint8_t       cfgStaging[CFG_STAGING_SIZE];
+
+
+/** Internal functions **/
+static bool     b_Cfg_readRecordHeader(uint8_t slot, uint8_t* pRecordId, uint16_t* pSequence);
+static uint8_t  u8_Cfg_readActiveModel();
+static void     v_Cfg_readBlocks(uint8_t slot, const CfgModel_t* pModel, bool changedOnly);
+static uint8_t  u8_Cfg_serializeBlock(const CfgModel_t* pModel, uint8_t block, uint8_t* pBuffer);
+static void     v_Cfg_deserializeBlock(const uint8_t* pBuffer, uint8_t block, const CfgModel_t* pModel);
+static void     v_Cfg_serializeChannel(const RemoteChannelInput_t* pChannel, uint8_t* pBuffer);
+static void     v_Cfg_deserializeChannel(const uint8_t* pBuffer, RemoteChannelInput_t* pChannel);
+static bool     b_Cfg_isStored(uint8_t slot, const CfgModel_t* pModel);
+static bool     b_Cfg_startWrite(const CfgModel_t* pModel);
+static uint8_t  u8_Cfg_nextWriteByte(const CfgModel_t* pModel);
+static void     v_Cfg_finishWrite();
+static void     v_Cfg_writeActiveModel();
+static uint8_t* p_Cfg_address(uint8_t slot, uint8_t offset);
+static uint16_t u16_Cfg_crcUpdate(uint16_t crc, uint8_t data);
+static bool     b_Cfg_isNewer(uint16_t sequence, uint16_t reference);
+
+
+bool b_Cfg_load(const CfgModel_t* pModel)
+{
+    uint16_t newestSequence[N_MODELS];
+    uint16_t lastSequence = 0u;
+    bool     anyRecord    = false;
+    uint8_t  slot;
+    uint8_t  recordId;
+    uint16_t sequence;
+
+    memset(cfgNewestSlot, CFG_NO_SLOT, sizeof(cfgNewestSlot));
+    cfgNextSlot         = 0u;
+    cfgSavePending      = false;
+    cfgWriting          = false;
+    cfgActiveModel      = u8_Cfg_readActiveModel();
+    cfgRequestedModel   = cfgActiveModel;
+    cfgActiveModelDirty = false;
+
+    for(slot = 0; slot < CFG_SLOT_COUNT; slot++)
+    {
+        if(!b_Cfg_readRecordHeader(slot, &recordId, &sequence))
+        {
+            continue;
+        }
+        if((cfgNewestSlot[recordId] == CFG_NO_SLOT) || b_Cfg_isNewer(sequence, newestSequence[recordId]))
+        {
+            cfgNewestSlot[recordId]  = slot;
+            newestSequence[recordId] = sequence;
+        }
+        if(!anyRecord || b_Cfg_isNewer(sequence, lastSequence)) // The last record written, whatever its id
+        {
+            anyRecord    = true;
+            lastSequence = sequence;
+            cfgNextSlot  = (slot + 1u) % CFG_SLOT_COUNT;
+        }
+    }
+    cfgSequence = lastSequence + 1u;
+
+    if(cfgNewestSlot[cfgActiveModel] == CFG_NO_SLOT)
+    {
+        return false;
+    }
+    v_Cfg_readBlocks(cfgNewestSlot[cfgActiveModel], pModel, false);
+    return true;
+}
+
+void v_Cfg_requestSave()
+{
+    cfgSavePending     = true;
+    cfgSaveRequestTime = millis();
+}
+
+void v_Cfg_process(const CfgModel_t* pModel)
+{
+    if(!cfgWriting)
+    {
+        // A model switch waits for this save, it doesn't wait for the delay
+        bool saveDue = cfgSavePending && (((millis() - cfgSaveRequestTime) >= CFG_SAVE_DELAY_MS) || (cfgRequestedModel != cfgActiveModel));
+        if(!saveDue)
+        {
+            if(cfgActiveModelDirty && !cfgSavePending)
+            {
+                v_Cfg_writeActiveModel();
+            }
+            return;
+        }
+        cfgSavePending = false;
+        if(!b_Cfg_startWrite(pModel))
+        {
+            return;
+        }
+    }
+
+    // Bytes already holding the right value cost a read only. Stops at the first one actually written
+    while(cfgWriting && eeprom_is_ready())
+    {
+        uint8_t* pAddress = p_Cfg_address(cfgWriteSlot, cfgWriteOffset);
+        uint8_t  data     = u8_Cfg_nextWriteByte(pModel);
+        bool     written  = (eeprom_read_byte(pAddress) != data);
+
+        if(written)
+        {
+            eeprom_write_byte(pAddress, data); // Returns right away, the EEPROM then stays busy for ~3.3ms
+        }
+        if(++cfgWriteOffset >= CFG_RECORD_SIZE)
+        {
+            v_Cfg_finishWrite();
+        }
+        if(written)
+        {
+            return;
+        }
+    }
+}
+
+bool b_Cfg_isBusy()
+{
+    return cfgSavePending || cfgWriting;
+}
+
+void v_Cfg_selectModel(uint8_t model)
+{
+    if(model < N_MODELS)
+    {
+        cfgRequestedModel = model;
+    }
+}
+
+bool b_Cfg_applyModelSwitch(const CfgModel_t* pModel)
+{
+    // The EEPROM must be idle: reading waits for a write in progress
+    if((cfgRequestedModel == cfgActiveModel) || b_Cfg_isBusy() || !eeprom_is_ready())
+    {
+        return false;
+    }
+
+    cfgActiveModel      = cfgRequestedModel;
+    cfgActiveModelDirty = true;
+    if(cfgNewestSlot[cfgActiveModel] == CFG_NO_SLOT)
+    {
+        v_Cfg_requestSave(); // Never saved, it starts as a copy of the working set
+    }
+    else
+    {
+        v_Cfg_readBlocks(cfgNewestSlot[cfgActiveModel], pModel, true);
+    }
+    return true;
+}
+
+uint8_t u8_Cfg_getActiveModel()
+{
+    return cfgActiveModel;
+}
+
+
+// Checks the whole slot. Returns false if it doesn't hold a valid record of this format version
+static bool b_Cfg_readRecordHeader(uint8_t slot, uint8_t* pRecordId, uint16_t* pSequence)
+{
+    uint16_t crc = CFG_CRC_INIT;
+    uint8_t  header[CFG_HEADER_SIZE];
+    uint8_t  offset;
+
+    eeprom_read_block(header, p_Cfg_address(slot, 0u), CFG_HEADER_SIZE);
+    if((header[0] != CFG_FORMAT_VERSION) || (header[1] >= N_MODELS))
+    {
+        return false;
+    }
+    for(offset = 0; offset < CFG_PAYLOAD_END; offset++)
+    {
+        crc = u16_Cfg_crcUpdate(crc, eeprom_read_byte(p_Cfg_address(slot, offset)));
+    }
+    if((eeprom_read_byte(p_Cfg_address(slot, CFG_PAYLOAD_END))      != (uint8_t)crc) ||
+       (eeprom_read_byte(p_Cfg_address(slot, CFG_PAYLOAD_END + 1u)) != (uint8_t)(crc >> 8)))
+    {
+        return false;
+    }
+    *pRecordId = header[1];
+    *pSequence = (uint16_t)header[2] | ((uint16_t)header[3] << 8);
+    return true;
+}
+
+// Stored with its complement, anything else (erased EEPROM included) selects the first model
+static uint8_t u8_Cfg_readActiveModel()
+{
+    uint8_t model = eeprom_read_byte((const uint8_t*)CFG_ACTIVE_MODEL_ADDRESS);
+    if((model >= N_MODELS) || (eeprom_read_byte((const uint8_t*)(CFG_ACTIVE_MODEL_ADDRESS + 1u)) != (uint8_t)~model))
+    {
+        return 0u;
+    }
+    return model;
+}
+
+// With <changedOnly>, blocks whose stored fields already match the working set are left alone: their channel
+// processing isn't disturbed and the curve tables aren't rebuilt
+static void v_Cfg_readBlocks(uint8_t slot, const CfgModel_t* pModel, bool changedOnly)
+{
+    uint8_t current[CFG_STAGING_SIZE];
+    uint8_t offset = CFG_HEADER_SIZE;
+    uint8_t block;
+    for(block = 0; block < CFG_N_BLOCKS; block++)
+    {
+        uint8_t size = u8_Cfg_serializeBlock(pModel, block, current);
+        eeprom_read_block(cfgStaging, p_Cfg_address(slot, offset), size);
+        if(!changedOnly || (memcmp(current, cfgStaging, size) != 0))
+        {
+            v_Cfg_deserializeBlock(cfgStaging, block, pModel);
+        }
+        offset += size;
+    }
+}
+
+// Returns the block size
+static uint8_t u8_Cfg_serializeBlock(const CfgModel_t* pModel, uint8_t block, uint8_t* pBuffer)
+{
+    if(block < CFG_FIRST_RULE_BLOCK)
+    {
+        v_Cfg_serializeChannel(&pModel->pChannels[block], pBuffer);
+        return CFG_CHANNEL_RECORD_SIZE;
+    }
+    if(block < CFG_FIRST_CURVE_BLOCK)
+    {
+        const MixRule_t* pRule = &pModel->pMixes->rules[block - CFG_FIRST_RULE_BLOCK];
+        pBuffer[0] = (uint8_t)(pRule->u8_Source << 4) | (pRule->u8_Destination & 0x0Fu);
+        pBuffer[1] = (uint8_t)pRule->i8_Weight;
+        pBuffer[2] = (uint8_t)pRule->i8_Offset;
+        pBuffer[3] = pRule->u8_Curve;
+        return CFG_RULE_RECORD_SIZE;
+    }
+    memcpy(pBuffer, pModel->pMixes->i8_Curves[block - CFG_FIRST_CURVE_BLOCK], CFG_CURVE_RECORD_SIZE);
+    return CFG_CURVE_RECORD_SIZE;
+}
+
+static void v_Cfg_deserializeBlock(const uint8_t* pBuffer, uint8_t block, const CfgModel_t* pModel)
+{
+    if(block < CFG_FIRST_RULE_BLOCK)
+    {
+        v_Cfg_deserializeChannel(pBuffer, &pModel->pChannels[block]);
+    }
+    else if(block < CFG_FIRST_CURVE_BLOCK)
+    {
+        MixRule_t* pRule = &pModel->pMixes->rules[block - CFG_FIRST_RULE_BLOCK];
+        pRule->u8_Source      = pBuffer[0] >> 4;
+        pRule->u8_Destination = pBuffer[0] & 0x0Fu;
+        pRule->i8_Weight      = (int8_t)pBuffer[1];
+        pRule->i8_Offset      = (int8_t)pBuffer[2];
+        pRule->u8_Curve       = pBuffer[3];
+        v_Mix_sanitizeRule(pRule);
+    }
+    else
+    {
+        int8_t* pPoints = pModel->pMixes->i8_Curves[block - CFG_FIRST_CURVE_BLOCK];
+        uint8_t i;
+        for(i = 0; i < CFG_CURVE_RECORD_SIZE; i++)
+        {
+            pPoints[i] = constrain((int8_t)pBuffer[i], -MIX_MAX_POINT, MIX_MAX_POINT);
+        }
+    }
+}
+
+static void v_Cfg_serializeChannel(const RemoteChannelInput_t* pChannel, uint8_t* pBuffer)
+{
+    pBuffer[0] = (uint8_t)pChannel->u16_Trim;
+    pBuffer[1] = (uint8_t)(pChannel->u16_Trim >> 8);
+    pBuffer[2] = (uint8_t)pChannel->u16_MinValue;
+    pBuffer[3] = (uint8_t)(pChannel->u16_MinValue >> 8);
+    pBuffer[4] = (uint8_t)pChannel->u16_MaxValue;
+    pBuffer[5] = (uint8_t)(pChannel->u16_MaxValue >> 8);
+    pBuffer[6] = (pChannel->b_InvertInput ? CFG_FLAG_INVERT : 0u) | (pChannel->b_expControl ? CFG_FLAG_EXP_CONTROL : 0u);
+    pBuffer[7] = pChannel->u8_Expo;
+    pBuffer[8] = pChannel->u8_Rate;
+    memcpy(&pBuffer[9], pChannel->c_Name, MAX_NAME_CHAR);
+}
+
+// Values out of range can only come from a record of a buggy build, they are clamped rather than trusted
+static void v_Cfg_deserializeChannel(const uint8_t* pBuffer, RemoteChannelInput_t* pChannel)
+{
+    pChannel->u16_Trim      = min((uint16_t)(pBuffer[0] | ((uint16_t)pBuffer[1] << 8)), (uint16_t)ANALOG_MAX_VALUE);
+    pChannel->u16_MinValue  = min((uint16_t)(pBuffer[2] | ((uint16_t)pBuffer[3] << 8)), (uint16_t)ANALOG_MAX_VALUE);
+    pChannel->u16_MaxValue  = min((uint16_t)(pBuffer[4] | ((uint16_t)pBuffer[5] << 8)), (uint16_t)ANALOG_MAX_VALUE);
+    pChannel->b_InvertInput = (pBuffer[6] & CFG_FLAG_INVERT) != 0u;
+    pChannel->b_expControl  = (pBuffer[6] & CFG_FLAG_EXP_CONTROL) != 0u;
+    pChannel->u8_Expo       = min(pBuffer[7], (uint8_t)CURVE_MAX_PERCENT);
+    pChannel->u8_Rate       = min(pBuffer[8], (uint8_t)CURVE_MAX_PERCENT);
+    memcpy(pChannel->c_Name, &pBuffer[9], MAX_NAME_CHAR);
+    pChannel->c_Name[MAX_NAME_CHAR] = '\0';
+}
+
+// Whether the record in <slot> already holds the current configuration, a save would then only wear the EEPROM
+static bool b_Cfg_isStored(uint8_t slot, const CfgModel_t* pModel)
+{
+    uint8_t offset = CFG_HEADER_SIZE;
+    uint8_t block;
+    uint8_t i;
+    for(block = 0; block < CFG_N_BLOCKS; block++)
+    {
+        uint8_t size = u8_Cfg_serializeBlock(pModel, block, cfgStaging);
+        for(i = 0; i < size; i++)
+        {
+            if(eeprom_read_byte(p_Cfg_address(slot, offset + i)) != cfgStaging[i])
+            {
+                return false;
+            }
+        }
+        offset += size;
+    }
+    return true;
+}
+
+// Picks the next slot, round robin, that doesn't hold the newest copy of a record. Returns false if there is nothing to save
+static bool b_Cfg_startWrite(const CfgModel_t* pModel)
+{
+    uint8_t slot = cfgNextSlot;
+    uint8_t i;
+
+    if((cfgNewestSlot[cfgActiveModel] != CFG_NO_SLOT) && b_Cfg_isStored(cfgNewestSlot[cfgActiveModel], pModel))
+    {
+        return false;
+    }
+    for(i = 0; i < N_MODELS; i++)
+    {
+        if(cfgNewestSlot[i] == slot)
+        {
+            slot = (slot + 1u) % CFG_SLOT_COUNT;
+            i    = 0xFFu; // Check the new slot against every model again
+        }
+    }
+
+    cfgWriting          = true;
+    cfgWriteModel       = cfgActiveModel;
+    cfgWriteSlot        = slot;
+    cfgWriteOffset      = 0u;
+    cfgWriteBlock       = 0u;
+    cfgWriteBlockOffset = 0u;
+    cfgWriteCrc         = CFG_CRC_INIT;
+    return true;
+}
+
+// Byte of the record at the current write offset. The CRC is accumulated as the bytes go out
+static uint8_t u8_Cfg_nextWriteByte(const CfgModel_t* pModel)
+{
+    uint8_t data;
+
+    if(cfgWriteOffset < CFG_HEADER_SIZE)
+    {
+        const uint8_t header[CFG_HEADER_SIZE] = {CFG_FORMAT_VERSION, cfgWriteModel, (uint8_t)cfgSequence, (uint8_t)(cfgSequence >> 8)};
+        data = header[cfgWriteOffset];
+    }
+    else if(cfgWriteOffset < CFG_PAYLOAD_END)
+    {
+        if(cfgWriteBlockOffset == 0u)
+        {
+            cfgWriteBlockSize = u8_Cfg_serializeBlock(pModel, cfgWriteBlock, cfgStaging);
+        }
+        data = cfgStaging[cfgWriteBlockOffset];
+        if(++cfgWriteBlockOffset >= cfgWriteBlockSize)
+        {
+            cfgWriteBlock++;
+            cfgWriteBlockOffset = 0u;
+        }
+    }
+    else
+    {
+        return (cfgWriteOffset == CFG_PAYLOAD_END) ? (uint8_t)cfgWriteCrc : (uint8_t)(cfgWriteCrc >> 8);
+    }
+    cfgWriteCrc = u16_Cfg_crcUpdate(cfgWriteCrc, data);
+    return data;
+}
+
+static void v_Cfg_finishWrite()
+{
+    cfgWriting                   = false;
+    cfgNewestSlot[cfgWriteModel] = cfgWriteSlot;
+    cfgNextSlot                  = (cfgWriteSlot + 1u) % CFG_SLOT_COUNT;
+    cfgSequence++;
+}
+
+// One byte per call like the records. Done once both bytes hold the active model
+static void v_Cfg_writeActiveModel()
+{
+    uint8_t data[2] = {cfgActiveModel, (uint8_t)~cfgActiveModel};
+    uint8_t i;
+
+    if(!eeprom_is_ready())
+    {
+        return;
+    }
+    for(i = 0; i < 2u; i++)
+    {
+        uint8_t* pAddress = (uint8_t*)(uintptr_t)(CFG_ACTIVE_MODEL_ADDRESS + i);
+        if(eeprom_read_byte(pAddress) != data[i])
+        {
+            eeprom_write_byte(pAddress, data[i]);
+            return;
+        }
+    }
+    cfgActiveModelDirty = false;
+}
+
+static uint8_t* p_Cfg_address(uint8_t slot, uint8_t offset)
+{
+    return (uint8_t*)(uintptr_t)(((uint16_t)slot * CFG_SLOT_SIZE) + offset);
+}
+
+// CRC16-CCITT (polynomial 0x1021, MSB first), bitwise: 8 shifts per byte, no table in flash
+static uint16_t u16_Cfg_crcUpdate(uint16_t crc, uint8_t data)
+{
+    uint8_t i;
+    crc ^= (uint16_t)data << 8;
+    for(i = 0; i < 8u; i++)
+    {
+        crc = (crc & 0x8000u) ? (uint16_t)((crc << 1) ^ 0x1021u) : (uint16_t)(crc << 1);
+    }
+    return crc;
+}
+
+// Sequence numbers wrap around, a record is newer if it is less than half the sequence space ahead
+static bool b_Cfg_isNewer(uint16_t sequence, uint16_t reference)
+{
+    return (int16_t)(sequence - reference) > 0;
+}
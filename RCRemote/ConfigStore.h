@@ -0,0 +1,89 @@
+/**
+ * @file ConfigStore.h
+ * @author Marcelo Fraga
+ * @brief Persistence of the channel configuration (trim, endpoints, invert, expo/rate, name) and of the mix table in
+ * the EEPROM, one profile per model (N_MODELS). The configuration in RAM is the working set of the active model.
+ * The EEPROM is split in CFG_SLOT_COUNT slots of CFG_SLOT_SIZE bytes. Every save writes a complete record to the next
+ * free slot, round robin, never over the newest record of a model. Once every model is saved, the saves of one model
+ * rotate over the CFG_WEAR_SLOTS slots left: with a 176 byte record, 1KB holds 5 slots, so with 4 models a save only
+ * alternates between 2 slots. Bytes already holding the right value aren't rewritten, a trim change wears the
+ * sequence number, the trim and the CRC of the record only.
+ * A record is: format version, record id (the model), 16 bit sequence number, the channel fields, the mix rules, the
+ * mix curves, CRC16 (CCITT) of all of the above. At boot every slot is checked once and the valid record of the
+ * active model with the highest sequence number is loaded, so the load time only depends on the EEPROM size. The slot
+ * holding the newest record of each model is remembered, so switching models reads a single record. An interrupted
+ * write leaves a record with a bad CRC, the previous one is then loaded instead. Erased EEPROM (0xFF) is never a
+ * valid record.
+ *
+ * Saves are deferred: a request restarts a CFG_SAVE_DELAY_MS delay, so a trim being dragged is saved once it settles.
+ * The write itself is non blocking. v_Cfg_process() writes a byte whenever the EEPROM is ready (~3.3ms per byte) and
+ * skips the bytes that already hold the right value. Only pin and analog/digital kind are not stored, they are wiring.
+ *
+ * A model switch is requested from the UI and applied by b_Cfg_applyModelSwitch() from the sampling task, in one go,
+ * so no frame is ever built from a mix of two models. Edits not saved yet are written to the outgoing model first.
+ * Only the channels, mix rules and curves whose stored fields differ from the working set are loaded. A model never
+ * saved starts as a copy of the outgoing one. The active model is kept in the bytes after the last slot.
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef CONFIGSTORE_H
+#define CONFIGSTORE_H
+#include "Configuration.h"
+#include "Mixer.h"
+
+// Changing the record layout requires a new format version, records of other versions are ignored
+#define CFG_FORMAT_VERSION       0xC2u
+#define CFG_HEADER_SIZE          4u     // Version, record id, sequence (little endian)
+#define CFG_CRC_SIZE             2u
+#define CFG_CHANNEL_RECORD_SIZE  (9u + MAX_NAME_CHAR) // Trim, min, max, flags, expo, rate, name (no terminator)
+#define CFG_RULE_RECORD_SIZE     4u     // Source and destination nibbles, weight, offset, curve
+#define CFG_CURVE_RECORD_SIZE    MIX_CURVE_POINTS
+#define CFG_PAYLOAD_SIZE         ((N_CHANNELS * CFG_CHANNEL_RECORD_SIZE) + (MIX_MAX_RULES * CFG_RULE_RECORD_SIZE) + (MIX_N_CURVES * CFG_CURVE_RECORD_SIZE))
+#define CFG_RECORD_SIZE          (CFG_HEADER_SIZE + CFG_PAYLOAD_SIZE + CFG_CRC_SIZE)
+#define CFG_SLOT_SIZE            CFG_RECORD_SIZE
+#define CFG_EEPROM_SIZE          1024u  // ATmega328
+#define CFG_SLOT_COUNT           (CFG_EEPROM_SIZE / CFG_SLOT_SIZE)
+
+#define CFG_WEAR_SLOTS           (CFG_SLOT_COUNT - N_MODELS + 1u) // Slots one model's saves rotate over, every model saved
+#define CFG_ACTIVE_MODEL_ADDRESS (CFG_SLOT_COUNT * CFG_SLOT_SIZE) // Active model, then its complement
+
+static_assert(CFG_SLOT_COUNT >= (N_MODELS + 1u), "Every model needs its slot plus a free one to write to");
+static_assert(CFG_ACTIVE_MODEL_ADDRESS + 2u <= CFG_EEPROM_SIZE, "Active model must fit after the slots");
+
+// Working set saved per model
+typedef struct CfgModel_t
+{
+    RemoteChannelInput_t* pChannels;
+    MixConfig_t*          pMixes;
+}CfgModel_t;
+
+
+/// @brief Scans the EEPROM and loads the newest valid record of the active model into <pModel>. Returns false,
+///        leaving <pModel> untouched, if there is none (first boot, or a different format version).
+///        Must be called once at startup.
+bool b_Cfg_load(const CfgModel_t* pModel);
+
+/// @brief Asks for the configuration to be saved. The save starts CFG_SAVE_DELAY_MS after the last request.
+void v_Cfg_requestSave();
+
+/// @brief Runs the pending save, if any: writes at most one byte per call, never waits for the EEPROM.
+///        Meant to be called periodically, at least every 3.3ms to write at the EEPROM speed.
+void v_Cfg_process(const CfgModel_t* pModel);
+
+/// @brief A save is requested or being written.
+bool b_Cfg_isBusy();
+
+/// @brief Asks to switch to model <model> (0 - N_MODELS-1). Pending edits of the active model are saved right away.
+void v_Cfg_selectModel(uint8_t model);
+
+/// @brief Applies a requested model switch to <pModel> once the active model is saved. Returns true if the working
+///        set was switched: curve tables and mixer must then be updated before the channels are processed again.
+bool b_Cfg_applyModelSwitch(const CfgModel_t* pModel);
+
+uint8_t u8_Cfg_getActiveModel();
+
+#endif
@@ -15,10 +15,7 @@
 
 #ifndef CONFIGURATION_H
 #define CONFIGURATION_H
-#include <Arduino.h>
-
-#define ON  1u
-#define OFF 0u
+#include <LinkConfiguration.h> // Channels, radio link and link features shared with the receiver (libraries/RCLink)
 
 
 /*
@@ -32,9 +29,24 @@
 
 #define BATTERY_INDICATION        OFF
 #define OLED_SCREEN               OFF
-#define OLED_SCREEN_LOW_MEM_MODE  ON
+#define OLED_SCREEN_LOW_MEM_MODE  ON  // 128 byte display page buffer. OFF uses a full 1KB framebuffer and sends only the changed tiles, for boards with more SRAM
+#define DISPLAY_ASYNC_I2C         OFF // Display sent in the background by the TWI interrupt (DisplayTwi.h). Needs U8g2 built with U8X8_NO_HW_I2C. OFF uses the blocking U8g2 HW I2C (Wire)
 #define RESPONSIVE_ANALOG_READ    OFF // TODO: Make sure we can disable responsive read. At this point it isn't possible without breaking the software.
 #define TIMEOUT_DETECTION         OFF
+#define FIXED_POINT_PROCESSING    ON  // Integer analog channel processing: expo/rate from UQ1.15 curve tables (ChannelCurve.h), invert, trim and endpoints on the 10 bit values. OFF falls back to the original soft-float implementation
+#define CHANNEL_PIPELINE          ON  // Channels read and processed by a routine unrolled at compile time for the channel layout (ChannelPipeline.h). Needs FIXED_POINT_PROCESSING
+#define PROCESSING_BENCHMARK      OFF // Prints a float vs fixed point cycle count comparison of the channel processing at startup
+#define MIXER_BENCHMARK           OFF // Prints the cycle count of mixing a frame with 8 and 16 rules at startup
+#define PIPELINE_BENCHMARK        OFF // Prints a generic loop vs compile time pipeline cycle count comparison of the channel reading at startup
+#define DISPLAY_BENCHMARK         OFF // Prints a blocking vs asynchronous display transport frame time comparison at startup. Needs DISPLAY_ASYNC_I2C
+#define UI_SRAM_REPORT            OFF // Prints the SRAM used by the Ui, per page and component type, at startup
+#define LOOP_TIMING               OFF // Per stage loop timing statistics, binary dump over Serial and diagnostics page
+#define TASK_SCHEDULER            ON  // Fixed rate tasks (sampling, TX, UI) released by a timer tick. OFF runs everything back to back in loop()
+#define PAYLOAD_DELTA_ENCODING    ON  // Frames carry deltas against an acknowledged keyframe when smaller. OFF sends keyframes only
+#define ADC_SAMPLER               ON  // Analog channels sampled in the background by the ADC interrupt. OFF uses a blocking analogRead per channel
+#define CONFIGURATION_STORAGE     ON  // Channel configuration saved to the EEPROM when changed from the UI, loaded at startup
+#define BUTTON_EVENTS             ON  // Buttons read by a pin change interrupt, debounced and queued as events (ButtonEvents.h). OFF polls them on every Ui update
+// FREQUENCY_HOPPING and RATE_CONTROL change the wire protocol, they are in LinkConfiguration.h with the receiver
 
 /* 
  *  Channel configuration indices  
@@ -105,33 +117,69 @@
 /* Input channels and controller input declarations */ 
 
 #define MAX_NAME_CHAR 3u
-// 17/06 -> Stopped considering joystick buttons
-// 24/07/2024 -> Re-done wiring on a physical level, allowing for more channels
-// NOTE: Changing this requires that you flash new software on the receiver, with the same nr of channels
-// This is due to thte fact that this macro is used on the payload definition as well.
-#define N_CHANNELS 8u  
-#define N_ANALOG_CHANNELS 6u
 #define N_BUTTONS  3u 
+#define N_MODELS   4u  // Model profiles kept in the EEPROM, each with its own channel configuration
 
-#define ANALOG_MAX_VALUE 1023
-#define ANALOG_MIN_VALUE 0
-#define ANALOG_HALF_VALUE 512
 
 
+// Expo/rate curve applied to channels with b_expControl. Curve is n * |n| * (E * (1 - |n|) + |n|) * Rate, E being the expo
+// factor (lower E, softer center). Each channel has its own expo and rate, these are the defaults.
+#define DEFAULT_EXPO_PERCENT   90u
+#define DEFAULT_RATE_PERCENT   100u
+#define CURVE_MAX_PERCENT      100u
+#define CURVE_LUT_SEGMENT_BITS 4u    // Curves are evaluated through a lookup table of 2^bits segments, linearly interpolated
+#define CURVE_LUT_RAM_TABLES   0u    // Tables for non default curves, 2 * (2^bits + 1) bytes of RAM each, up to N_ANALOG_CHANNELS. A non default curve without one is evaluated for each sample
 
-#define EXPONENTIAL_VALUE 0.9f
+// Input filters, per analog channel (ChannelFilter.h). Parameters of the filter table in RCRemote.ino
+#define EMA_ALPHA_VALUE        0.85f  // EMA: weight of the new sample. Lower, smoother and more lag
+#define ONE_EURO_MIN_CUTOFF_HZ 1.0f   // 1-Euro: cutoff at rest. Lower, smoother at rest
+#define ONE_EURO_BETA          0.015f // 1-Euro: cutoff increase in Hz per LSB/s of speed. Higher, less lag on fast moves
 
-#define EMA_ALPHA_VALUE   0.85f // Smoothing factor for the EMA smoothing function
+// Each ADC sampler result is the sum of 4^bits conversions, decimated to 10 + bits bits. With 6 channels at 52us per
+// conversion, 1 bit (11 bit results) refreshes every channel at ~640Hz, 2 bits (12 bit results) at ~190Hz.
+#define ADC_OVERSAMPLING_BITS 1u
 
+// Fixed point curve magnitudes (unsigned, UQ1.15): normalized values in [0, 1] are scaled by Q15_ONE, 1.0 included.
+#define Q15_ONE                 32768l
 
-/* Radio configuration */ // TODO: Add here other configurations like PA level and data rate
-#define TX_TIMEOUT    5000 // in milliseconds. Time to trigger "No communication" on screen
 
-/*
-* NRF24L01 RFCom related
-*/
-#define RF_ADDRESS_SIZE 3u
-const byte RF_Address[RF_ADDRESS_SIZE] = "FG";
+/* Task scheduler configuration. The tick uses Timer2 (PWM on pins 3 and 11 and tone() are not available) */
+#define SCHEDULER_TICK_US 1000u
+#define SAMPLE_RATE_HZ    500u  // Input sampling. 500 - 1000Hz
+#define RADIO_POLL_RATE_HZ 1000u // Completion checks of the transmission in flight (no SPI traffic while idle)
+#define UI_RATE_HZ        20u   // Ui updates and display frames. 10 - 20Hz
+#define STORAGE_RATE_HZ   250u  // EEPROM writes of a pending save, one byte per run. A byte takes ~3.3ms to write
+
+/* Buttons */
+#define BUTTON_DEBOUNCE_MS      10u   // Bounces within this time of a transition are ignored
+#define BUTTON_HOLD_MS          1500u
+#define BUTTON_REPEAT_DELAY_MS  400u  // Auto repeat of a held button: first repeat after the press
+#define BUTTON_REPEAT_PERIOD_MS 100u  // then one every period
+
+/* Display configuration */
+#define DISPLAY_I2C_CLOCK_HZ 400000ul // SSD1306 rated clock. Most modules also run at 1000000 (fast mode plus)
+
+/* Configuration storage */
+#define CFG_SAVE_DELAY_MS 2000ul // A save starts once the configuration stopped changing for this long
+
+/* Radio configuration */ // TODO: Add here other configurations like PA level and data rate. Frame rate, address and retries are in LinkConfiguration.h
+#define TX_TIMEOUT    5000 // in milliseconds. Time to trigger "No communication" on screen
+#define RADIO_TX_GUARD_US 40000ul // A transmission still in flight after this is considered failed. Retries end within a TX period
+#define LINK_STATS_WINDOW          32u // Transmissions the link quality statistics are computed over
+#define LINK_STATS_UPDATE_INTERVAL 8u  // Statistics are recomputed every this many transmissions
+#define RF_SCAN_SWEEPS       20u  // Received power samples of every channel in the startup scan, ~25ms per sweep
+#define RF_SCAN_DWELL_US     170u // Listening time before a sample, the chip needs 170us to detect power
+#define RF_HOP_CHANNELS      8u   // Channels of the hop sequence. Power of 2, up to 16
+#define RF_HOP_FIRST_CHANNEL 2u   // Hop channels stay within the 2.400 - 2.4835GHz band
+#define RF_HOP_LAST_CHANNEL  80u
+#define RF_HOP_MIN_SPACING   2u   // In MHz (channels). A 1Mbps signal is 1MHz wide, 2MHz at 2Mbps
+#define RF_HOP_REBIND_MS     RF_RECEIVER_LINK_LOST_MS // Nothing acknowledged for this long, back to binding (receiver lost). The receiver does the same
+#define RF_RATE_LOSS_TARGET      2u   // In percent of the frames. Above it, a more robust setting is used
+#define RF_RATE_WINDOW           50u  // Frames the loss and retries are measured over, before each decision
+#define RF_RATE_UP_WINDOWS       2u   // Good windows in a row before trying a faster / lower power setting
+#define RF_RATE_UP_RETRIES_X10   2u   // Mean auto retransmits per frame, times 10, a good window stays under
+#define RF_RATE_DOWN_RETRIES_X10 5u   // Above it, a more robust setting is used. Retries cost more air time than a slower rate
+#define RF_RATE_FALLBACK_MS      RF_RECEIVER_LINK_LOST_MS // Nothing acknowledged for this long, back to the base settings. The receiver does the same
 
 
 typedef struct RemoteChannelInput_t
@@ -144,7 +192,9 @@ typedef struct RemoteChannelInput_t
   uint16_t u16_MaxValue;        // Absolute value for MaxValue limit, for end point adjustment
   bool     b_InvertInput;
   bool     b_Analog;            // Analog input or not
-  bool     b_expControl;        // Exponential control (For now, while in this low memory controller, don't allow for tuning of this)
+  bool     b_expControl;        // Exponential control. Applies the expo/rate curve below
+  uint8_t  u8_Expo;             // Expo factor of the curve, in percent
+  uint8_t  u8_Rate;             // Rate (output scale around the center), in percent
   char     c_Name[MAX_NAME_CHAR+1]; // Channel name
 }RemoteChannelInput_t;
 // TODO: on higher memory controllers, we should have a raw and processed value saved in this structure instead of changing the actual value.
@@ -154,9 +204,22 @@ typedef struct RemoteCommunicationState_t
 {
   bool           b_ConnectionLost;
   unsigned long  l_TransmissionTime; // In uSeconds
+
+  // Link quality over the last LINK_STATS_WINDOW transmissions
+  uint8_t        u8_LossPercent;     // Transmissions that ran out of retries
+  uint8_t        u8_RetriesX10;      // Mean auto retransmits (ARC_CNT) per transmission, times 10
+  uint16_t       u16_LatencyP50;     // Time to ACK percentiles in uSeconds, acknowledged transmissions only
+  uint16_t       u16_LatencyP95;
+
+  // Receiver telemetry, carried by the ACK payloads
+  bool           b_TelemetryValid;
+  uint16_t       u16_RxReceived;     // Frames received by the receiver (wraps around)
+  uint16_t       u16_RxLost;         // Sequence numbers the receiver never saw (wraps around)
+  uint16_t       u16_RxLoopTime;     // In uSeconds
+  uint16_t       u16_RxVoltage;      // In mV, 0 when the receiver doesn't measure it
 }RemoteCommunicationState_t;
 
-// Radio interface. Changes in this structure involve changes on the receiver as well
+// Channel values handed to the radio. On air they are packed by PayloadCodec, whose format must match the receiver
 typedef struct RFPayload
 {
   uint16_t u16_Channels[N_CHANNELS];
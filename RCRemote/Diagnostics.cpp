@@ -0,0 +1,170 @@
+/**
+ * @file Diagnostics.cpp
+ * @author Marcelo Fraga
+ * @brief Loop timing instrumentation. See Diagnostics.h
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "Diagnostics.h"
+
+#if LOOP_TIMING == ON
+
+#define DIAG_HISTOGRAM_FIRST_BIN_US 16u
+
+static DiagLoopStats_t diagStats;
+static unsigned long   stageStartTime[N_DIAG_STAGES];
+
+// Counters of the current rate window
+static unsigned long   windowStartTime;
+static uint16_t        windowLoops;
+static uint16_t        windowTransmissions;
+static uint16_t        windowAcknowledged;
+
+
+/** Internal functions **/
+static uint8_t u8_Diag_histogramBin(uint32_t duration);
+static void    v_Diag_recordStage(DiagStageStats_t* pStage, uint32_t duration);
+static void    v_Diag_updateRates();
+
+
+void v_Diag_init()
+{
+    diagStats.u16_LoopHz    = 0;
+    diagStats.u16_TxHz      = 0;
+    diagStats.u8_AckPercent = 0;
+    diagStats.u16_Overruns  = 0;
+    windowStartTime         = millis();
+    windowLoops             = 0;
+    windowTransmissions     = 0;
+    windowAcknowledged      = 0;
+    v_Diag_reset();
+}
+
+void v_Diag_reset()
+{
+    uint8_t i;
+    memset(diagStats.stages, 0, sizeof(diagStats.stages));
+    for(i = 0; i < N_DIAG_STAGES; i++)
+    {
+        diagStats.stages[i].u32_Min = 0xFFFFFFFFul;
+    }
+}
+
+void v_Diag_stageBegin(DiagStage eStage)
+{
+    stageStartTime[eStage] = micros();
+}
+
+void v_Diag_stageEnd(DiagStage eStage)
+{
+    v_Diag_recordStage(&diagStats.stages[eStage], micros() - stageStartTime[eStage]);
+
+    if(eStage == DIAG_STAGE_LOOP)
+    {
+        windowLoops++;
+        v_Diag_updateRates();
+    }
+}
+
+void v_Diag_recordDuration(DiagStage eStage, uint32_t duration)
+{
+    v_Diag_recordStage(&diagStats.stages[eStage], duration);
+}
+
+void v_Diag_recordTransmission(bool acknowledged)
+{
+    windowTransmissions++;
+    windowAcknowledged += acknowledged ? 1u : 0u;
+}
+
+void v_Diag_recordOverruns(uint16_t overruns)
+{
+    diagStats.u16_Overruns = overruns;
+}
+
+uint32_t u32_Diag_getStageMean(DiagStage eStage)
+{
+    const DiagStageStats_t* pStage = &diagStats.stages[eStage];
+    return (pStage->u16_Count == 0) ? 0ul : (pStage->u32_Sum / pStage->u16_Count);
+}
+
+const DiagLoopStats_t* p_Diag_getStats()
+{
+    return &diagStats;
+}
+
+void v_Diag_processSerialRequest()
+{
+    const uint8_t header[] = {'D', 'G', DIAG_DUMP_VERSION, N_DIAG_STAGES, DIAG_HISTOGRAM_BINS};
+    bool dumpRequested = false;
+
+    while(Serial.available() > 0)
+    {
+        dumpRequested |= (Serial.read() == DIAG_DUMP_REQUEST);
+    }
+
+    if(dumpRequested)
+    {
+        Serial.write(header, sizeof(header));
+        Serial.write((const uint8_t*) &diagStats, sizeof(diagStats));
+        v_Diag_reset();
+    }
+}
+
+
+static uint8_t u8_Diag_histogramBin(uint32_t duration)
+{
+    uint8_t  bin   = 0;
+    uint32_t limit = DIAG_HISTOGRAM_FIRST_BIN_US;
+    while((duration >= limit) && (bin < (DIAG_HISTOGRAM_BINS - 1u)))
+    {
+        limit <<= 2;
+        bin++;
+    }
+    return bin;
+}
+
+static void v_Diag_recordStage(DiagStageStats_t* pStage, uint32_t duration)
+{
+    uint8_t bin = u8_Diag_histogramBin(duration);
+
+    pStage->u32_Min = min(pStage->u32_Min, duration);
+    pStage->u32_Max = max(pStage->u32_Max, duration);
+
+    if(pStage->u16_Count >= DIAG_HALVING_COUNT)
+    {
+        pStage->u32_Sum   >>= 1;
+        pStage->u16_Count >>= 1;
+    }
+    pStage->u32_Sum += duration;
+    pStage->u16_Count++;
+
+    if(pStage->u16_Histogram[bin] < 0xFFFFu) // Bins saturate instead of wrapping around
+    {
+        pStage->u16_Histogram[bin]++;
+    }
+}
+
+static void v_Diag_updateRates()
+{
+    unsigned long elapsed = millis() - windowStartTime;
+    if(elapsed < DIAG_RATE_WINDOW_MS)
+    {
+        return;
+    }
+
+    diagStats.u16_LoopHz    = (uint16_t)(((uint32_t)windowLoops * 1000ul) / elapsed);
+    diagStats.u16_TxHz      = (uint16_t)(((uint32_t)windowTransmissions * 1000ul) / elapsed);
+    diagStats.u8_AckPercent = (windowTransmissions == 0) ? 0u : (uint8_t)(((uint32_t)windowAcknowledged * 100ul) / windowTransmissions);
+
+    windowStartTime     = millis();
+    windowLoops         = 0;
+    windowTransmissions = 0;
+    windowAcknowledged  = 0;
+}
+
+#endif
@@ -0,0 +1,93 @@
+/**
+ * @file Diagnostics.h
+ * @author Marcelo Fraga
+ * @brief Lightweight loop timing instrumentation. Each stage of the main loop is timed with micros() and keeps
+ * its min/max/mean and a coarse histogram. Loop rate, TX rate and ACK ratio are computed over a fixed window.
+ * Everything compiles out when LOOP_TIMING is OFF (the DIAG_ macros expand to nothing).
+ * Results can be dumped in binary over Serial (see v_Diag_processSerialRequest) and are shown on the diagnostics page.
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef DIAGNOSTICS_H
+#define DIAGNOSTICS_H
+#include "Configuration.h"
+
+#define DIAG_HISTOGRAM_BINS     8u    // Bin i counts durations in [4^i * 16us, 4^(i+1) * 16us), the first and last bins are open ended
+#define DIAG_RATE_WINDOW_MS     1000u // Window over which loop Hz, TX Hz and the ACK ratio are computed
+#define DIAG_HALVING_COUNT      0x4000u // Sum and count are halved when count reaches this, keeping the mean without overflowing
+
+#define DIAG_DUMP_REQUEST       'D'   // Byte to send over Serial to request a binary dump
+#define DIAG_DUMP_VERSION       3u    // 2: DIAG_STAGE_UI_FRAME, 3: u16_Overruns
+
+enum DiagStage
+{
+    DIAG_STAGE_LOOP,          // Whole loop() iteration
+    DIAG_STAGE_INPUT_READ,
+    DIAG_STAGE_PAYLOAD_BUILD,
+    DIAG_STAGE_RADIO_TX,
+    DIAG_STAGE_BUTTONS,
+    DIAG_STAGE_UI_UPDATE,     // Includes DIAG_STAGE_UI_DRAW
+    DIAG_STAGE_UI_DRAW,
+    DIAG_STAGE_UI_FRAME,      // A whole display frame: the DIAG_STAGE_UI_DRAW calls from its start to its last tile sent
+    N_DIAG_STAGES
+};
+
+// Layout is also the wire format of the binary dump: fixed size fields, as laid out by avr-gcc (packed, little endian)
+typedef struct DiagStageStats_t
+{
+    uint32_t u32_Min;         // In uSeconds
+    uint32_t u32_Max;
+    uint32_t u32_Sum;
+    uint16_t u16_Count;
+    uint16_t u16_Histogram[DIAG_HISTOGRAM_BINS];
+}DiagStageStats_t;
+
+typedef struct DiagLoopStats_t
+{
+    uint16_t         u16_LoopHz;      // Values of the last complete rate window
+    uint16_t         u16_TxHz;
+    uint8_t          u8_AckPercent;
+    uint16_t         u16_Overruns;    // Scheduler overruns of all tasks since startup (TASK_SCHEDULER), not cleared by a dump
+    DiagStageStats_t stages[N_DIAG_STAGES];
+}DiagLoopStats_t;
+
+
+#if LOOP_TIMING == ON
+#define DIAG_STAGE_BEGIN(stage)         v_Diag_stageBegin(stage)
+#define DIAG_STAGE_END(stage)           v_Diag_stageEnd(stage)
+#define DIAG_RECORD_TRANSMISSION(ack)   v_Diag_recordTransmission(ack)
+#define DIAG_RECORD_DURATION(stage, us) v_Diag_recordDuration(stage, us)
+#else
+#define DIAG_STAGE_BEGIN(stage)
+#define DIAG_STAGE_END(stage)
+#define DIAG_RECORD_TRANSMISSION(ack)
+#define DIAG_RECORD_DURATION(stage, us)
+#endif
+
+
+void v_Diag_init();
+void v_Diag_reset();
+
+void v_Diag_stageBegin(DiagStage eStage);
+void v_Diag_stageEnd(DiagStage eStage);
+/// @brief Records a duration (uSeconds) of <eStage> measured elsewhere, e.g. summed over several calls.
+void v_Diag_recordDuration(DiagStage eStage, uint32_t duration);
+
+/// @brief Counts one radio transmission attempt for the TX rate and ACK ratio.
+void v_Diag_recordTransmission(bool acknowledged);
+/// @brief Updates the scheduler overrun total (deadline misses and skipped releases of all tasks).
+void v_Diag_recordOverruns(uint16_t overruns);
+
+/// @brief Mean duration of <eStage> in uSeconds, 0 if never recorded.
+uint32_t u32_Diag_getStageMean(DiagStage eStage);
+const DiagLoopStats_t* p_Diag_getStats();
+
+/// @brief Writes a binary dump of all statistics over Serial when DIAG_DUMP_REQUEST was received, then resets them.
+///        Dump: 'D' 'G' version nStages nBins, followed by the DiagLoopStats_t structure as is.
+void v_Diag_processSerialRequest();
+
+#endif
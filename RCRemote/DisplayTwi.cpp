@@ -0,0 +1,276 @@
+/**
+ * @file DisplayTwi.cpp
+ * @author Marcelo Fraga
+ * @brief Interrupt driven I2C transport of the display. See DisplayTwi.h
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "DisplayTwi.h"
+
+#if DISPLAY_ASYNC_I2C == ON
+
+#if defined(__AVR__)
+#include <util/twi.h>
+
+static_assert((F_CPU / DISPLAY_I2C_CLOCK_HZ) >= 16u, "I2C clock too high for the CPU clock");
+static_assert(((F_CPU / DISPLAY_I2C_CLOCK_HZ) - 16u) / 2u <= 0xFFu, "I2C clock too low without the TWI prescaler");
+#define TWI_BIT_RATE   ((uint8_t)(((F_CPU / DISPLAY_I2C_CLOCK_HZ) - 16u) / 2u))
+#define TWI_CONTROL    ((1 << TWINT) | (1 << TWEN) | (1 << TWIE))
+#endif
+
+static_assert(TWI_QUEUE_SIZE <= 0xFFu, "Queue indices are 8 bit");
+static_assert(TWI_QUEUE_SIZE >= 64u, "A transaction must always fit in the queue");
+
+// Transactions are queued as [data length][address][data]. The bus only sends up to twiCommitted, the transaction being
+// queued (from twiHeader to twiHead) is committed once complete
+static uint8_t          twiQueue[TWI_QUEUE_SIZE];
+static uint8_t          twiHead;            // Next free byte. Caller only
+static uint8_t          twiHeader;          // Length byte of the transaction being queued
+static uint8_t          twiLength;          // Data bytes of the transaction being queued
+static volatile uint8_t twiCommitted;
+static volatile uint8_t twiTail;            // Next byte to send. Interrupt only
+static volatile bool    twiBusy;            // The interrupt is going through the queue
+static uint8_t          twiRemaining;       // Data bytes left in the transaction on the bus. Interrupt only
+static bool             twiBlocking;
+
+#if !defined(__AVR__)
+#define TWI_BYTE_US    ((9ul * 1000000ul + DISPLAY_I2C_CLOCK_HZ - 1ul) / DISPLAY_I2C_CLOCK_HZ) // 8 bits and the ACK
+static unsigned long    twiBusStart;        // micros() when the bus last went busy
+static uint32_t         twiBusBytes;        // Bytes sent since then
+static bool             twiInTransaction;
+#endif
+
+
+/** Internal functions **/
+static uint8_t u8_Twi_next(uint8_t index);
+static uint8_t u8_Twi_free();
+static void    v_Twi_push(uint8_t value);
+// Waits for the bus to send some more
+static void    v_Twi_wait();
+static uint8_t u8_Twi_pop();
+// Starts sending the transaction at the tail, returns its address
+static uint8_t u8_Twi_startTransaction();
+static void    v_Twi_startBus();
+#if !defined(__AVR__)
+static void    v_Twi_hostDrain();
+#endif
+
+
+#if defined(__AVR__)
+ISR(TWI_vect)
+{
+    switch(TW_STATUS)
+    {
+        case TW_START:
+        case TW_REP_START:
+            TWDR = u8_Twi_startTransaction();
+            TWCR = TWI_CONTROL;
+            return;
+        case TW_MT_SLA_ACK:
+        case TW_MT_DATA_ACK:
+            if(twiRemaining != 0u)
+            {
+                twiRemaining--;
+                TWDR = u8_Twi_pop();
+                TWCR = TWI_CONTROL;
+                return;
+            }
+            break;
+        default: // Not acknowledged, or bus error: the rest of the transaction is dropped
+            while(twiRemaining != 0u)
+            {
+                twiRemaining--;
+                (void)u8_Twi_pop();
+            }
+            break;
+    }
+
+    if(twiTail != twiCommitted)
+    {
+        TWCR = TWI_CONTROL | (1 << TWSTO) | (1 << TWSTA); // STOP, then START of the next transaction
+    }
+    else
+    {
+        TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWSTO);
+        twiBusy = false;
+    }
+}
+#endif
+
+
+uint8_t u8_Twi_byteCallback(u8x8_t* u8x8, uint8_t msg, uint8_t arg_int, void* arg_ptr)
+{
+    const uint8_t* pData = (const uint8_t*)arg_ptr;
+
+    switch(msg)
+    {
+        case U8X8_MSG_BYTE_INIT:
+            twiHead      = 0;
+            twiCommitted = 0;
+            twiTail      = 0;
+            twiBusy      = false;
+            twiRemaining = 0;
+#if defined(__AVR__)
+            digitalWrite(DISPLAY_SDA, HIGH); // Internal pull-ups, like Wire
+            digitalWrite(DISPLAY_SCL, HIGH);
+            TWSR = 0;                        // Prescaler 1
+            TWBR = TWI_BIT_RATE;
+            TWCR = (1 << TWEN);
+#endif
+            break;
+        case U8X8_MSG_BYTE_SET_DC:
+            break; // The SSD1306 I2C framing tells commands from data
+        case U8X8_MSG_BYTE_START_TRANSFER:
+            while(u8_Twi_free() < 2u)
+            {
+                v_Twi_wait();
+            }
+            twiHeader = twiHead;
+            twiLength = 0;
+            twiHead   = u8_Twi_next(twiHead);
+            v_Twi_push(u8x8_GetI2CAddress(u8x8));
+            break;
+        case U8X8_MSG_BYTE_SEND:
+            while(arg_int > 0u)
+            {
+                uint8_t n = u8_Twi_free();
+                n         = min(n, arg_int);
+                if(n == 0u)
+                {
+                    v_Twi_wait();
+                    continue;
+                }
+                arg_int   -= n;
+                twiLength += n;
+                while(n-- > 0u)
+                {
+                    v_Twi_push(*pData++);
+                }
+            }
+            break;
+        case U8X8_MSG_BYTE_END_TRANSFER:
+            twiQueue[twiHeader] = twiLength;
+            twiCommitted        = twiHead;
+            v_Twi_startBus();
+            if(twiBlocking)
+            {
+                v_Twi_flush();
+            }
+            break;
+        default:
+            return 0;
+    }
+    return 1;
+}
+
+void v_Twi_setBlocking(bool blocking)
+{
+    twiBlocking = blocking;
+}
+
+void v_Twi_flush()
+{
+    while(twiBusy)
+    {
+        v_Twi_wait();
+    }
+}
+
+
+static uint8_t u8_Twi_next(uint8_t index)
+{
+    return ((index + 1u) < TWI_QUEUE_SIZE) ? (index + 1u) : 0u;
+}
+
+// One byte always stays free, a full queue would look empty
+static uint8_t u8_Twi_free()
+{
+#if !defined(__AVR__)
+    v_Twi_hostDrain();
+#endif
+    uint8_t tail = twiTail;
+    uint8_t used = (twiHead >= tail) ? (twiHead - tail) : (TWI_QUEUE_SIZE - tail + twiHead);
+    return (uint8_t)(TWI_QUEUE_SIZE - 1u - used);
+}
+
+static void v_Twi_push(uint8_t value)
+{
+    twiQueue[twiHead] = value;
+    twiHead           = u8_Twi_next(twiHead);
+}
+
+static void v_Twi_wait()
+{
+#if !defined(__AVR__)
+    delayMicroseconds(TWI_BYTE_US);
+    v_Twi_hostDrain();
+#endif
+}
+
+static uint8_t u8_Twi_pop()
+{
+    uint8_t value = twiQueue[twiTail];
+    twiTail       = u8_Twi_next(twiTail);
+    return value;
+}
+
+static uint8_t u8_Twi_startTransaction()
+{
+    twiRemaining = u8_Twi_pop();
+    return u8_Twi_pop();
+}
+
+static void v_Twi_startBus()
+{
+#if !defined(__AVR__)
+    v_Twi_hostDrain(); // The bus may have gone idle since
+#endif
+    noInterrupts();
+    if(!twiBusy)
+    {
+        twiBusy = true;
+#if defined(__AVR__)
+        while(TWCR & (1 << TWSTO)); // The STOP of the last transaction may still be going out
+        TWCR = TWI_CONTROL | (1 << TWSTA);
+#else
+        twiBusStart      = micros();
+        twiBusBytes      = 0;
+        twiInTransaction = false;
+#endif
+    }
+    interrupts();
+}
+
+#if !defined(__AVR__)
+// Sends what a DISPLAY_I2C_CLOCK_HZ bus would have sent since the bus went busy, same sequence as the interrupt
+static void v_Twi_hostDrain()
+{
+    uint32_t sentBytes = (uint32_t)(((uint64_t)(micros() - twiBusStart) * DISPLAY_I2C_CLOCK_HZ) / (9ull * 1000000ull));
+
+    while(twiBusy && (twiBusBytes < sentBytes))
+    {
+        twiBusBytes++;
+        if(!twiInTransaction)
+        {
+            (void)u8_Twi_startTransaction();
+            twiInTransaction = true;
+        }
+        else
+        {
+            twiRemaining--;
+            (void)u8_Twi_pop();
+        }
+        if(twiRemaining == 0u)
+        {
+            twiInTransaction = false;
+            twiBusy          = (twiTail != twiCommitted);
+        }
+    }
+}
+#endif
+
+#endif
@@ -0,0 +1,60 @@
+/**
+ * @file DisplayTwi.h
+ * @author Marcelo Fraga
+ * @brief Interrupt driven I2C transport of the display. U8g2 hands every I2C transaction to u8_Twi_byteCallback, which
+ * only queues it: the TWI interrupt sends the queue in the background, chaining the transactions with a STOP and a
+ * START. A page strip is queued in a few uSeconds, so the next strip is drawn while the previous one is still going out
+ * on the bus. Queueing only waits when the queue is full, i.e. when a strip is drawn faster than the bus sends one.
+ * The queue holds a whole strip (one tile row, 145 bytes on the bus with the SSD1306 framing of U8g2).
+ * The TWI interrupt belongs to this transport: Wire can't be used while it runs, and U8g2 must be built without its
+ * HW I2C support (U8X8_NO_HW_I2C in U8x8lib.h), whose Wire based callback defines the same interrupt.
+ * The host build has no TWI: the queue is drained as fast as a DISPLAY_I2C_CLOCK_HZ bus would send it, in micros() time.
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef DISPLAYTWI_H
+#define DISPLAYTWI_H
+#include <U8g2lib.h>
+#include "Configuration.h"
+
+#define TWI_QUEUE_SIZE 160u // Bytes. Each transaction takes a length byte, its address and its data
+
+
+/// @brief U8x8 byte callback (u8x8_msg_cb) of the display, see u8x8_byte_arduino_hw_i2c for the messages.
+///        A transaction must fit in the queue. U8g2 sends at most 26 bytes per transaction.
+uint8_t u8_Twi_byteCallback(u8x8_t* u8x8, uint8_t msg, uint8_t arg_int, void* arg_ptr);
+
+/// @brief With <blocking> set, every transaction is sent before u8_Twi_byteCallback returns, like the Wire transport.
+///        For benchmarks.
+void    v_Twi_setBlocking(bool blocking);
+
+/// @brief Waits until everything queued is sent.
+void    v_Twi_flush();
+
+
+// Same displays as the U8g2 HW I2C constructors, on the interrupt driven transport
+class U8G2_SSD1306_128X64_NONAME_1_TWI_ASYNC : public U8G2
+{
+public:
+    U8G2_SSD1306_128X64_NONAME_1_TWI_ASYNC(const u8g2_cb_t* rotation, uint8_t reset = U8X8_PIN_NONE) : U8G2()
+    {
+        u8g2_Setup_ssd1306_i2c_128x64_noname_1(&u8g2, rotation, u8_Twi_byteCallback, u8x8_gpio_and_delay_arduino);
+        u8x8_SetPin(getU8x8(), U8X8_PIN_RESET, reset);
+    }
+};
+
+class U8G2_SSD1306_128X64_NONAME_F_TWI_ASYNC : public U8G2
+{
+public:
+    U8G2_SSD1306_128X64_NONAME_F_TWI_ASYNC(const u8g2_cb_t* rotation, uint8_t reset = U8X8_PIN_NONE) : U8G2()
+    {
+        u8g2_Setup_ssd1306_i2c_128x64_noname_f(&u8g2, rotation, u8_Twi_byteCallback, u8x8_gpio_and_delay_arduino);
+        u8x8_SetPin(getU8x8(), U8X8_PIN_RESET, reset);
+    }
+};
+
+#endif
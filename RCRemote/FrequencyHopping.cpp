@@ -0,0 +1,217 @@
+/**
+ * @file FrequencyHopping.cpp
+ * @author Marcelo Fraga
+ * @brief Channel scan and frequency hopping of the radio link. See FrequencyHopping.h
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "FrequencyHopping.h"
+
+#if FREQUENCY_HOPPING == ON
+
+static_assert((RF_HOP_CHANNELS & (RF_HOP_CHANNELS - 1u)) == 0u, "Hop channels are picked with a mask of the sequence number");
+static_assert(RF_HOP_CHANNELS <= PAYLOAD_MAX_HOP_CHANNELS, "The hop sequence must fit a bind frame");
+static_assert((RF_HOP_LAST_CHANNEL < HOP_N_SCAN_CHANNELS) && (RF_HOP_FIRST_CHANNEL <= RF_HOP_LAST_CHANNEL), "Hop channels out of range");
+static_assert(((RF_HOP_LAST_CHANNEL - RF_HOP_FIRST_CHANNEL) / RF_HOP_MIN_SPACING) >= RF_HOP_CHANNELS, "Not enough channels for the hop sequence, the bind channel left out");
+static_assert((RF_SCAN_SWEEPS > 0u) && (RF_SCAN_SWEEPS <= 0xFFu), "Scan hits are 8 bit");
+
+static RF24*    hopRadio;
+static HopState hopState;
+static uint8_t  hopChannels[RF_HOP_CHANNELS];                // In hop order
+static uint8_t  hopScanLevels[(HOP_N_SCAN_CHANNELS + 1u) / 2u]; // 4 bits per channel, even channels in the low nibble
+static unsigned long hopLastAckTime;                         // millis()
+static uint8_t  hopFirstSequence;                            // Frame sent on the first channel after the bind
+static bool     hopBound;                                    // Bind frame acknowledged, hopFirstSequence not set yet
+static uint16_t hopRandomState;
+
+
+/** Internal functions **/
+static void     v_Hop_scan(uint8_t* pHits);
+// Quietest channels first. Among equally quiet ones, the farthest from those already picked
+static void     v_Hop_pickChannels(const uint8_t* pHits);
+// Distance to the closest of the <nPicked> first channels, 0xFF if none
+static uint8_t  u8_Hop_distanceToPicked(uint8_t channel, uint8_t nPicked);
+static void     v_Hop_shuffleChannels();
+static uint16_t u16_Hop_random();
+
+
+void v_Hop_init(RF24* pRadio)
+{
+    uint8_t  hits[HOP_N_SCAN_CHANNELS]; // Startup only, on the stack
+    uint8_t  i;
+    uint16_t hitSum = 0u;
+
+    hopRadio = pRadio;
+    v_Hop_scan(hits);
+    memset(hopScanLevels, 0, sizeof(hopScanLevels));
+    for(i = 0; i < HOP_N_SCAN_CHANNELS; i++)
+    {
+        uint8_t level = (uint8_t)(((uint16_t)hits[i] * HOP_SCAN_MAX_LEVEL + RF_SCAN_SWEEPS - 1u) / RF_SCAN_SWEEPS); // A single hit shows
+        hopScanLevels[i / 2u] |= (uint8_t)(level << ((i & 1u) * 4u));
+        hitSum += hits[i];
+    }
+    v_Hop_pickChannels(hits);
+
+    hopRandomState = (uint16_t)micros() ^ (hitSum << 8);
+    if(hopRandomState == 0u)
+    {
+        hopRandomState = 1u;
+    }
+    v_Hop_shuffleChannels();
+
+    hopState = HOP_BINDING;
+    hopBound = false;
+    hopRadio->setChannel(RF_CHANNEL);
+}
+
+uint8_t u8_Hop_buildBindFrame(uint8_t* pBuffer)
+{
+    hopRadio->setChannel(RF_CHANNEL);
+    return u8_Pld_encodeBind(hopChannels, RF_HOP_CHANNELS, pBuffer);
+}
+
+void v_Hop_selectChannel(uint8_t sequence)
+{
+    if(hopBound)
+    {
+        hopFirstSequence = sequence; // Where the receiver waits
+        hopBound         = false;
+    }
+    hopRadio->setChannel(hopChannels[(uint8_t)(sequence - hopFirstSequence) & (RF_HOP_CHANNELS - 1u)]);
+}
+
+void v_Hop_recordTransmission(bool acknowledged)
+{
+    if(acknowledged)
+    {
+        hopBound       = (hopState == HOP_BINDING);
+        hopState       = HOP_HOPPING; // A bind frame got through, the receiver has the sequence
+        hopLastAckTime = millis();
+        return;
+    }
+    if((hopState == HOP_HOPPING) && ((millis() - hopLastAckTime) > RF_HOP_REBIND_MS)) // Time, not frames: failed frames take longer at a slow data rate
+    {
+        hopState = HOP_BINDING;
+    }
+}
+
+HopState e_Hop_getState()
+{
+    return hopState;
+}
+
+uint8_t u8_Hop_getScanLevel(uint8_t channel)
+{
+    if(channel >= HOP_N_SCAN_CHANNELS)
+    {
+        return 0u;
+    }
+    return (hopScanLevels[channel / 2u] >> ((channel & 1u) * 4u)) & 0x0Fu;
+}
+
+bool b_Hop_isHopChannel(uint8_t channel)
+{
+    uint8_t i;
+    for(i = 0; i < RF_HOP_CHANNELS; i++)
+    {
+        if(hopChannels[i] == channel)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+// Same as the RF24 scanner example: the RPD is latched while listening and still readable after
+static void v_Hop_scan(uint8_t* pHits)
+{
+    uint8_t sweep;
+    uint8_t channel;
+
+    memset(pHits, 0, HOP_N_SCAN_CHANNELS);
+    for(sweep = 0; sweep < RF_SCAN_SWEEPS; sweep++)
+    {
+        for(channel = 0; channel < HOP_N_SCAN_CHANNELS; channel++)
+        {
+            hopRadio->setChannel(channel);
+            hopRadio->startListening();
+            delayMicroseconds(RF_SCAN_DWELL_US);
+            hopRadio->stopListening();
+            if(hopRadio->testRPD())
+            {
+                pHits[channel]++;
+            }
+        }
+    }
+    hopRadio->flush_rx(); // Whatever was received on the way
+}
+
+static void v_Hop_pickChannels(const uint8_t* pHits)
+{
+    uint8_t n;
+    uint8_t channel;
+
+    for(n = 0; n < RF_HOP_CHANNELS; n++)
+    {
+        uint8_t bestChannel  = RF_HOP_FIRST_CHANNEL;
+        uint8_t bestHits     = 0xFFu;
+        uint8_t bestDistance = 0u;
+        for(channel = RF_HOP_FIRST_CHANNEL; channel <= RF_HOP_LAST_CHANNEL; channel++)
+        {
+            uint8_t distance = u8_Hop_distanceToPicked(channel, n);
+            uint8_t toBind   = (channel > RF_CHANNEL) ? (channel - RF_CHANNEL) : (RF_CHANNEL - channel);
+            if((distance < RF_HOP_MIN_SPACING) || (toBind < RF_HOP_MIN_SPACING)) // A receiver waiting for a bind frame never ACKs channel frames
+            {
+                continue;
+            }
+            if((pHits[channel] < bestHits) || ((pHits[channel] == bestHits) && (distance > bestDistance)))
+            {
+                bestChannel  = channel;
+                bestHits     = pHits[channel];
+                bestDistance = distance;
+            }
+        }
+        hopChannels[n] = bestChannel;
+    }
+}
+
+static uint8_t u8_Hop_distanceToPicked(uint8_t channel, uint8_t nPicked)
+{
+    uint8_t distance = 0xFFu;
+    uint8_t i;
+    for(i = 0; i < nPicked; i++)
+    {
+        uint8_t d = (channel > hopChannels[i]) ? (channel - hopChannels[i]) : (hopChannels[i] - channel);
+        distance  = min(distance, d);
+    }
+    return distance;
+}
+
+// Fisher-Yates
+static void v_Hop_shuffleChannels()
+{
+    uint8_t i;
+    for(i = RF_HOP_CHANNELS - 1u; i > 0u; i--)
+    {
+        uint8_t j       = (uint8_t)(u16_Hop_random() % (i + 1u));
+        uint8_t channel = hopChannels[i];
+        hopChannels[i]  = hopChannels[j];
+        hopChannels[j]  = channel;
+    }
+}
+
+// 16 bit xorshift (7, 9, 8)
+static uint16_t u16_Hop_random()
+{
+    hopRandomState ^= hopRandomState << 7;
+    hopRandomState ^= hopRandomState >> 9;
+    hopRandomState ^= hopRandomState << 8;
+    return hopRandomState;
+}
+
+#endif
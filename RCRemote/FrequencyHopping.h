@@ -0,0 +1,61 @@
+/**
+ * @file FrequencyHopping.h
+ * @author Marcelo Fraga
+ * @brief Channel scan and frequency hopping of the radio link.
+ *
+ *  - Scan: at startup, every nRF24 channel (0 - 125) is listened to RF_SCAN_SWEEPS times, and the received power
+ *    detector (RPD, over -64dBm) tells whether something was on air. The RF_HOP_CHANNELS channels with the fewest hits
+ *    are picked, RF_HOP_MIN_SPACING apart and away from the bind channel, spread out over the band when equally quiet,
+ *    then shuffled into the hop sequence.
+ *  - Bind: every frame is a bind frame (see PayloadCodec.h) carrying the hop sequence, on RF_CHANNEL, until one is
+ *    acknowledged: the receiver then has the sequence.
+ *  - Hopping: the frame of sequence number s is sent on channel (s - s0) % RF_HOP_CHANNELS of the sequence, s0 being the
+ *    first frame after the bind: the receiver waits for it on the first channel. Interference on one channel only costs
+ *    the frames sent on it. When nothing was acknowledged for RF_HOP_REBIND_MS the receiver is taken
+ *    as lost, binding starts again. The receiver gives up at the same time and waits on RF_CHANNEL.
+ * The radio is only switched between transmissions, while the radio link is idle.
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef FREQUENCYHOPPING_H
+#define FREQUENCYHOPPING_H
+#include "Configuration.h"
+#include <PayloadCodec.h>
+#include <RF24.h>
+
+#define HOP_N_SCAN_CHANNELS 126u // 2.400 - 2.525GHz
+#define HOP_SCAN_MAX_LEVEL  15u
+
+enum HopState
+{
+    HOP_BINDING,    // Bind frames on RF_CHANNEL
+    HOP_HOPPING
+};
+
+
+/// @brief Scans the channels on <pRadio>, which must be initialized and in TX mode, and builds the hop sequence. Takes
+///        RF_SCAN_SWEEPS * ~25ms. Binding starts.
+void     v_Hop_init(RF24* pRadio);
+
+/// @brief Writes the bind frame into <pBuffer> (PAYLOAD_BIND_SIZE(RF_HOP_CHANNELS) bytes) and sets the bind channel.
+///        Returns the frame size.
+uint8_t  u8_Hop_buildBindFrame(uint8_t* pBuffer);
+
+/// @brief Sets the hop channel of the frame of sequence number <sequence>.
+void     v_Hop_selectChannel(uint8_t sequence);
+
+/// @brief Outcome of the last frame, bind or not.
+void     v_Hop_recordTransmission(bool acknowledged);
+
+HopState e_Hop_getState();
+
+/// @brief Received power seen on <channel> during the scan, 0 (never) - HOP_SCAN_MAX_LEVEL (every sweep).
+uint8_t  u8_Hop_getScanLevel(uint8_t channel);
+
+bool     b_Hop_isHopChannel(uint8_t channel);
+
+#endif
@@ -0,0 +1,107 @@
+/**
+ * @file LinkStats.cpp
+ * @author Marcelo Fraga
+ * @brief Rolling link quality statistics. See LinkStats.h
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "LinkStats.h"
+
+#define LINK_STATS_ACK_FLAG     0x80u
+#define LINK_STATS_RETRIES_MASK 0x0Fu
+
+static_assert(LINK_STATS_WINDOW <= 255u, "Window index is 8 bits");
+
+// One entry per transmission: latency saturated to 16 bits, ACK flag and retries packed in one byte
+static uint16_t linkLatencies[LINK_STATS_WINDOW];
+static uint8_t  linkOutcomes[LINK_STATS_WINDOW];
+static uint8_t  linkNextEntry;
+static uint8_t  linkEntries;
+static uint8_t  linkSinceUpdate;
+
+
+/** Internal functions **/
+static void     v_Lnk_updateStatistics(RemoteCommunicationState_t* pState);
+static void     v_Lnk_sort(uint16_t* pValues, uint8_t nValues);
+
+
+void v_Lnk_init()
+{
+    linkNextEntry   = 0u;
+    linkEntries     = 0u;
+    linkSinceUpdate = 0u;
+}
+
+void v_Lnk_recordTransmission(RemoteCommunicationState_t* pState, bool acknowledged, uint8_t retries, unsigned long transmissionTime)
+{
+    linkLatencies[linkNextEntry] = (transmissionTime > 0xFFFFul) ? 0xFFFFu : (uint16_t)transmissionTime;
+    linkOutcomes[linkNextEntry]  = (acknowledged ? LINK_STATS_ACK_FLAG : 0u) | (retries & LINK_STATS_RETRIES_MASK);
+    linkNextEntry                = (linkNextEntry + 1u) % LINK_STATS_WINDOW;
+    linkEntries                  = min((uint8_t)(linkEntries + 1u), (uint8_t)LINK_STATS_WINDOW);
+
+    if(++linkSinceUpdate >= LINK_STATS_UPDATE_INTERVAL)
+    {
+        linkSinceUpdate = 0u;
+        v_Lnk_updateStatistics(pState);
+    }
+}
+
+void v_Lnk_recordTelemetry(RemoteCommunicationState_t* pState, const PldTelemetry_t* pTelemetry)
+{
+    pState->b_TelemetryValid = true;
+    pState->u16_RxReceived   = pTelemetry->u16_Received;
+    pState->u16_RxLost       = pTelemetry->u16_Lost;
+    pState->u16_RxLoopTime   = pTelemetry->u16_LoopTime;
+    pState->u16_RxVoltage    = pTelemetry->u16_Voltage;
+}
+
+
+static void v_Lnk_updateStatistics(RemoteCommunicationState_t* pState)
+{
+    uint16_t ackLatencies[LINK_STATS_WINDOW];
+    uint8_t  nAcknowledged = 0u;
+    uint16_t retries       = 0u;
+    uint8_t  i;
+
+    for(i = 0; i < linkEntries; i++)
+    {
+        retries += linkOutcomes[i] & LINK_STATS_RETRIES_MASK;
+        if(linkOutcomes[i] & LINK_STATS_ACK_FLAG)
+        {
+            ackLatencies[nAcknowledged++] = linkLatencies[i];
+        }
+    }
+
+    pState->u8_LossPercent = (uint8_t)(((uint16_t)(linkEntries - nAcknowledged) * 100u) / linkEntries);
+    pState->u8_RetriesX10  = (uint8_t)((retries * 10u) / linkEntries);
+    if(nAcknowledged == 0u)
+    {
+        pState->u16_LatencyP50 = 0u;
+        pState->u16_LatencyP95 = 0u;
+        return;
+    }
+    v_Lnk_sort(ackLatencies, nAcknowledged);
+    pState->u16_LatencyP50 = ackLatencies[((nAcknowledged - 1u) * 50u) / 100u];
+    pState->u16_LatencyP95 = ackLatencies[((nAcknowledged - 1u) * 95u) / 100u];
+}
+
+// Insertion sort, the window is small
+static void v_Lnk_sort(uint16_t* pValues, uint8_t nValues)
+{
+    uint8_t i;
+    for(i = 1; i < nValues; i++)
+    {
+        uint16_t value = pValues[i];
+        uint8_t  j     = i;
+        while((j > 0u) && (pValues[j - 1u] > value))
+        {
+            pValues[j] = pValues[j - 1u];
+            j--;
+        }
+        pValues[j] = value;
+    }
+}
@@ -0,0 +1,26 @@
+/**
+ * @file LinkStats.h
+ * @author Marcelo Fraga
+ * @brief Rolling link quality statistics. Every finished transmission (ACK or not, retries used, time to ACK) goes
+ * into a ring of the last LINK_STATS_WINDOW ones, from which packet loss, mean retries and latency percentiles are
+ * recomputed every LINK_STATS_UPDATE_INTERVAL transmissions. Receiver telemetry from the ACK payloads is kept as is.
+ * Results are stored in RemoteCommunicationState_t, where the UI picks them up.
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef LINKSTATS_H
+#define LINKSTATS_H
+#include "Configuration.h"
+#include <PayloadCodec.h>
+
+void v_Lnk_init();
+
+void v_Lnk_recordTransmission(RemoteCommunicationState_t* pState, bool acknowledged, uint8_t retries, unsigned long transmissionTime);
+
+void v_Lnk_recordTelemetry(RemoteCommunicationState_t* pState, const PldTelemetry_t* pTelemetry);
+
+#endif
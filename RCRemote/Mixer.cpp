@@ -0,0 +1,159 @@
+/**
+ * @file Mixer.cpp
+ * @author Marcelo Fraga
+ * @brief Channel mixer. See Mixer.h
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "Mixer.h"
+
+#define MIX_WEIGHT_SHIFT 14u  // Weights are Q14, 100% is 16384. 125% still fits in 16 bits
+#define MIX_TABLE_SHIFT  8u   // Curve table segments are 256 input steps wide
+
+static_assert(N_ANALOG_CHANNELS <= 8u, "Mixed destinations are a 8 bit mask");
+static_assert(ANALOG_HALF_VALUE == (2u << MIX_TABLE_SHIFT), "Curve table points are 2^MIX_TABLE_SHIFT apart, 4 segments over the range");
+
+// Compiled rule. Rules are stored in destination order, mixOpEnd[d] is the end of the rules of destination d
+typedef struct MixOp_t
+{
+    uint8_t u8_Source;
+    uint8_t u8_Curve;
+    int16_t i16_Weight;      // Q14
+}MixOp_t;
+
+static MixOp_t mixOps[MIX_MAX_RULES];
+static uint8_t mixOpEnd[N_ANALOG_CHANNELS];
+static int16_t mixOffsets[N_ANALOG_CHANNELS];          // In channel units
+static uint8_t mixMixedMask;                           // Bit d set: destination d has at least one rule
+static int16_t mixCurvePoints[MIX_N_CURVES][MIX_CURVE_POINTS]; // In channel units, relative to the center
+
+
+/** Internal functions **/
+static int16_t i16_Mix_curve(uint8_t curve, int16_t input);
+static int8_t  i8_Mix_clamp(int8_t value, int8_t limit);
+
+
+void v_Mix_initConfig(MixConfig_t* pConfig)
+{
+    uint8_t i;
+    uint8_t j;
+    memset(pConfig->rules, 0, sizeof(pConfig->rules));
+    for(i = 0; i < MIX_N_CURVES; i++)
+    {
+        for(j = 0; j < MIX_CURVE_POINTS; j++)
+        {
+            pConfig->i8_Curves[i][j] = (int8_t)(((int16_t)j * (2 * MIX_MAX_POINT)) / (MIX_CURVE_POINTS - 1u) - MIX_MAX_POINT);
+        }
+    }
+}
+
+void v_Mix_sanitizeRule(MixRule_t* pRule)
+{
+    if((pRule->u8_Source >= N_CHANNELS) || (pRule->u8_Destination >= N_ANALOG_CHANNELS))
+    {
+        pRule->u8_Source      = 0u;
+        pRule->u8_Destination = 0u;
+        pRule->i8_Weight      = 0;
+    }
+    pRule->i8_Weight = i8_Mix_clamp(pRule->i8_Weight, MIX_MAX_WEIGHT);
+    pRule->i8_Offset = i8_Mix_clamp(pRule->i8_Offset, MIX_MAX_OFFSET);
+    if(pRule->u8_Curve >= MIX_CURVE_COUNT)
+    {
+        pRule->u8_Curve = MIX_CURVE_LINEAR;
+    }
+}
+
+void v_Mix_compile(const MixConfig_t* pConfig)
+{
+    uint8_t nOps = 0u;
+    uint8_t d;
+    uint8_t i;
+
+    mixMixedMask = 0u;
+    for(d = 0; d < N_ANALOG_CHANNELS; d++)
+    {
+        int16_t offset = 0;
+        for(i = 0; i < MIX_MAX_RULES; i++)
+        {
+            MixRule_t rule = pConfig->rules[i];
+            v_Mix_sanitizeRule(&rule);
+            if((rule.i8_Weight == 0) || (rule.u8_Destination != d))
+            {
+                continue;
+            }
+            mixOps[nOps].u8_Source  = rule.u8_Source;
+            mixOps[nOps].u8_Curve   = rule.u8_Curve;
+            mixOps[nOps].i16_Weight = (int16_t)(((int32_t)rule.i8_Weight << MIX_WEIGHT_SHIFT) / 100);
+            offset                 += ((int16_t)rule.i8_Offset * ANALOG_HALF_VALUE) / 100;
+            mixMixedMask           |= (uint8_t)(1u << d);
+            nOps++;
+        }
+        mixOpEnd[d]   = nOps;
+        mixOffsets[d] = offset;
+    }
+
+    for(i = 0; i < MIX_N_CURVES; i++)
+    {
+        for(d = 0; d < MIX_CURVE_POINTS; d++)
+        {
+            mixCurvePoints[i][d] = ((int16_t)i8_Mix_clamp(pConfig->i8_Curves[i][d], MIX_MAX_POINT) * ANALOG_HALF_VALUE) / 100;
+        }
+    }
+}
+
+void v_Mix_apply(const RemoteChannelInput_t* pInputs, uint16_t* pOutputs)
+{
+    uint8_t op = 0u;
+    uint8_t d;
+
+    for(d = 0; d < N_ANALOG_CHANNELS; d++)
+    {
+        if(!(mixMixedMask & (1u << d)))
+        {
+            pOutputs[d] = pInputs[d].u16_Value;
+            continue;
+        }
+
+        int32_t sum = (int32_t)mixOffsets[d] << MIX_WEIGHT_SHIFT;
+        for(; op < mixOpEnd[d]; op++)
+        {
+            int16_t input = (int16_t)pInputs[mixOps[op].u8_Source].u16_Value - ANALOG_HALF_VALUE;
+            sum += (int32_t)i16_Mix_curve(mixOps[op].u8_Curve, input) * mixOps[op].i16_Weight;
+        }
+        int32_t value = (sum >> MIX_WEIGHT_SHIFT) + ANALOG_HALF_VALUE;
+        pOutputs[d]   = (value < ANALOG_MIN_VALUE) ? ANALOG_MIN_VALUE : ((value > ANALOG_MAX_VALUE) ? ANALOG_MAX_VALUE : (uint16_t)value);
+    }
+    for(; d < N_CHANNELS; d++) // Digital channels are never mixed
+    {
+        pOutputs[d] = pInputs[d].u16_Value;
+    }
+}
+
+
+// <input> relative to the center (-ANALOG_HALF_VALUE - ANALOG_HALF_VALUE-1)
+static int16_t i16_Mix_curve(uint8_t curve, int16_t input)
+{
+    switch(curve)
+    {
+        case MIX_CURVE_LINEAR:   return input;
+        case MIX_CURVE_POSITIVE: return (input > 0) ? input : 0;
+        case MIX_CURVE_NEGATIVE: return (input < 0) ? input : 0;
+        default:
+        {
+            const int16_t* pPoints  = mixCurvePoints[curve - MIX_CURVE_TABLE];
+            uint16_t       position = (uint16_t)(input + ANALOG_HALF_VALUE);
+            uint8_t        segment  = position >> MIX_TABLE_SHIFT;
+            uint8_t        fraction = (uint8_t)position; // Low MIX_TABLE_SHIFT bits
+            return pPoints[segment] + (int16_t)(((int32_t)(pPoints[segment + 1u] - pPoints[segment]) * fraction) >> MIX_TABLE_SHIFT);
+        }
+    }
+}
+
+static int8_t i8_Mix_clamp(int8_t value, int8_t limit)
+{
+    return (value > limit) ? limit : ((value < -limit) ? -limit : value);
+}
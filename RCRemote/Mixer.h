@@ -0,0 +1,73 @@
+/**
+ * @file Mixer.h
+ * @author Marcelo Fraga
+ * @brief Channel mixer, between the input processing and the payload. A mix table of up to MIX_MAX_RULES rules
+ * (source, destination, weight, offset, curve) describes the outputs. Output channels without any active rule get
+ * their input unchanged, so an empty table is a plain pass-through. Mixed outputs are the sum of their rules:
+ *
+ *      out = center + sum(curve(in[source] - center) * weight) + offset
+ *
+ * The table is compiled (v_Mix_compile) whenever it changes: inactive rules are dropped, the rest are grouped by
+ * destination with Q14 weights and the offsets summed, and the curve tables are scaled to channel units. Mixing a
+ * frame is then one 16x16 multiply-accumulate per rule, no division.
+ *
+ * Curves: linear, positive or negative half only (two rules with different weights make a differential), or one of
+ * the MIX_N_CURVES 5 point tables (e.g. a throttle curve), linearly interpolated.
+ * Examples: elevon is out0 = 50% ail + 50% ele, out1 = -50% ail + 50% ele. V-tail is the same with rudder.
+ * Only analog channels can be destinations, digital ones go on air as 1 bit.
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef MIXER_H
+#define MIXER_H
+#include "Configuration.h"
+
+#define MIX_MAX_RULES     16u
+#define MIX_N_CURVES      2u
+#define MIX_CURVE_POINTS  5u    // At -100%, -50%, 0, 50% and 100% of the input
+#define MIX_MAX_WEIGHT    125   // In percent, both signs
+#define MIX_MAX_OFFSET    100   // In percent of half the channel range, both signs
+#define MIX_MAX_POINT     100   // Curve points, in percent, both signs
+
+enum MixCurve
+{
+    MIX_CURVE_LINEAR,
+    MIX_CURVE_POSITIVE,     // Input above the center only, 0 below
+    MIX_CURVE_NEGATIVE,     // Input below the center only, 0 above
+    MIX_CURVE_TABLE,        // MIX_CURVE_TABLE + i uses curve table i
+    MIX_CURVE_COUNT = MIX_CURVE_TABLE + MIX_N_CURVES
+};
+
+typedef struct MixRule_t
+{
+    uint8_t u8_Source;       // Channel index, analog or digital
+    uint8_t u8_Destination;  // Analog channel index
+    int8_t  i8_Weight;       // In percent. 0 disables the rule
+    int8_t  i8_Offset;       // In percent of half the channel range
+    uint8_t u8_Curve;        // MixCurve
+}MixRule_t;
+
+typedef struct MixConfig_t
+{
+    MixRule_t rules[MIX_MAX_RULES];
+    int8_t    i8_Curves[MIX_N_CURVES][MIX_CURVE_POINTS]; // In percent
+}MixConfig_t;
+
+
+/// @brief Empty table (pass-through) and linear curve tables.
+void v_Mix_initConfig(MixConfig_t* pConfig);
+
+/// @brief Brings every field of <pRule> back in its valid range. A rule with an invalid source or destination is disabled.
+void v_Mix_sanitizeRule(MixRule_t* pRule);
+
+/// @brief Compiles <pConfig>, used by every v_Mix_apply call from now on. Must be called again after any change.
+void v_Mix_compile(const MixConfig_t* pConfig);
+
+/// @brief Mixes the processed values of <pInputs> into N_CHANNELS output values (ANALOG_MIN_VALUE - ANALOG_MAX_VALUE).
+void v_Mix_apply(const RemoteChannelInput_t* pInputs, uint16_t* pOutputs);
+
+#endif
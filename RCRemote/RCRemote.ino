@@ -3,28 +3,70 @@
 #include <Joystick_if.h>
 
 #include "UiManagement.h"
+#include "ChannelCurve.h"
+#include "Diagnostics.h"
+#include "Scheduler.h"
+#include "RadioLink.h"
+#include <PayloadCodec.h>
+#include "LinkStats.h"
+#include "AdcSampler.h"
+#include "ConfigStore.h"
+#include "Mixer.h"
+#include "ChannelFilter.h"
+#include "ChannelPipeline.h"
+#include "ButtonEvents.h"
+#include "FrequencyHopping.h"
+#include "RateControl.h"
 
 
 
 
 
 // Declare and configure each input on the remote controller.
-// As of now, this configuration can be changed on the fly via the UI. 
-// TODO: Make sure the configuration can be saved in the EEPROM/Non Volatile memory.
+// As of now, this configuration can be changed on the fly via the UI. Changes are saved to the EEPROM (see ConfigStore.h),
+// these are the defaults until the first save.
 RemoteChannelInput_t RemoteInputs[N_CHANNELS] = 
-                                    // Pin,                     Val,RVal,  Trim,                Min,                Max,               Invert,  isAnalog,, exp  Channel Name  
-                                   {{JOYSTICK_LEFT_AXIS_X_PIN,  0u, 0u,  ANALOG_HALF_VALUE,   ANALOG_MIN_VALUE,   ANALOG_MAX_VALUE,  false,    true,  true, "JLX"}, 
-                                    {JOYSTICK_LEFT_AXIS_Y_PIN,  0u, 0u,  ANALOG_HALF_VALUE,   200u,               750u,              false,    true,  true, "JLY"}, 
-                                    {JOYSTICK_RIGHT_AXIS_X_PIN, 0u, 0u,  ANALOG_HALF_VALUE,   200u,               750u,              true,     true,  true, "JRX"}, 
-                                    {JOYSTICK_RIGHT_AXIS_Y_PIN, 0u, 0u,  ANALOG_HALF_VALUE,   ANALOG_MIN_VALUE,   ANALOG_MAX_VALUE,  false,    true,  true, "JRY"}, 
-                                    {POT_LEFT_PIN,              0u, 0u,  0u,                  ANALOG_MIN_VALUE,   ANALOG_MAX_VALUE,  false,    true,  true, "PL"},  
-                                    {POT_RIGHT_PIN,             0u, 0u,  0u,                  ANALOG_MIN_VALUE,   ANALOG_MAX_VALUE,  false,    true,  true, "PR"},  
-                                    {SWITCH_SP_LEFT_PIN,        0u, 0u,  0u,                  ANALOG_MIN_VALUE,   ANALOG_MAX_VALUE,  false,    false, true, "SWL"}, 
-                                    {SWITCH_SP_RIGHT_PIN,       0u, 0u,  0u,                  ANALOG_MIN_VALUE,   ANALOG_MAX_VALUE,  false,    false, true, "SWR"}};
+                                    // Pin,                     Val,RVal,  Trim,                Min,                Max,               Invert,  isAnalog,, exp, Expo,                 Rate,                 Channel Name  
+                                   {{JOYSTICK_LEFT_AXIS_X_PIN,  0u, 0u,  ANALOG_HALF_VALUE,   ANALOG_MIN_VALUE,   ANALOG_MAX_VALUE,  false,    true,  true, DEFAULT_EXPO_PERCENT, DEFAULT_RATE_PERCENT, "JLX"}, 
+                                    {JOYSTICK_LEFT_AXIS_Y_PIN,  0u, 0u,  ANALOG_HALF_VALUE,   200u,               750u,              false,    true,  true, DEFAULT_EXPO_PERCENT, DEFAULT_RATE_PERCENT, "JLY"}, 
+                                    {JOYSTICK_RIGHT_AXIS_X_PIN, 0u, 0u,  ANALOG_HALF_VALUE,   200u,               750u,              true,     true,  true, DEFAULT_EXPO_PERCENT, DEFAULT_RATE_PERCENT, "JRX"}, 
+                                    {JOYSTICK_RIGHT_AXIS_Y_PIN, 0u, 0u,  ANALOG_HALF_VALUE,   ANALOG_MIN_VALUE,   ANALOG_MAX_VALUE,  false,    true,  true, DEFAULT_EXPO_PERCENT, DEFAULT_RATE_PERCENT, "JRY"}, 
+                                    {POT_LEFT_PIN,              0u, 0u,  ANALOG_HALF_VALUE,   ANALOG_MIN_VALUE,   ANALOG_MAX_VALUE,  false,    true,  true, DEFAULT_EXPO_PERCENT, DEFAULT_RATE_PERCENT, "PL"},  
+                                    {POT_RIGHT_PIN,             0u, 0u,  ANALOG_HALF_VALUE,   ANALOG_MIN_VALUE,   ANALOG_MAX_VALUE,  false,    true,  true, DEFAULT_EXPO_PERCENT, DEFAULT_RATE_PERCENT, "PR"},  
+                                    {SWITCH_SP_LEFT_PIN,        0u, 0u,  0u,                  ANALOG_MIN_VALUE,   ANALOG_MAX_VALUE,  false,    false, true, DEFAULT_EXPO_PERCENT, DEFAULT_RATE_PERCENT, "SWL"}, 
+                                    {SWITCH_SP_RIGHT_PIN,       0u, 0u,  0u,                  ANALOG_MIN_VALUE,   ANALOG_MAX_VALUE,  false,    false, true, DEFAULT_EXPO_PERCENT, DEFAULT_RATE_PERCENT, "SWR"}};
+
+#if CHANNEL_PIPELINE == ON
+// Kind of each channel of RemoteInputs, the read and process routine is generated from it. Must match b_Analog and
+// b_expControl above, checked at startup
+typedef PipPipeline<PipAnalogCurve, PipAnalogCurve, PipAnalogCurve, PipAnalogCurve, PipAnalogCurve, PipAnalogCurve, // JLX, JLY, JRX, JRY, PL, PR
+                    PipDigital, PipDigital>                                                                         // SWL, SWR
+        ChannelPipeline_t;
+bool b_ChannelPipelineActive = false;
+#endif
+
+// Input filter of each analog channel, in RemoteInputs order (see ChannelFilter.h). Sticks: spike rejection and 1-Euro,
+// steady at rest with little lag on fast moves. Pots are also the scroll wheels, the wider median keeps them steadier
+FltConfig_t ChannelFilters[N_ANALOG_CHANNELS] =
+                  // Median,       Smoothing,              EMA alpha,                         Min cutoff,                                  Beta
+                  {{FLT_MEDIAN_3, FLT_SMOOTHING_ONE_EURO, FLT_EMA_ALPHA_Q8(EMA_ALPHA_VALUE), FLT_MIN_CUTOFF_X10(ONE_EURO_MIN_CUTOFF_HZ), FLT_BETA_MILLI(ONE_EURO_BETA)},  // JLX
+                   {FLT_MEDIAN_3, FLT_SMOOTHING_ONE_EURO, FLT_EMA_ALPHA_Q8(EMA_ALPHA_VALUE), FLT_MIN_CUTOFF_X10(ONE_EURO_MIN_CUTOFF_HZ), FLT_BETA_MILLI(ONE_EURO_BETA)},  // JLY
+                   {FLT_MEDIAN_3, FLT_SMOOTHING_ONE_EURO, FLT_EMA_ALPHA_Q8(EMA_ALPHA_VALUE), FLT_MIN_CUTOFF_X10(ONE_EURO_MIN_CUTOFF_HZ), FLT_BETA_MILLI(ONE_EURO_BETA)},  // JRX
+                   {FLT_MEDIAN_3, FLT_SMOOTHING_ONE_EURO, FLT_EMA_ALPHA_Q8(EMA_ALPHA_VALUE), FLT_MIN_CUTOFF_X10(ONE_EURO_MIN_CUTOFF_HZ), FLT_BETA_MILLI(ONE_EURO_BETA)},  // JRY
+                   {FLT_MEDIAN_5, FLT_SMOOTHING_ONE_EURO, FLT_EMA_ALPHA_Q8(EMA_ALPHA_VALUE), FLT_MIN_CUTOFF_X10(ONE_EURO_MIN_CUTOFF_HZ), FLT_BETA_MILLI(ONE_EURO_BETA)},  // PL
+                   {FLT_MEDIAN_5, FLT_SMOOTHING_ONE_EURO, FLT_EMA_ALPHA_Q8(EMA_ALPHA_VALUE), FLT_MIN_CUTOFF_X10(ONE_EURO_MIN_CUTOFF_HZ), FLT_BETA_MILLI(ONE_EURO_BETA)}}; // PR
+
+// Mix table between the processed inputs and the payload. Empty (pass-through) until configured from the UI
+MixConfig_t      MixConfig;
+const CfgModel_t ModelConfiguration = {RemoteInputs, &MixConfig};
 
 RemoteCommunicationState_t RemoteCommunicationState = {false, 0l};
 UiM_t_Inputs  uiInputs;
-UiM_t_rPorts  uiInputData = {&uiInputs, RemoteInputs, &RemoteCommunicationState};
+#if LOOP_TIMING == ON
+UiM_t_rPorts  uiInputData = {&uiInputs, RemoteInputs, &RemoteCommunicationState, 0u, &MixConfig, p_Diag_getStats()};
+#else
+UiM_t_rPorts  uiInputData = {&uiInputs, RemoteInputs, &RemoteCommunicationState, 0u, &MixConfig};
+#endif
 UiM_t_pPorts  uiResponseData = {false};
 
 
@@ -36,15 +78,27 @@ UiM_t_pPorts  uiResponseData = {false};
 BatteryIndication battery(BATTERY_INDICATION_PIN, R1, R2, BATTERY_9V);
 #endif
 
+static_assert(N_CHANNELS == PAYLOAD_N_CHANNELS, "Wire format must carry every channel");
+static_assert(ANALOG_MAX_VALUE == PAYLOAD_CHANNEL_MAX_VALUE, "Wire format analog fields must hold the full channel range");
+static_assert(PAYLOAD_DIGITAL_CHANNEL_MASK == ((1u << SWITCH_SP_LEFT_CHANNEL_IDX) | (1u << SWITCH_SP_RIGHT_CHANNEL_IDX)), "Wire format digital channels must be the switches");
+static_assert((1000000ul / TX_RATE_HZ) >= RF_ATTEMPT_MAX_US, "A frame attempt must fit the TX period");
+
 // Remote Transmitter_Remote;
 RFPayload payload;
+PldEncoder_t payloadEncoder;
+#if FREQUENCY_HOPPING == ON
+uint8_t      u8_PayloadFrame[max(PAYLOAD_MAX_SIZE, PAYLOAD_BIND_SIZE(RF_HOP_CHANNELS))]; // Packed or bind frame of the transmission in flight
+boolean      b_ChannelFrameInFlight; // False for a bind frame
+#else
+uint8_t      u8_PayloadFrame[PAYLOAD_MAX_SIZE]; // Packed frame of the transmission in flight
+#endif
 RF24 Radio;
 
 int freeRam () 
 {
   extern int __heap_start, *__brkval; 
   int v; 
-  return (int) &v - (__brkval == 0 ? (int) &__heap_start : (int) __brkval); 
+  return (int)(uintptr_t) &v - (__brkval == 0 ? (int)(uintptr_t) &__heap_start : (int)(uintptr_t) __brkval); 
 }
 
 
@@ -74,7 +128,10 @@ boolean b_initRadio(RF24* pRadio)
   {
     // Radio.setAutoAck(false); // Making sure auto ack isn't ON to ensure we can properly calcualte timeouts
     pRadio->setPALevel(RF24_PA_LOW);
-    pRadio->setPayloadSize(sizeof(RFPayload));
+    pRadio->setChannel(RF_CHANNEL);
+    pRadio->enableDynamicPayloads(); // Packed frames vary in size, only the bytes actually used go on air
+    pRadio->setAddressWidth(RF_ADDRESS_SIZE); // The library default (5) would read past RF_Address
+    pRadio->setRetries(RF_RETRY_DELAY, RF_RETRY_COUNT);
     pRadio->openWritingPipe(RF_Address); 
     pRadio->stopListening(); // Turn on TX Mode
   }
@@ -91,53 +148,89 @@ boolean b_initRadio(RF24* pRadio)
 
 void v_computeButtonVoltageDividers(UiM_t_Inputs* pButtons)
 {
-  int i_Analog_Read = analogRead(BUTTON_ANALOG_PIN);
+  uint16_t u16_AnalogRead = (uint16_t)analogRead(BUTTON_ANALOG_PIN);
   // Reset buttons by default
-  pButtons->inputButtonLeft    = LOW; 
-  pButtons->inputButtonRight   = LOW; 
-  pButtons->inputButtonSelect  = LOW; 
+  pButtons->buttons = 0u; 
 
 
-  if(i_Analog_Read < ANALOG_BUTTON_VDIV_THRESHOLD_B1)
+  if(u16_AnalogRead < ANALOG_BUTTON_VDIV_THRESHOLD_B1)
   {
-    pButtons->inputButtonRight = HIGH;
+    pButtons->buttons = UIM_BUTTON_MASK(UIM_BUTTON_RIGHT);
   }
-  else if(i_Analog_Read > ANALOG_BUTTON_VDIV_THRESHOLD_B1 && i_Analog_Read < ANALOG_BUTTON_VDIV_THRESHOLD_B2)
+  else if(u16_AnalogRead > ANALOG_BUTTON_VDIV_THRESHOLD_B1 && u16_AnalogRead < ANALOG_BUTTON_VDIV_THRESHOLD_B2)
   {
-    pButtons->inputButtonLeft = HIGH;
+    pButtons->buttons = UIM_BUTTON_MASK(UIM_BUTTON_LEFT);
   }
-  else if(i_Analog_Read > ANALOG_BUTTON_VDIV_THRESHOLD_B2 && i_Analog_Read < ANALOG_BUTTON_VDIV_THRESHOLD_B3)
+  else if(u16_AnalogRead > ANALOG_BUTTON_VDIV_THRESHOLD_B2 && u16_AnalogRead < ANALOG_BUTTON_VDIV_THRESHOLD_B3)
   {
-    pButtons->inputButtonSelect = HIGH;
+    pButtons->buttons = UIM_BUTTON_MASK(UIM_BUTTON_SELECT);
   }
 }
 
+#if BUTTON_EVENTS == ON
+// UiM_Button order. The pin change interrupt watches port D only
+const uint8_t ButtonPins[N_BUTTONS] = {INPUT_BUTTON_LEFT_PIN, INPUT_BUTTON_RIGHT_PIN, INPUT_BUTTON_SELECT_PIN};
+static_assert((INPUT_BUTTON_LEFT_PIN < 8) && (INPUT_BUTTON_RIGHT_PIN < 8) && (INPUT_BUTTON_SELECT_PIN < 8), "Buttons must be on port D (pins 0 - 7)");
+#else
 void v_readButtons(UiM_t_Inputs* pInputs)
 {
-  pInputs->inputButtonLeft   = !digitalRead(INPUT_BUTTON_LEFT_PIN);
-  pInputs->inputButtonRight  = !digitalRead(INPUT_BUTTON_RIGHT_PIN);
-  pInputs->inputButtonSelect = !digitalRead(INPUT_BUTTON_SELECT_PIN);
+  pInputs->buttons = (digitalRead(INPUT_BUTTON_LEFT_PIN)   ? 0u : UIM_BUTTON_MASK(UIM_BUTTON_LEFT))  |
+                     (digitalRead(INPUT_BUTTON_RIGHT_PIN)  ? 0u : UIM_BUTTON_MASK(UIM_BUTTON_RIGHT)) |
+                     (digitalRead(INPUT_BUTTON_SELECT_PIN) ? 0u : UIM_BUTTON_MASK(UIM_BUTTON_SELECT));
 }
+#endif
 
 
 
+#if ADC_SAMPLER == ON
+// The analog channels come first in RemoteInputs, they are sampled in that order
+void v_initAdcSampler(const RemoteChannelInput_t* pRemoteChannelInput)
+{
+  uint8_t u8_Pins[N_ANALOG_CHANNELS];
+  uint8_t i;
+  for(i = 0; i < N_ANALOG_CHANNELS; i++)
+  {
+    u8_Pins[i] = pRemoteChannelInput[i].u8_Pin;
+  }
+  v_Adc_init(u8_Pins, N_ANALOG_CHANNELS);
+}
+#endif
+
 void v_readChannelInputs(RemoteChannelInput_t *const pRemoteChannelInput)
+{
+#if CHANNEL_PIPELINE == ON
+  if(b_ChannelPipelineActive)
+  {
+    ChannelPipeline_t::v_read(pRemoteChannelInput);
+    return;
+  }
+#endif
+  v_readChannelInputsGeneric(pRemoteChannelInput);
+}
+
+/* Generic version, any channel layout. Used when the pipeline is off or doesn't match RemoteInputs */
+void v_readChannelInputsGeneric(RemoteChannelInput_t *const pRemoteChannelInput)
 {
   uint8_t i;
+#if ADC_SAMPLER == ON
+  uint16_t u16_AdcResults[N_ANALOG_CHANNELS];
+  u8_Adc_getResults(u16_AdcResults); // Never waits for a conversion
+#endif
+
   for(i = 0; i < N_CHANNELS; i++)
   {
     if(pRemoteChannelInput[i].b_Analog)
     {
-      pRemoteChannelInput[i].u16_Value = (uint16_t)analogRead(pRemoteChannelInput[i].u8_Pin);
-      v_smoothAnalogEMA(&pRemoteChannelInput[i], i); // For now, raw value is also smoothend
-      pRemoteChannelInput[i].u16_RawValue = pRemoteChannelInput[i].u16_Value; // Save raw value before any processing 
-      if(pRemoteChannelInput[i].b_expControl)
-      {
-        v_applyExponential(&pRemoteChannelInput[i].u16_Value);
-      }
-      v_invertInput(&pRemoteChannelInput[i]); // Invertion of analog channels msut be processed before trimming and endpoint
-      v_processTrimming(&pRemoteChannelInput[i]); // Trimming is processed before adjustment to ensure trim offset doesn't overload the min-max values
-      v_processEndpointAdjustment(&pRemoteChannelInput[i]);
+#if ADC_SAMPLER == ON
+      pRemoteChannelInput[i].u16_Value = u16_Flt_apply(i, u16_Adc_toAnalog(u16_AdcResults[i]));
+#else
+      pRemoteChannelInput[i].u16_Value = u16_Flt_apply(i, (uint16_t)analogRead(pRemoteChannelInput[i].u8_Pin));
+#endif
+#if FIXED_POINT_PROCESSING == ON
+      v_processAnalogChannelFixed(&pRemoteChannelInput[i], i);
+#else
+      v_processAnalogChannelFloat(&pRemoteChannelInput[i]);
+#endif
     }
     else
     {
@@ -148,6 +241,34 @@ void v_readChannelInputs(RemoteChannelInput_t *const pRemoteChannelInput)
   }
 }
 
+/* Analog processing chains. Both start from the filtered sample (ChannelFilter), which is also kept as the raw value */
+
+/* Original soft-float version. Kept as a reference for the fixed point chain and for the benchmark */
+void v_processAnalogChannelFloat(RemoteChannelInput_t* pInput)
+{
+  pInput->u16_RawValue = pInput->u16_Value; // Save raw value before any processing 
+  if(pInput->b_expControl)
+  {
+    v_applyExponential(pInput);
+  }
+  v_invertInput(pInput); // Invertion of analog channels msut be processed before trimming and endpoint
+  v_processTrimming(pInput); // Trimming is processed before adjustment to ensure trim offset doesn't overload the min-max values
+  v_processEndpointAdjustment(pInput);
+}
+
+/* Analog processing chain using only integer math. The expo/rate curve comes from the flash table or is evaluated for a non default curve (ChannelCurve.h), output stays within ~1 LSB of v_processAnalogChannelFloat */
+void v_processAnalogChannelFixed(RemoteChannelInput_t* pInput, uint8_t channelIdx)
+{
+  pInput->u16_RawValue = pInput->u16_Value;
+  if(pInput->b_expControl)
+  {
+    pInput->u16_Value = u16_Crv_apply(channelIdx, pInput->u16_Value); // Expo/rate curve of the channel, see ChannelCurve.h
+  }
+  v_invertInput(pInput);
+  v_processTrimming(pInput);
+  v_processEndpointAdjustment(pInput);
+}
+
 /* Processes endpoint adjustment and overrides provided value if value is outside current configured endpoints */
 void v_processEndpointAdjustment(RemoteChannelInput_t* pInput)
 {
@@ -158,15 +279,17 @@ void v_processEndpointAdjustment(RemoteChannelInput_t* pInput)
 /* Process trimming and add the current trim offset to the actual value.*/
 void v_processTrimming(RemoteChannelInput_t* pInput)
 {
-  uint8_t u8_trimOffset = (pInput->u16_Trim - ANALOG_HALF_VALUE);
-  pInput->u16_Value += u8_trimOffset;
+  // Offset is signed. Negative results are floored at 0 so the endpoint adjustment doesn't see a wrapped around value
+  int16_t i16_trimOffset = (int16_t)pInput->u16_Trim - ANALOG_HALF_VALUE;
+  int16_t i16_trimmedValue = (int16_t)pInput->u16_Value + i16_trimOffset;
+  pInput->u16_Value = (i16_trimmedValue < 0) ? 0u : (uint16_t)i16_trimmedValue;
 }
 
 void v_invertInput(RemoteChannelInput_t* pInput)
 {
   if(pInput->b_InvertInput)
   {
-    pInput->u16_Value = map(pInput->u16_Value, ANALOG_MIN_VALUE, ANALOG_MAX_VALUE, ANALOG_MAX_VALUE, ANALOG_MIN_VALUE);
+    pInput->u16_Value = ANALOG_MAX_VALUE - pInput->u16_Value; // Same as map(value, MIN, MAX, MAX, MIN), without the 32bit division
   }
 }
 
@@ -180,35 +303,24 @@ void v_toRaw(float normalizedInput, uint16_t* rawOutput)
   *rawOutput = (normalizedInput + 1.0) * ANALOG_HALF_VALUE;
 }
 
-void v_applyExponential(uint16_t* rawInput) // TODO: have this take the remotechannelinput just like every other processing function
+void v_applyExponential(RemoteChannelInput_t* pInput)
 {
   float normalizedValue;
-  v_normalizeInput(*rawInput, &normalizedValue);
-  normalizedValue = normalizedValue * abs(normalizedValue) * (EXPONENTIAL_VALUE * (1.0 - abs(normalizedValue)) + abs(normalizedValue));
-  v_toRaw(normalizedValue, rawInput);
+  float expo = pInput->u8_Expo / 100.0;
+  v_normalizeInput(pInput->u16_Value, &normalizedValue);
+  normalizedValue = normalizedValue * abs(normalizedValue) * (expo * (1.0 - abs(normalizedValue)) + abs(normalizedValue)) * (pInput->u8_Rate / 100.0);
+  v_toRaw(normalizedValue, &pInput->u16_Value);
 } 
 
-void v_smoothAnalogEMA(RemoteChannelInput_t* pInput, uint8_t channelIdx)
-{
-  static uint16_t average[N_CHANNELS];
-  average[channelIdx] = EMA_ALPHA_VALUE * pInput->u16_Value + (1 - EMA_ALPHA_VALUE) * average[channelIdx]; // Still unsure if this is an improvement, but looks better with not much delay.
-  pInput->u16_Value = average[channelIdx];
-}
-
 void v_buildPayload(const RemoteChannelInput_t* pRemoteChannelInput, RFPayload* pPayload)
 {
-  uint8_t i;
-  for(i = 0; i < N_CHANNELS; i++)
-  {
-    pPayload->u16_Channels[i] = pRemoteChannelInput[i].u16_Value;
-  }
-
+  v_Mix_apply(pRemoteChannelInput, pPayload->u16_Channels);
 }
 
 #if DEBUG == ON
 void printPayload(RFPayload* pl)
 {
-  uint8_t i;
+  // uint8_t i;
   // for(i = 0; i < N_CHANNELS; i++)
   // {
   //   Serial.println(pl->u16_Channels[i]);
@@ -219,18 +331,60 @@ void printPayload(RFPayload* pl)
 #endif
 
 
-boolean b_sendPayload(RF24* pRadio, RFPayload* pPayload, unsigned long* lTransmissionTime)
+// Packs and sends <pPayload>. Must only be called while the radio is idle: every packed frame is expected to go on air,
+// the encoder picks the next frame kind from the acknowledge of the previous one
+boolean b_sendPayload(RFPayload* pPayload)
 {
+  uint8_t u8_FrameSize;
 
 #if DEBUG == ON
   printPayload(pPayload);
 #endif
-  // Time measure
-  unsigned long lStartTimer = micros(); 
-  boolean bPackageAcknowledged = pRadio->write(pPayload, sizeof(RFPayload));             
-  unsigned long lEndTimer = micros();
-  *lTransmissionTime = (lEndTimer - lStartTimer); // Total time to tx or timeout(configured internaly in rf24 as 60-70ms) if never acknowledged 
-  return  bPackageAcknowledged; 
+#if FREQUENCY_HOPPING == ON
+  b_ChannelFrameInFlight = (e_Hop_getState() == HOP_HOPPING);
+  if(!b_ChannelFrameInFlight)
+  {
+    u8_FrameSize = u8_Hop_buildBindFrame(u8_PayloadFrame); // Until the receiver has the hop sequence
+#if RATE_CONTROL == ON
+    v_Rct_fallBack();
+#endif
+    return b_Rad_startTransmission(u8_PayloadFrame, u8_FrameSize);
+  }
+  v_Hop_selectChannel(payloadEncoder.u8_Sequence);
+#endif
+  u8_FrameSize = u8_Pld_encode(&payloadEncoder, pPayload->u16_Channels, u8_PayloadFrame);
+#if RATE_CONTROL == ON
+  u8_FrameSize = u8_Rct_prepareFrame(u8_PayloadFrame, u8_FrameSize); // Data rate and PA level of this frame, maybe a new setting for the receiver
+#endif
+  return b_Rad_startTransmission(u8_PayloadFrame, u8_FrameSize); // Never waits for the ACK, see v_onTransmissionComplete
+}
+
+// Outcome of a transmission started by b_sendPayload, reported by the radio link once the chip got the ACK or gave up retrying
+void v_onTransmissionComplete(const RadTxResult_t* pResult)
+{
+  PldTelemetry_t telemetry;
+
+  RemoteCommunicationState.l_TransmissionTime = pResult->l_TransmissionTime; // Time to ACK, or until the retries ran out
+  RemoteCommunicationState.b_ConnectionLost   = b_transmissionTimeout(pResult->b_Acknowledged);
+  v_Lnk_recordTransmission(&RemoteCommunicationState, pResult->b_Acknowledged, pResult->u8_Retries, pResult->l_TransmissionTime);
+#if FREQUENCY_HOPPING == ON
+  v_Hop_recordTransmission(pResult->b_Acknowledged);
+  if(b_ChannelFrameInFlight) // The ACK of a bind frame says nothing about the channel encoder or the link settings
+#endif
+  {
+    if(pResult->b_Acknowledged)
+    {
+      v_Pld_acknowledge(&payloadEncoder);
+    }
+#if RATE_CONTROL == ON
+    v_Rct_recordTransmission(pResult->b_Acknowledged, pResult->u8_Retries);
+#endif
+  }
+  if(b_Pld_decodeTelemetry(pResult->u8_AckPayload, pResult->u8_AckPayloadSize, &telemetry))
+  {
+    v_Lnk_recordTelemetry(&RemoteCommunicationState, &telemetry);
+  }
+  DIAG_RECORD_TRANSMISSION(pResult->b_Acknowledged);
 }
 
 boolean b_transmissionTimeout(boolean bPackageAcknowledged)
@@ -254,33 +408,350 @@ boolean b_transmissionTimeout(boolean bPackageAcknowledged)
 }
 
 
+#if PROCESSING_BENCHMARK == ON
+/* Runs both analog processing chains over every possible ADC value and reports the average cost of each in CPU cycles,
+   measured with Timer1 running at the CPU clock, together with the maximum output difference between them. */
+void v_runProcessingBenchmark()
+{
+  RemoteChannelInput_t floatChannel;
+  RemoteChannelInput_t fixedChannel;
+  uint32_t u32_floatCycles = 0;
+  uint32_t u32_fixedCycles = 0;
+  uint16_t u16_maxDifference = 0;
+  uint16_t u16_overhead;
+  uint16_t u16_start;
+  uint16_t u16_elapsed;
+  uint16_t i;
+
+  TCCR1A = 0;
+  TCCR1B = (1 << CS10); // Timer1 free running, no prescaler. One tick per CPU cycle
+  u16_start = TCNT1;
+  u16_overhead = TCNT1 - u16_start;
+
+  for(i = ANALOG_MIN_VALUE; i <= ANALOG_MAX_VALUE; i++)
+  {
+    floatChannel = RemoteInputs[JOYSTICK_RIGHT_AXIS_X_CHANNEL_IDX]; // Inverted and with reduced endpoints, so every stage is exercised
+    floatChannel.u16_Value = i;
+    fixedChannel = floatChannel;
+
+    u16_start = TCNT1;
+    v_processAnalogChannelFloat(&floatChannel);
+    u16_elapsed = TCNT1 - u16_start;
+    u32_floatCycles += (u16_elapsed > u16_overhead) ? (u16_elapsed - u16_overhead) : 0u;
+
+    u16_start = TCNT1;
+    v_processAnalogChannelFixed(&fixedChannel, JOYSTICK_RIGHT_AXIS_X_CHANNEL_IDX);
+    u16_elapsed = TCNT1 - u16_start;
+    u32_fixedCycles += (u16_elapsed > u16_overhead) ? (u16_elapsed - u16_overhead) : 0u;
+
+    uint16_t u16_difference = abs((int16_t)floatChannel.u16_Value - (int16_t)fixedChannel.u16_Value);
+    u16_maxDifference = max(u16_maxDifference, u16_difference);
+  }
+
+  Serial.print(F("Float cycles/sample: "));
+  Serial.println(u32_floatCycles / (ANALOG_MAX_VALUE + 1));
+  Serial.print(F("Fixed cycles/sample: "));
+  Serial.println(u32_fixedCycles / (ANALOG_MAX_VALUE + 1));
+  Serial.print(F("Max difference (LSB): "));
+  Serial.println(u16_maxDifference);
+}
+#endif
+
+#if (DISPLAY_BENCHMARK == ON) && (DISPLAY_ASYNC_I2C == ON)
+#define DISPLAY_BENCHMARK_FRAMES 8u
+#define DISPLAY_BENCHMARK_GAP_US 1000u // Rest of the loop between two draw calls
+/* Reports the mean time spent in v_UiC_draw for a full frame of the active page, blocking vs interrupt driven display
+   transport. Draw calls are spaced by DISPLAY_BENCHMARK_GAP_US of other work, the time an asynchronous transfer has
+   to go out on its own. */
+uint32_t u32_measureFrameTime(bool b_blocking)
+{
+  uint32_t u32_total = 0;
+  uint32_t u32_frameTime;
+  uint8_t  i;
+
+  v_Twi_setBlocking(b_blocking);
+  for(i = 0; i < DISPLAY_BENCHMARK_FRAMES; i++)
+  {
+    v_UiC_redraw();
+    do
+    {
+      v_UiC_draw();
+      delayMicroseconds(DISPLAY_BENCHMARK_GAP_US);
+    } while(b_UiC_isFrameInProgress());
+    if(b_UiC_takeFrameTime(&u32_frameTime))
+    {
+      u32_total += u32_frameTime;
+    }
+    v_Twi_flush(); // Every frame starts with an idle bus
+  }
+  v_Twi_setBlocking(false);
+  return u32_total / DISPLAY_BENCHMARK_FRAMES;
+}
+
+void v_runDisplayBenchmark()
+{
+  Serial.print(F("I2C clock (Hz): "));
+  Serial.println(DISPLAY_I2C_CLOCK_HZ);
+  Serial.print(F("Blocking frame (us): "));
+  Serial.println(u32_measureFrameTime(true));
+  Serial.print(F("Async frame (us): "));
+  Serial.println(u32_measureFrameTime(false));
+}
+#endif
+
+#if MIXER_BENCHMARK == ON
+/* Reports the cost in CPU cycles of mixing a frame, measured with Timer1 running at the CPU clock, for a half and a full
+   mix table. The rules are an elevon, a V-tail, a differential and a throttle curve, repeated. The configured table is
+   compiled again afterwards. */
+void v_runMixerBenchmark()
+{
+  MixConfig_t benchmarkMixes;
+  uint16_t    outputs[N_CHANNELS];
+  uint16_t    u16_overhead;
+  uint16_t    u16_start;
+  uint16_t    u16_elapsed;
+  uint8_t     nRules;
+  uint8_t     i;
+
+  static const MixRule_t benchmarkRules[8] =
+      // Source,                          Destination,                       Weight, Offset, Curve
+      {{JOYSTICK_RIGHT_AXIS_X_CHANNEL_IDX, JOYSTICK_RIGHT_AXIS_X_CHANNEL_IDX,  50,     0,      MIX_CURVE_LINEAR},   // Elevon
+       {JOYSTICK_RIGHT_AXIS_Y_CHANNEL_IDX, JOYSTICK_RIGHT_AXIS_X_CHANNEL_IDX,  50,     0,      MIX_CURVE_LINEAR},
+       {JOYSTICK_RIGHT_AXIS_X_CHANNEL_IDX, JOYSTICK_RIGHT_AXIS_Y_CHANNEL_IDX, -50,     0,      MIX_CURVE_LINEAR},
+       {JOYSTICK_RIGHT_AXIS_Y_CHANNEL_IDX, JOYSTICK_RIGHT_AXIS_Y_CHANNEL_IDX,  50,     0,      MIX_CURVE_LINEAR},
+       {JOYSTICK_LEFT_AXIS_X_CHANNEL_IDX,  POT_LEFT_CHANNEL_IDX,               50,     0,      MIX_CURVE_LINEAR},   // V-tail
+       {JOYSTICK_LEFT_AXIS_X_CHANNEL_IDX,  POT_RIGHT_CHANNEL_IDX,             -50,     0,      MIX_CURVE_LINEAR},
+       {JOYSTICK_LEFT_AXIS_Y_CHANNEL_IDX,  JOYSTICK_LEFT_AXIS_Y_CHANNEL_IDX,   100,    0,      MIX_CURVE_TABLE},    // Throttle curve
+       {POT_LEFT_CHANNEL_IDX,              JOYSTICK_LEFT_AXIS_X_CHANNEL_IDX,   60,     0,      MIX_CURVE_POSITIVE}}; // Differential
+
+  TCCR1A = 0;
+  TCCR1B = (1 << CS10); // Timer1 free running, no prescaler. One tick per CPU cycle
+  u16_start = TCNT1;
+  u16_overhead = TCNT1 - u16_start;
+
+  for(nRules = 8u; nRules <= MIX_MAX_RULES; nRules += 8u)
+  {
+    v_Mix_initConfig(&benchmarkMixes);
+    for(i = 0; i < nRules; i++)
+    {
+      benchmarkMixes.rules[i] = benchmarkRules[i % 8u];
+    }
+    v_Mix_compile(&benchmarkMixes);
+
+    u16_start = TCNT1;
+    v_Mix_apply(RemoteInputs, outputs);
+    u16_elapsed = TCNT1 - u16_start;
+
+    Serial.print(nRules);
+    Serial.print(F(" rules, mix cycles/frame: "));
+    Serial.println((u16_elapsed > u16_overhead) ? (u16_elapsed - u16_overhead) : 0u);
+  }
+  v_Mix_compile(&MixConfig);
+}
+#endif
+
+#if (PIPELINE_BENCHMARK == ON) && (CHANNEL_PIPELINE == ON)
+#define PIPELINE_BENCHMARK_ROUNDS 32u
+/* Reports the average cost in CPU cycles of reading and processing every channel, generic loop vs compile time pipeline,
+   measured with Timer1 running at the CPU clock, together with the maximum output difference between them. Both restart
+   the filters, so both see the same first samples. */
+void v_runPipelineBenchmark()
+{
+  RemoteChannelInput_t genericChannels[N_CHANNELS];
+  RemoteChannelInput_t pipelineChannels[N_CHANNELS];
+  uint32_t u32_genericCycles = 0;
+  uint32_t u32_pipelineCycles = 0;
+  uint16_t u16_maxDifference = 0;
+  uint16_t u16_overhead;
+  uint16_t u16_start;
+  uint16_t u16_elapsed;
+  uint8_t  i;
+
+  TCCR1A = 0;
+  TCCR1B = (1 << CS10); // Timer1 free running, no prescaler. One tick per CPU cycle
+  u16_start = TCNT1;
+  u16_overhead = TCNT1 - u16_start;
+
+  memcpy(genericChannels,  RemoteInputs, sizeof(genericChannels));
+  memcpy(pipelineChannels, RemoteInputs, sizeof(pipelineChannels));
+  v_Flt_init(ChannelFilters);
+  for(i = 0; i < PIPELINE_BENCHMARK_ROUNDS; i++)
+  {
+    u16_start = TCNT1;
+    v_readChannelInputsGeneric(genericChannels);
+    u16_elapsed = TCNT1 - u16_start;
+    u32_genericCycles += (u16_elapsed > u16_overhead) ? (u16_elapsed - u16_overhead) : 0u;
+  }
+  v_Flt_init(ChannelFilters);
+  for(i = 0; i < PIPELINE_BENCHMARK_ROUNDS; i++)
+  {
+    u16_start = TCNT1;
+    ChannelPipeline_t::v_read(pipelineChannels);
+    u16_elapsed = TCNT1 - u16_start;
+    u32_pipelineCycles += (u16_elapsed > u16_overhead) ? (u16_elapsed - u16_overhead) : 0u;
+  }
+  v_Flt_init(ChannelFilters);
+
+  for(i = 0; i < N_CHANNELS; i++) // Only the ADC noise between the two runs should show here
+  {
+    uint16_t u16_difference = abs((int16_t)genericChannels[i].u16_Value - (int16_t)pipelineChannels[i].u16_Value);
+    u16_maxDifference = max(u16_maxDifference, u16_difference);
+  }
+
+  Serial.print(F("Generic cycles/read: "));
+  Serial.println(u32_genericCycles / PIPELINE_BENCHMARK_ROUNDS);
+  Serial.print(F("Pipeline cycles/read: "));
+  Serial.println(u32_pipelineCycles / PIPELINE_BENCHMARK_ROUNDS);
+  Serial.print(F("Max difference (LSB): "));
+  Serial.println(u16_maxDifference);
+}
+#endif
+
+
+#if TASK_SCHEDULER == ON
+// Task table, in ticks of SCHEDULER_TICK_US. Deadlines equal the periods. Radio polling is a few uSeconds and keeps the
+// measured transmission time accurate. Sampling comes before TX so TX always sends fresh inputs, and TX always runs
+// before any pending UI slice.
+#define SCH_TICKS_FROM_HZ(hz) ((1000000ul / SCHEDULER_TICK_US) / (hz))
+const SchTask_t SchedulerTasks[] = 
+                // Task,               Period,                                Deadline,                              Priority
+                {{b_taskRadioPoll,     SCH_TICKS_FROM_HZ(RADIO_POLL_RATE_HZ), SCH_TICKS_FROM_HZ(RADIO_POLL_RATE_HZ), 0u},
+                 {b_taskSampleInputs,  SCH_TICKS_FROM_HZ(SAMPLE_RATE_HZ),     SCH_TICKS_FROM_HZ(SAMPLE_RATE_HZ),     1u},
+                 {b_taskTransmit,      SCH_TICKS_FROM_HZ(TX_RATE_HZ),         SCH_TICKS_FROM_HZ(TX_RATE_HZ),         2u},
+                 {b_taskUi,            SCH_TICKS_FROM_HZ(UI_RATE_HZ),         SCH_TICKS_FROM_HZ(UI_RATE_HZ),         3u}
+#if CONFIGURATION_STORAGE == ON
+                ,{b_taskStorage,       SCH_TICKS_FROM_HZ(STORAGE_RATE_HZ),    SCH_TICKS_FROM_HZ(STORAGE_RATE_HZ),    4u}
+#endif
+                };
+
+#if LOOP_TIMING == ON
+// Overruns of all tasks, shown on the diagnostics page and in the Serial dump
+uint16_t u16_getSchedulerOverruns()
+{
+  uint8_t  i;
+  uint16_t overruns = 0;
+  for(i = 0; i < (sizeof(SchedulerTasks) / sizeof(SchTask_t)); i++)
+  {
+    overruns += u16_Sch_getOverruns(i);
+  }
+  return overruns;
+}
+#endif
+#endif
+
+
 void setup() 
 {
   Serial.begin(115200);
   Serial.print(freeRam()); // TODO: Halt program, use u8x8 instead and display a msg on the screen
   Serial.print(F("Bytes\n"));
+  v_Mix_initConfig(&MixConfig);
+#if CONFIGURATION_STORAGE == ON
+  if(!b_Cfg_load(&ModelConfiguration))
+  {
+    Serial.println(F("No saved configuration"));
+  }
+#endif
+  v_Crv_init(RemoteInputs); // Curves are set up from the loaded expo/rate
+  v_Mix_compile(&MixConfig);
+#if PROCESSING_BENCHMARK == ON
+  v_runProcessingBenchmark();
+#endif
+#if MIXER_BENCHMARK == ON
+  v_runMixerBenchmark();
+#endif
   v_initRemoteInputs(RemoteInputs);
-  boolean b_initRadioSuccess = b_initRadio(&Radio);
+#if BUTTON_EVENTS == ON
+  v_Btn_init(ButtonPins, N_BUTTONS);
+#endif
+  v_Flt_init(ChannelFilters);
+#if ADC_SAMPLER == ON
+  v_initAdcSampler(RemoteInputs);
+#endif
+#if CHANNEL_PIPELINE == ON
+  b_ChannelPipelineActive = ChannelPipeline_t::b_matches(RemoteInputs);
+  if(!b_ChannelPipelineActive)
+  {
+    Serial.println(F("Channel layout mismatch, generic channel reading"));
+  }
+#if PIPELINE_BENCHMARK == ON
+  v_runPipelineBenchmark();
+#endif
+#endif
+  b_initRadio(&Radio); // A failure is reported on Serial
+#if FREQUENCY_HOPPING == ON
+  v_Hop_init(&Radio); // Scan, then binding
+#endif
+#if RATE_CONTROL == ON
+  v_Rct_init(&Radio); // Base settings, same as the receiver at startup
+#endif
+  v_Rad_init(&Radio, v_onTransmissionComplete);
+  v_Lnk_init();
+  v_Pld_initEncoder(&payloadEncoder, PAYLOAD_DELTA_ENCODING == ON);
   // TODO: Display a msg on screen if radio wasn't properly initialized
   
   v_UiM_init(&uiInputData, &uiResponseData);
+#if (DISPLAY_BENCHMARK == ON) && (DISPLAY_ASYNC_I2C == ON)
+  v_runDisplayBenchmark();
+#endif
+#if UI_SRAM_REPORT == ON
+  v_UiM_printMemoryReport(&Serial);
+#endif
+#if LOOP_TIMING == ON
+  v_Diag_init();
+#endif
+#if TASK_SCHEDULER == ON
+  v_Sch_init(SchedulerTasks, sizeof(SchedulerTasks) / sizeof(SchTask_t));
+#endif
 
 }
 
 
-void loop() 
+/* Main loop jobs. They run as scheduler tasks, or back to back in loop() when the scheduler is disabled.
+   Each returns whether its job is finished (see SchTask_t) */
+
+boolean b_taskRadioPoll()
 {
+  v_Rad_poll();
+  return true;
+}
 
+boolean b_taskSampleInputs()
+{
+  DIAG_STAGE_BEGIN(DIAG_STAGE_INPUT_READ);
+#if CONFIGURATION_STORAGE == ON
+  // Model switches land here, between two TX frames: the next frame is entirely processed with the new model
+  if(b_Cfg_applyModelSwitch(&ModelConfiguration))
+  {
+    v_Crv_sync(RemoteInputs);
+    v_Mix_compile(&MixConfig);
+  }
+#endif
   v_readChannelInputs(RemoteInputs);
+  DIAG_STAGE_END(DIAG_STAGE_INPUT_READ);
+  return true;
+}
 
-  if(uiResponseData.analogSendAllowed)
+boolean b_taskTransmit()
+{
+  // A frame still in flight means this slot is skipped, the next one carries newer inputs anyway
+  if(uiResponseData.analogSendAllowed && (e_Rad_getState() == RAD_TX_IDLE))
   {
+    DIAG_STAGE_BEGIN(DIAG_STAGE_PAYLOAD_BUILD);
     v_buildPayload(RemoteInputs, &payload);
-    boolean bSendSuccess = b_sendPayload(&Radio, &payload, &(RemoteCommunicationState.l_TransmissionTime));
-    RemoteCommunicationState.b_ConnectionLost = b_transmissionTimeout(bSendSuccess);
+    DIAG_STAGE_END(DIAG_STAGE_PAYLOAD_BUILD);
+
+    DIAG_STAGE_BEGIN(DIAG_STAGE_RADIO_TX); // Includes packing
+    b_sendPayload(&payload);
+    DIAG_STAGE_END(DIAG_STAGE_RADIO_TX);
     // TODO: Fix bug, oled not showing proper comm value
   }
+  return true;
+}
 
+// Finished once the current display frame is completely drawn. Until then, every run draws the next strip(s)
+boolean b_taskUi()
+{
 #if BATTERY_INDICATION == ON
   bool battery_ready = battery.readBatteryVoltage(); // This is working but can't be seen with the arduino connected to pc. Otherwise will read the 5v instead of 9
   display_wrapper.printBatteryOLED(battery.getBatteryPercentage());
@@ -289,11 +760,70 @@ void loop()
 
   // Process UI inputs
   // v_computeButtonVoltageDividers(&uiInputs);
-  v_readButtons(&uiInputs);
+  DIAG_STAGE_BEGIN(DIAG_STAGE_BUTTONS);
+#if BUTTON_EVENTS == OFF
+  v_readButtons(&uiInputs); // Otherwise UiM takes the queued button events
+#endif
 
   uiInputs.scrollWheelRight = RemoteInputs[POT_RIGHT_CHANNEL_IDX].u16_RawValue; // Aditionally, let's map the scroll wheel here, for now
   uiInputs.scrollWheelLeft  = RemoteInputs[POT_LEFT_CHANNEL_IDX].u16_RawValue; // Aditionally, let's map the scroll wheel here, for now
+  DIAG_STAGE_END(DIAG_STAGE_BUTTONS);
   
+  DIAG_STAGE_BEGIN(DIAG_STAGE_UI_UPDATE);
+#if CONFIGURATION_STORAGE == ON
+  uiInputData.activeModel = u8_Cfg_getActiveModel();
+#endif
   v_UiM_update();
-  // TODO: use the response data to save configurations to eeprom. Later load configurations from eeprom at startup.
+  DIAG_STAGE_END(DIAG_STAGE_UI_UPDATE);
+  if(uiResponseData.configurationUpdated)
+  {
+    v_Crv_sync(RemoteInputs); // Only sets up the curves of channels whose expo or rate actually changed again
+    v_Mix_compile(&MixConfig);
+#if CONFIGURATION_STORAGE == ON
+    v_Cfg_requestSave(); // Deferred, a trim being dragged keeps pushing the save back
+#endif
+    uiResponseData.configurationUpdated = false;
+  }
+#if CONFIGURATION_STORAGE == ON
+  if(uiResponseData.modelChangeRequested)
+  {
+    v_Cfg_selectModel(uiResponseData.requestedModel); // Edits not saved yet go to the current model first
+    uiResponseData.modelChangeRequested = false;
+  }
+#endif
+
+#if LOOP_TIMING == ON
+#if TASK_SCHEDULER == ON
+  v_Diag_recordOverruns(u16_getSchedulerOverruns());
+#endif
+  v_Diag_processSerialRequest();
+#endif
+  return !b_UiC_isFrameInProgress();
+}
+
+#if CONFIGURATION_STORAGE == ON
+// Writes at most one EEPROM byte per run, the EEPROM is then busy for ~3.3ms but the controller isn't
+boolean b_taskStorage()
+{
+  v_Cfg_process(&ModelConfiguration);
+  return true;
+}
+#endif
+
+
+void loop() 
+{
+  DIAG_STAGE_BEGIN(DIAG_STAGE_LOOP);
+#if TASK_SCHEDULER == ON
+  v_Sch_dispatch();
+#else
+  b_taskRadioPoll();
+  b_taskSampleInputs();
+  b_taskTransmit();
+  b_taskUi();
+#if CONFIGURATION_STORAGE == ON
+  b_taskStorage();
+#endif
+#endif
+  DIAG_STAGE_END(DIAG_STAGE_LOOP);
 }
@@ -0,0 +1,111 @@
+/**
+ * @file RadioLink.cpp
+ * @author Marcelo Fraga
+ * @brief Non blocking radio transmission. See RadioLink.h
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "RadioLink.h"
+
+static RF24*           radLinkRadio;
+static RadTxCallback_t radTxCallback;
+static RadTxState      radTxState;
+static unsigned long   radTxStartTime;
+static RadTxResult_t   radTxResult;
+
+
+/** Internal functions **/
+static void v_Rad_completeTransmission(bool acknowledged);
+static void v_Rad_readAckPayload();
+
+
+void v_Rad_init(RF24* pRadio, RadTxCallback_t onTxComplete)
+{
+    radLinkRadio  = pRadio;
+    radTxCallback = onTxComplete;
+    radTxState    = RAD_TX_IDLE;
+    radLinkRadio->enableAckPayload();
+    radLinkRadio->maskIRQ(false, false, true); // Only TX events matter. ACK payloads still set RX_DR, they are read on TX_DS
+}
+
+bool b_Rad_startTransmission(const void* pPayload, uint8_t size)
+{
+    if(radTxState != RAD_TX_IDLE)
+    {
+        return false;
+    }
+    radTxStartTime = micros();
+    radTxState     = RAD_TX_BUSY;
+    radLinkRadio->startWrite(pPayload, size, false); // Loads the TX FIFO and pulses CE, about 10us
+    return true;
+}
+
+void v_Rad_poll()
+{
+    bool txOk;
+    bool txFail;
+    bool rxReady;
+
+    if(radTxState != RAD_TX_BUSY)
+    {
+        return;
+    }
+
+    radLinkRadio->whatHappened(txOk, txFail, rxReady); // Also clears the status flags
+    if(txOk)
+    {
+        radTxResult.u8_AckPayloadSize = 0u;
+        if(rxReady)
+        {
+            v_Rad_readAckPayload();
+        }
+        v_Rad_completeTransmission(true);
+    }
+    else if(txFail || ((micros() - radTxStartTime) > RADIO_TX_GUARD_US))
+    {
+        // After MAX_RT the payload stays in the TX FIFO and the chip won't send anything else until it's flushed
+        radLinkRadio->flush_tx();
+        radTxResult.u8_AckPayloadSize = 0u;
+        v_Rad_completeTransmission(false);
+    }
+}
+
+RadTxState e_Rad_getState()
+{
+    return radTxState;
+}
+
+
+static void v_Rad_completeTransmission(bool acknowledged)
+{
+    radTxState                     = RAD_TX_IDLE;
+    radTxResult.b_Acknowledged     = acknowledged;
+    radTxResult.u8_Retries         = radLinkRadio->getARC(); // Reset by the chip on the next write, must be read now
+    radTxResult.l_TransmissionTime = micros() - radTxStartTime;
+    if(radTxCallback != NULL)
+    {
+        radTxCallback(&radTxResult);
+    }
+}
+
+// Only the last ACK payload matters, older ones still in the RX FIFO are dropped
+static void v_Rad_readAckPayload()
+{
+    while(radLinkRadio->available())
+    {
+        uint8_t size = radLinkRadio->getDynamicPayloadSize();
+        if((size == 0u) || (size > 32u)) // Corrupt length, the datasheet asks for a flush
+        {
+            radLinkRadio->flush_rx();
+            radTxResult.u8_AckPayloadSize = 0u;
+            return;
+        }
+        size = min(size, RAD_ACK_PAYLOAD_MAX_SIZE); // Reading less still pops the whole payload
+        radLinkRadio->read(radTxResult.u8_AckPayload, size);
+        radTxResult.u8_AckPayloadSize = size;
+    }
+}
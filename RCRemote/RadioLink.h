@@ -0,0 +1,53 @@
+/**
+ * @file RadioLink.h
+ * @author Marcelo Fraga
+ * @brief Non blocking radio transmission. A payload is handed to the nRF24 with startWrite() and the transmission
+ * then runs on the chip (auto retransmits included) while the controller keeps going. v_Rad_poll() reads the status
+ * register while a transmission is in flight and reports its outcome (ACK or max retransmits) through a callback.
+ * The IRQ line of the module is not wired (INT0/INT1 are taken by the switches), so completion is detected by polling.
+ * ACK payloads are enabled: whatever the receiver preloaded comes back with the ACK and is handed to the callback.
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef RADIOLINK_H
+#define RADIOLINK_H
+#include "Configuration.h"
+#include <RF24.h>
+
+enum RadTxState
+{
+    RAD_TX_IDLE,
+    RAD_TX_BUSY     // Payload handed to the chip, waiting for TX_DS or MAX_RT
+};
+
+#define RAD_ACK_PAYLOAD_MAX_SIZE 16u // Longer ACK payloads are truncated
+
+typedef struct RadTxResult_t
+{
+    bool          b_Acknowledged;
+    uint8_t       u8_Retries;          // Auto retransmits used (ARC_CNT). Every one of them on a failed transmission
+    unsigned long l_TransmissionTime;  // In uSeconds, from the start to the detection
+    uint8_t       u8_AckPayloadSize;   // 0 when the ACK came without payload
+    uint8_t       u8_AckPayload[RAD_ACK_PAYLOAD_MAX_SIZE];
+}RadTxResult_t;
+
+// Called from v_Rad_poll when a transmission ends
+typedef void (*RadTxCallback_t)(const RadTxResult_t* pResult);
+
+
+/// @brief Takes over <pRadio>, which must be initialized and in TX mode. <onTxComplete> is called for every finished transmission.
+void v_Rad_init(RF24* pRadio, RadTxCallback_t onTxComplete);
+
+/// @brief Starts sending <size> bytes of <pPayload>. Returns false (nothing sent) while a previous transmission is still in flight.
+bool b_Rad_startTransmission(const void* pPayload, uint8_t size);
+
+/// @brief Checks the outcome of the transmission in flight, if any. Returns immediately when idle.
+void v_Rad_poll();
+
+RadTxState e_Rad_getState();
+
+#endif
@@ -0,0 +1,224 @@
+/**
+ * @file RateControl.cpp
+ * @author Marcelo Fraga
+ * @brief Closed loop data rate and PA level control. See RateControl.h
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "RateControl.h"
+
+#if RATE_CONTROL == ON
+
+#define RCT_MAX_BACKOFF     3u // Up to RF_RATE_UP_WINDOWS << 3 good windows before trying a step up again
+#define RCT_WINDOW_MAX_LOST ((uint8_t)((RF_RATE_LOSS_TARGET * RF_RATE_WINDOW) / 100u)) // More, the window is decided
+#define RCT_TRY_PERIOD      3u // Once a frame with the trailer failed, one frame in 3 goes on the new step. Odd, so that
+                               // with a power of 2 hop channels both steps come by the channel the receiver waits on
+
+typedef struct RctStep_t
+{
+    uint8_t dataRate; // rf24_datarate_e
+    uint8_t paLevel;  // rf24_pa_dbm_e
+}RctStep_t;
+
+// Link budget (PA output - receiver sensitivity) goes down one step at a time, air time and power never go up.
+// 250kbps gains 9dB of sensitivity over 1Mbps for 3 times the air time. 2Mbps loses 3dB and halves it
+static constexpr RctStep_t rateLadder[] PROGMEM =
+{
+    {RF24_250KBPS, RF24_PA_MAX},  // 0dBm,   -94dBm: 94dB
+    {RF24_1MBPS,   RF24_PA_MAX},  // 0dBm,   -85dBm: 85dB
+    {RF24_2MBPS,   RF24_PA_MAX},  // 0dBm,   -82dBm: 82dB
+    {RF24_2MBPS,   RF24_PA_HIGH}, // -6dBm:  76dB
+    {RF24_2MBPS,   RF24_PA_LOW},  // -12dBm: 70dB
+    {RF24_2MBPS,   RF24_PA_MIN}   // -18dBm: 64dB
+};
+#define RCT_N_STEPS ((uint8_t)(sizeof(rateLadder) / sizeof(rateLadder[0])))
+
+static_assert((rateLadder[0].dataRate == RF_RATE_BASE_DATA_RATE) && (rateLadder[0].paLevel == RF_RATE_BASE_PA_LEVEL), "The ladder starts at the base settings");
+static_assert((RF_RATE_WINDOW > 0u) && (RF_RATE_WINDOW <= 0xFFu), "Window counts are 8 bit");
+static_assert(RF_RATE_UP_RETRIES_X10 < RF_RATE_DOWN_RETRIES_X10, "No hysteresis between the retry thresholds");
+
+static RF24*    rctRadio;
+static uint8_t  rctStep;          // Step both sides are on
+static uint8_t  rctTargetStep;    // Differs from rctStep while a change is being agreed
+static uint8_t  rctRadioStep;     // Step last written to the radio
+static bool     rctTrailerSent;   // The frame in flight carries the trailer
+static uint8_t  rctTrailerFailed; // Frames with the trailer failed: the receiver may be on either step
+static uint8_t  rctFrames;        // Current window
+static uint8_t  rctFailed;
+static uint16_t rctRetries;
+static uint8_t  rctGoodWindows;
+static uint8_t  rctWindowsSinceUp; // Windows since the last step up, a step back within RF_RATE_UP_WINDOWS failed it
+static uint8_t  rctBackoff;
+static unsigned long rctLastAckTime; // millis()
+static uint16_t rctChanges;
+
+
+/** Internal functions **/
+// Writes <step> to the radio: read-modify-writes of RF_SETUP over SPI
+static void v_Rct_applyStep(uint8_t step);
+// Both sides are now on <step>
+static void v_Rct_commit(uint8_t step);
+static void v_Rct_evaluateWindow();
+
+
+void v_Rct_init(RF24* pRadio)
+{
+    rctRadio          = pRadio;
+    rctStep           = 0u;
+    rctBackoff        = 0u;
+    rctChanges        = 0u;
+    rctWindowsSinceUp = 0xFFu;
+    v_Rct_commit(0u);
+}
+
+uint8_t u8_Rct_prepareFrame(uint8_t* pBuffer, uint8_t size)
+{
+    uint8_t step = ((rctTrailerFailed % RCT_TRY_PERIOD) == (RCT_TRY_PERIOD - 1u)) ? rctTargetStep : rctStep;
+
+    rctTrailerSent = (rctTargetStep != rctStep);
+    if(step != rctRadioStep) // Only while a change is being agreed, the radio is left alone otherwise
+    {
+        v_Rct_applyStep(step);
+    }
+    if(!rctTrailerSent)
+    {
+        return size;
+    }
+    return u8_Pld_appendLinkSetting(pBuffer, size, RCT_SETTING(pgm_read_byte(&rateLadder[rctTargetStep].dataRate), pgm_read_byte(&rateLadder[rctTargetStep].paLevel)));
+}
+
+void v_Rct_recordTransmission(bool acknowledged, uint8_t retries)
+{
+    if(rctTrailerSent)
+    {
+        if(acknowledged)
+        {
+            v_Rct_commit(rctTargetStep); // Whichever step it went on, the receiver has the new one
+            return;
+        }
+        rctTrailerFailed++;
+    }
+
+    if(acknowledged)
+    {
+        rctLastAckTime = millis();
+    }
+    else if((millis() - rctLastAckTime) > RF_RATE_FALLBACK_MS) // Time, not frames: both sides give up together
+    {
+        v_Rct_commit(0u); // The receiver does the same once it heard nothing for RF_RECEIVER_LINK_LOST_MS
+        return;
+    }
+
+    rctFrames++;
+    rctFailed  += acknowledged ? 0u : 1u;
+    rctRetries += retries;
+    if((rctFrames >= RF_RATE_WINDOW) || (rctFailed > RCT_WINDOW_MAX_LOST))
+    {
+        v_Rct_evaluateWindow();
+    }
+}
+
+void v_Rct_fallBack()
+{
+    if((rctStep != 0u) || (rctTargetStep != 0u))
+    {
+        v_Rct_commit(0u);
+    }
+}
+
+uint8_t u8_Rct_getSetting()
+{
+    return RCT_SETTING(pgm_read_byte(&rateLadder[rctStep].dataRate), pgm_read_byte(&rateLadder[rctStep].paLevel));
+}
+
+uint16_t u16_Rct_getChanges()
+{
+    return rctChanges;
+}
+
+
+static void v_Rct_applyStep(uint8_t step)
+{
+    rctRadio->setDataRate((rf24_datarate_e)pgm_read_byte(&rateLadder[step].dataRate));
+    rctRadio->setPALevel(pgm_read_byte(&rateLadder[step].paLevel));
+    rctRadioStep = step;
+}
+
+static void v_Rct_commit(uint8_t step)
+{
+    if(step > rctStep)
+    {
+        rctWindowsSinceUp = 0u;
+    }
+    else if(step < rctStep)
+    {
+        if(rctWindowsSinceUp < RF_RATE_UP_WINDOWS) // The last step up didn't hold
+        {
+            rctBackoff = min((uint8_t)(rctBackoff + 1u), (uint8_t)RCT_MAX_BACKOFF);
+        }
+        rctWindowsSinceUp = 0xFFu;
+    }
+    if(step != rctStep)
+    {
+        rctChanges++;
+    }
+    rctStep          = step;
+    rctTargetStep    = step;
+    rctTrailerFailed = 0u;
+    rctTrailerSent   = false;
+    rctLastAckTime   = millis();
+    rctFrames        = 0u;
+    rctFailed        = 0u;
+    rctRetries       = 0u;
+    rctGoodWindows   = 0u;
+    v_Rct_applyStep(step);
+}
+
+static void v_Rct_evaluateWindow()
+{
+    uint8_t lossPercent = (uint8_t)(((uint16_t)rctFailed * 100u) / rctFrames);
+    uint8_t retriesX10  = (uint8_t)min((rctRetries * 10u) / rctFrames, 0xFFu);
+
+    rctFrames  = 0u;
+    rctFailed  = 0u;
+    rctRetries = 0u;
+    if(rctTargetStep != rctStep) // Still being agreed
+    {
+        return;
+    }
+    if(rctWindowsSinceUp < 0xFFu)
+    {
+        rctWindowsSinceUp++;
+    }
+
+    if((lossPercent > RF_RATE_LOSS_TARGET) || (retriesX10 > RF_RATE_DOWN_RETRIES_X10))
+    {
+        rctGoodWindows = 0u;
+        if(rctStep > 0u)
+        {
+            rctTargetStep = rctStep - 1u;
+        }
+    }
+    else if(((lossPercent * 2u) <= RF_RATE_LOSS_TARGET) && (retriesX10 <= RF_RATE_UP_RETRIES_X10))
+    {
+        if(rctWindowsSinceUp == RF_RATE_UP_WINDOWS) // The last step up held
+        {
+            rctBackoff = 0u;
+        }
+        if((++rctGoodWindows >= (RF_RATE_UP_WINDOWS << rctBackoff)) && (rctStep < (RCT_N_STEPS - 1u)))
+        {
+            rctGoodWindows = 0u;
+            rctTargetStep  = rctStep + 1u;
+        }
+    }
+    else
+    {
+        rctGoodWindows = 0u; // In between, stay
+    }
+}
+
+#endif
@@ -0,0 +1,53 @@
+/**
+ * @file RateControl.h
+ * @author Marcelo Fraga
+ * @brief Closed loop data rate and PA level control. The settings are steps of a ladder, from the most robust one
+ * (RF_RATE_BASE_DATA_RATE, RF_RATE_BASE_PA_LEVEL) down to the least air time and power. Every RF_RATE_WINDOW channel
+ * frames, the frames lost and the mean auto retransmits decide:
+ *  - Loss over RF_RATE_LOSS_TARGET, or retries over RF_RATE_DOWN_RETRIES_X10: one step more robust. A window that
+ *    lost more frames than the target allows is decided right away.
+ *  - RF_RATE_UP_WINDOWS windows in a row under half the loss target and RF_RATE_UP_RETRIES_X10: one step faster. When
+ *    a step up is taken back within those first windows, the next try waits twice as many (up to 8 times).
+ *  - Nothing acknowledged for RF_RATE_FALLBACK_MS: straight back to the base step.
+ *
+ * Changes are agreed with the receiver: the new setting rides in the link setting trailer of the channel frames (see
+ * PayloadCodec.h), sent on the current setting. The receiver switches once it got one, the transmitter once one is
+ * acknowledged, both before the next frame. If a frame with the trailer fails, the receiver may have switched with
+ * only its ACK lost: one in 3 of the following frames goes on the new setting, the others on the current one, until
+ * one is acknowledged. A receiver that heard nothing for RF_RECEIVER_LINK_LOST_MS goes back to the base step, where
+ * the transmitter ends up as well.
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef RATECONTROL_H
+#define RATECONTROL_H
+#include "Configuration.h"
+#include <PayloadCodec.h>
+#include <LinkSetting.h> // Link setting byte, see RCT_SETTING
+#include <RF24.h>
+
+
+/// @brief Takes over the data rate and PA level of <pRadio> and sets the base step.
+void    v_Rct_init(RF24* pRadio);
+
+/// @brief Sets the radio for the channel frame of <size> bytes in <pBuffer> (PAYLOAD_MAX_SIZE bytes) and appends the
+///        link setting trailer while a change is being agreed. Returns the frame size.
+uint8_t u8_Rct_prepareFrame(uint8_t* pBuffer, uint8_t size);
+
+/// @brief Outcome of the last channel frame. Bind frames are left out.
+void    v_Rct_recordTransmission(bool acknowledged, uint8_t retries);
+
+/// @brief Straight back to the base step, before a bind frame: a receiver waiting for one is on it.
+void    v_Rct_fallBack();
+
+/// @brief Setting both sides are on, see RCT_SETTING (LinkSetting.h).
+uint8_t u8_Rct_getSetting();
+
+/// @brief Changes agreed with the receiver since startup, fallbacks included.
+uint16_t u16_Rct_getChanges();
+
+#endif
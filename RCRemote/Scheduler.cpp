@@ -0,0 +1,150 @@
+/**
+ * @file Scheduler.cpp
+ * @author Marcelo Fraga
+ * @brief Cooperative fixed-rate task scheduler. See Scheduler.h
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "Scheduler.h"
+
+#if TASK_SCHEDULER == ON
+
+#define SCH_TIMER2_PRESCALER 64ul
+#define SCH_TIMER2_TOP       (((F_CPU / SCH_TIMER2_PRESCALER) * SCHEDULER_TICK_US) / 1000000ul - 1ul)
+static_assert(SCH_TIMER2_TOP <= 255ul, "Scheduler tick too long for Timer2 with a /64 prescaler");
+
+static const SchTask_t* schTasks;
+static uint8_t          schNTasks;
+static SchTaskState_t   schStates[SCH_MAX_TASKS];
+
+#if defined(__AVR__)
+static volatile uint16_t schTicks;
+
+ISR(TIMER2_COMPA_vect)
+{
+    schTicks++;
+}
+#endif
+
+
+/** Internal functions **/
+static void    v_Sch_startTickTimer();
+// Wrap-around safe "tick <a> is at or after tick <b>"
+static bool    b_Sch_isReached(uint16_t a, uint16_t b);
+static uint8_t u8_Sch_selectTask(uint16_t now);
+static void    v_Sch_completeTask(uint8_t taskIdx, uint16_t now);
+
+
+void v_Sch_init(const SchTask_t* pTasks, uint8_t nTasks)
+{
+    uint8_t  i;
+    uint16_t now;
+
+    schTasks  = pTasks;
+    schNTasks = min(nTasks, SCH_MAX_TASKS);
+    v_Sch_startTickTimer();
+
+    now = u16_Sch_getTicks();
+    for(i = 0; i < schNTasks; i++)
+    {
+        schStates[i].u16_Release  = now;
+        schStates[i].u16_Overruns = 0;
+        schStates[i].b_Running    = false;
+    }
+}
+
+void v_Sch_dispatch()
+{
+    uint16_t now     = u16_Sch_getTicks();
+    uint8_t  taskIdx = u8_Sch_selectTask(now);
+
+    if(taskIdx >= schNTasks)
+    {
+        return;
+    }
+
+    schStates[taskIdx].b_Running = true;
+    if(schTasks[taskIdx].run())
+    {
+        v_Sch_completeTask(taskIdx, u16_Sch_getTicks());
+    }
+}
+
+uint16_t u16_Sch_getTicks()
+{
+#if defined(__AVR__)
+    uint16_t ticks;
+    noInterrupts(); // 16 bit read, must not be torn by the tick ISR
+    ticks = schTicks;
+    interrupts();
+    return ticks;
+#else
+    return (uint16_t)(micros() / SCHEDULER_TICK_US); // No timer interrupts on the host build
+#endif
+}
+
+uint16_t u16_Sch_getOverruns(uint8_t taskIdx)
+{
+    return (taskIdx < schNTasks) ? schStates[taskIdx].u16_Overruns : 0u;
+}
+
+
+static void v_Sch_startTickTimer()
+{
+#if defined(__AVR__)
+    noInterrupts();
+    TCCR2A = (1 << WGM21);               // CTC mode, TOP = OCR2A
+    TCCR2B = (1 << CS22);                // clk/64
+    OCR2A  = (uint8_t)SCH_TIMER2_TOP;
+    TCNT2  = 0;
+    TIMSK2 = (1 << OCIE2A);
+    interrupts();
+#endif
+}
+
+static bool b_Sch_isReached(uint16_t a, uint16_t b)
+{
+    return (int16_t)(a - b) >= 0;
+}
+
+static uint8_t u8_Sch_selectTask(uint16_t now)
+{
+    uint8_t i;
+    uint8_t selected = SCH_MAX_TASKS;
+    for(i = 0; i < schNTasks; i++)
+    {
+        bool released = schStates[i].b_Running || b_Sch_isReached(now, schStates[i].u16_Release);
+        if(released && ((selected >= schNTasks) || (schTasks[i].u8_Priority < schTasks[selected].u8_Priority)))
+        {
+            selected = i;
+        }
+    }
+    return selected;
+}
+
+static void v_Sch_completeTask(uint8_t taskIdx, uint16_t now)
+{
+    SchTaskState_t*  pState = &schStates[taskIdx];
+    const SchTask_t* pTask  = &schTasks[taskIdx];
+
+    pState->b_Running = false;
+    if(!b_Sch_isReached(pState->u16_Release + pTask->u16_Deadline, now))
+    {
+        pState->u16_Overruns++;
+    }
+
+    // Fixed rate: the next release is one period after the previous one, not after the completion.
+    // Releases that already passed are skipped (and counted) instead of being run back to back.
+    pState->u16_Release += pTask->u16_Period;
+    while(b_Sch_isReached(now, pState->u16_Release + pTask->u16_Period))
+    {
+        pState->u16_Release += pTask->u16_Period;
+        pState->u16_Overruns++;
+    }
+}
+
+#endif
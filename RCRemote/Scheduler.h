@@ -0,0 +1,49 @@
+/**
+ * @file Scheduler.h
+ * @author Marcelo Fraga
+ * @brief Small cooperative fixed-rate task scheduler. Tasks are described in a static table (function, period,
+ * deadline and priority) and released by a 1ms hardware timer tick (Timer2 compare match on the board).
+ * Each dispatch runs a single task, the highest priority one among the released tasks, so a high priority task
+ * (e.g. radio TX) never waits for more than one lower priority task slice (e.g. a UI strip).
+ * A task function returns whether its job for the current release is finished. Returning false keeps it released,
+ * which lets long jobs such as drawing a frame be split in slices that higher priority tasks can run in between.
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+#include "Configuration.h"
+
+#define SCH_MAX_TASKS 5u
+
+typedef struct SchTask_t
+{
+    bool     (*run)(void);   // Returns true when the job of the current release is finished
+    uint16_t u16_Period;     // In ticks
+    uint16_t u16_Deadline;   // In ticks after the release. Finishing later than this counts as an overrun
+    uint8_t  u8_Priority;    // 0 is the highest priority
+}SchTask_t;
+
+typedef struct SchTaskState_t
+{
+    uint16_t u16_Release;    // Tick of the current (or next, if not released yet) release
+    uint16_t u16_Overruns;   // Deadline misses plus releases skipped because the task was still late
+    bool     b_Running;      // Released and not finished yet
+}SchTaskState_t;
+
+
+/// @brief Starts the tick timer and releases every task of <pTasks> on the first tick.
+void     v_Sch_init(const SchTask_t* pTasks, uint8_t nTasks);
+
+/// @brief Runs the highest priority released task once. Returns immediately when no task is released.
+///        Meant to be called continuously from loop().
+void     v_Sch_dispatch();
+
+uint16_t u16_Sch_getTicks();
+uint16_t u16_Sch_getOverruns(uint8_t taskIdx);
+
+#endif
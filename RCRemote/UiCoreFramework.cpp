@@ -24,25 +24,92 @@ static void drawTextComponent(Component_t_Text* pText);
 static void updateTextComponent(Component_t_Text* pText, char* value);
 
 static void drawMenuItemComponent(Component_t_MenuItem* pItem);
-static void updateMenuItemComponent(Component_t_MenuItem* pItem, UiC_Input_t* inputs);
+static void updateMenuItemComponent(Component_t_MenuItem* pItem, char* text);
 
 static void drawMenuListComponent(Component_t_MenuList* pMenu);
 static void updateMenuListComponent(Component_t_MenuList* pMenu, UiC_Input_t* inputs); 
 
+static void drawFlashTextComponent(Component_t_FlashText* pText);
+static void updateFlashTextComponent(Component_t_FlashText* pText, const __FlashStringHelper* value);
+
+static void drawBarGraphComponent(Component_t_BarGraph* pBarGraph);
+static void updateBarGraphComponent(Component_t_BarGraph* pBarGraph, const UiC_BarGraphData_t* pData);
+
+static const char textTypeName[]           PROGMEM = "Text";
+static const char analogMonitorTypeName[]  PROGMEM = "AnalogMonitor";
+static const char analogAdjustTypeName[]   PROGMEM = "AnalogAdjust";
+static const char menuItemTypeName[]       PROGMEM = "MenuItem";
+static const char menuListTypeName[]       PROGMEM = "MenuList";
+static const char flashTextTypeName[]      PROGMEM = "FlashText";
+static const char barGraphTypeName[]       PROGMEM = "BarGraph";
+
+// Indexed by ComponentType
+static const Component_t_VTable componentVTables[N_COMPONENT_TYPES] PROGMEM =
+{
+  {(void(*) (Component_t*)) drawTextComponent,             (void(*) (Component_t*, void*)) updateTextComponent,             sizeof(Component_t_Text),             textTypeName},
+  {(void(*) (Component_t*)) drawAnalogMonitorComponent,    (void(*) (Component_t*, void*)) updateAnalogMonitorComponent,    sizeof(Component_t_AnalogMonitor),    analogMonitorTypeName},
+  {(void(*) (Component_t*)) drawAnalogAdjustmentComponent, (void(*) (Component_t*, void*)) updateAnalogAdjustmentComponent, sizeof(Component_t_AnalogAdjustment), analogAdjustTypeName},
+  {(void(*) (Component_t*)) drawMenuItemComponent,         (void(*) (Component_t*, void*)) updateMenuItemComponent,         sizeof(Component_t_MenuItem),         menuItemTypeName},
+  {(void(*) (Component_t*)) drawMenuListComponent,         (void(*) (Component_t*, void*)) updateMenuListComponent,         sizeof(Component_t_MenuList),         menuListTypeName},
+  {(void(*) (Component_t*)) drawFlashTextComponent,        (void(*) (Component_t*, void*)) updateFlashTextComponent,        sizeof(Component_t_FlashText),        flashTextTypeName},
+  {(void(*) (Component_t*)) drawBarGraphComponent,         (void(*) (Component_t*, void*)) updateBarGraphComponent,         sizeof(Component_t_BarGraph),         barGraphTypeName}
+};
+static_assert(sizeof(componentVTables) / sizeof(Component_t_VTable) == N_COMPONENT_TYPES, "One vtable per component type");
+static_assert((sizeof(Component_t_MenuList) <= 0xFFu) && (sizeof(Component_t_MenuItem) <= 0xFFu), "Component sizes are 8 bit");
+
+// Pixel bounds of a drawn output, inclusive. May lie partly outside of the display
+typedef struct UiC_Area_t
+{
+  int16_t left;
+  int16_t top;
+  int16_t right;
+  int16_t bottom;
+}UiC_Area_t;
+
 /** Internal UiC functions **/
 static void v_UiC_setInternalErrorState(UiC_ErrorType currentError);
-static UiC_ErrorType e_UiC_addComponentToPage(Component_t* pComponent, Page_t* pPage);
-
-/// @brief Adds a menu item to the previously created MenuList.
-///        Essentially, every MenuItem created needs to have a MenuList created before it, like the following example:
-///        Create MenuList -> Create Menu Item 1 -> Create Menu Item 2.
+static void v_UiC_applyPageChange(const Page_t* nextPage);
+/// @brief Instantiates the components of <pPage> in the pool, in layout order. Stops at the first one that doesn't fit
+static UiC_ErrorType e_UiC_instantiatePage(const Page_t* pPage);
+static UiC_ErrorType e_UiC_initComponent(Component_t* pComponent, const UiC_ComponentLayout_t* pEntry);
+#if OLED_SCREEN_LOW_MEM_MODE == ON
+static uint8_t u8_UiC_collectDirtyTileRows();
+static void v_UiC_drawStrip(uint8_t firstTileRow, uint8_t stripTileRows);
+#else
+/// @brief Draws the changes of the dirty components into the framebuffer (all components after a page change) and
+///        returns the tile rows (bit mask) to send. Their changed tiles are in flushFirstTile/flushLastTile
+static uint8_t u8_UiC_renderChanges();
+static void v_UiC_sendTileRow(uint8_t tileRow);
+static uint8_t u8_UiC_addFlushArea(const UiC_Area_t* pArea);
+static void v_UiC_eraseArea(const UiC_Area_t* pArea);
+/// @brief Part of the output of <pComponent> that changes with its updates, and its draw. The rest of the output (frames,
+///        fixed texts) is left in the framebuffer
+static void v_UiC_getChangingArea(const Component_t* pComponent, UiC_Area_t* pArea);
+static void v_UiC_drawChanges(Component_t* pComponent);
+static bool b_UiC_areasOverlap(const UiC_Area_t* pArea1, const UiC_Area_t* pArea2);
+#endif
+/// @brief Bounding box of everything <pComponent> draws
+static void v_UiC_getArea(const Component_t* pComponent, UiC_Area_t* pArea);
+/// @brief Tile rows (bit mask) covered by the pixel rows <top> to <bottom>, clipped to the display
+static uint8_t u8_UiC_tileRowsOf(int16_t top, int16_t bottom);
+
+/// @brief Adds the menu item <itemHandle> to the last MenuList of the page instantiated so far.
+///        Essentially, every MenuItem needs to have a MenuList before it in the layout, like the following example:
+///        MenuList -> Menu Item 1 -> Menu Item 2.
 ///        In this scenario, Menu Item 1 and Menu Item 2 will be added into MenuList
-///        Moreover, the Page where we are adding the MenuItems needs to be the exact same as where we are adding the MenuList, 
-///        otherwise and error will be thrown.
-///        This isn't the clearest approach but it ensures that we can keep having a generic addComponent without having to pass extra parameters
-static UiC_ErrorType e_UiC_addMenuItemToMenu (Component_t_MenuItem* pItem, Page_t* pPage);
-static bool b_UiC_isComponentInPage(Component_t* pComponent, Page_t* pPage);
+///        This isn't the clearest approach but it ensures that layout entries stay generic, without a reference to their list
+static UiC_ErrorType e_UiC_addMenuItemToMenu(uint8_t itemHandle);
+static void v_UiC_drawComponent(Component_t* pComponent);
+static Component_t_MenuItem* pUiC_getMenuItem(Component_t_MenuList* pMenu, uint8_t itemIdx);
+
+
+// Extent of text drawn with the u8g2_font_4x6_tf font: height relative to the baseline, width per character
+#define UIC_TEXT_ASCENT   6
+#define UIC_TEXT_DESCENT  1
+#define UIC_TEXT_ADVANCE  4
+#define UIC_ALL_TILE_ROWS 0xFFu // 64 pixel rows, 8 tile rows
 
+static_assert(MAX_COMPONENTS_PER_VIEW <= 0xFFu, "Component handles are 8 bit");
 
 static U8G2_SSD1306 DisplayHandle = U8G2_SSD1306(U8G2_R0, U8X8_PIN_NONE);
 static UiCore_t     uiCoreContext;
@@ -50,15 +117,25 @@ static UiCore_t     uiCoreContext;
 
 /**  Core functionality **/
 
-void v_UiC_init()
+void v_UiC_init(uint8_t* pPool, uint16_t poolBytes)
 {
 
-  uiCoreContext.nPages = 0;
-  uiCoreContext.currentPage = 0;
+  uiCoreContext.currentPage = NULL;
+  uiCoreContext.pendingPage = NULL;
+  uiCoreContext.nComponents = 0;
+  uiCoreContext.pool = pPool;
+  uiCoreContext.poolBytes = poolBytes;
+  uiCoreContext.frameInProgress = false;
+  uiCoreContext.fullRedraw = true;
+  uiCoreContext.frameTileRows = 0;
+  uiCoreContext.frameTime = 0;
+  uiCoreContext.lastFrameTime = 0;
+  uiCoreContext.frameTimeReady = false;
   uiCoreContext.internalErrorState = UiC_OK;
   
   // Initialize U8G2 Display Handle
   // TODO: Improve for generic and multiple displays
+  DisplayHandle.setBusClock(DISPLAY_I2C_CLOCK_HZ);
   DisplayHandle.begin();
   DisplayHandle.clearDisplay();
   DisplayHandle.setFont(u8g2_font_4x6_tf);
@@ -68,195 +145,613 @@ void v_UiC_init()
 
 void v_UiC_draw()
 {
+  unsigned long startTime = micros();
+#if OLED_SCREEN_LOW_MEM_MODE == ON
+  uint8_t stripTileRows = DisplayHandle.getBufferTileHeight();
+  uint8_t stripMask     = (uint8_t)((1u << stripTileRows) - 1u);
+#endif
+  uint8_t firstTileRow;
+
+  if(uiCoreContext.currentPage == NULL)
+  {
+    return;
+  }
 
-  DisplayHandle.firstPage();
-  do
+  if(!uiCoreContext.frameInProgress)
   {
-    uint8_t i;
-    Component_t* currentComponent;
-    for(i = 0; i < uiCoreContext.currentPage->nComponents; i++)
+#if OLED_SCREEN_LOW_MEM_MODE == ON
+    uiCoreContext.frameTileRows = u8_UiC_collectDirtyTileRows();
+    if(uiCoreContext.fullRedraw)
+    {
+      uiCoreContext.frameTileRows = UIC_ALL_TILE_ROWS;
+      uiCoreContext.fullRedraw    = false;
+    }
+#else
+    uiCoreContext.frameTileRows = u8_UiC_renderChanges();
+#endif
+    if(uiCoreContext.frameTileRows == 0)
     {
-      currentComponent = uiCoreContext.currentPage->componentList[i]; 
-      currentComponent->draw(currentComponent);
+      return; // Nothing changed since the last frame
     }
+    uiCoreContext.frameInProgress = true;
+    uiCoreContext.frameTime       = 0;
+  }
 
-  }while(DisplayHandle.nextPage());
+  // Only the strips holding dirty tile rows are drawn and sent, one (or more, within the budget) per call
+  do
+  {
+#if OLED_SCREEN_LOW_MEM_MODE == ON
+    for(firstTileRow = 0; (uiCoreContext.frameTileRows & (stripMask << firstTileRow)) == 0; firstTileRow += stripTileRows);
+
+    v_UiC_drawStrip(firstTileRow, stripTileRows);
+    uiCoreContext.frameTileRows  &= (uint8_t)~(stripMask << firstTileRow);
+#else
+    // The frame is already in the framebuffer, what is left is sending its changed tiles
+    for(firstTileRow = 0; (uiCoreContext.frameTileRows & (1u << firstTileRow)) == 0; firstTileRow++);
+
+    v_UiC_sendTileRow(firstTileRow);
+    uiCoreContext.frameTileRows  &= (uint8_t)~(1u << firstTileRow);
+#endif
+    uiCoreContext.frameInProgress = (uiCoreContext.frameTileRows != 0);
+
+#if UIC_DRAW_BUDGET_US > 0
+  }while(uiCoreContext.frameInProgress && ((micros() - startTime) < UIC_DRAW_BUDGET_US));
+#else
+  }while(false); // Exactly one strip per call
+#endif
+
+  uiCoreContext.frameTime += micros() - startTime;
+  if(!uiCoreContext.frameInProgress)
+  {
+    uiCoreContext.lastFrameTime  = uiCoreContext.frameTime;
+    uiCoreContext.frameTimeReady = true;
+    if(uiCoreContext.pendingPage != NULL)
+    {
+      v_UiC_applyPageChange(uiCoreContext.pendingPage);
+      uiCoreContext.pendingPage = NULL;
+    }
+  }
+}
 
+#if OLED_SCREEN_LOW_MEM_MODE == ON
+static uint8_t u8_UiC_collectDirtyTileRows()
+{
+  uint8_t i;
+  uint8_t dirtyTileRows = 0;
+  for(i = 0; i < uiCoreContext.nComponents; i++)
+  {
+    if(uiCoreContext.components[i]->dirty)
+    {
+      dirtyTileRows |= uiCoreContext.components[i]->tileRows;
+      uiCoreContext.components[i]->dirty = false;
+    }
+  }
+  return dirtyTileRows;
 }
 
-/** Page Handling  **/
+static void v_UiC_drawStrip(uint8_t firstTileRow, uint8_t stripTileRows)
+{
+  uint8_t i;
+  uint8_t stripRows = (uint8_t)(((1u << stripTileRows) - 1u) << firstTileRow);
+  Component_t* currentComponent;
 
-UiC_ErrorType e_UiC_newPage(Page_t* pPage)
+  DisplayHandle.setBufferCurrTileRow(firstTileRow);
+  DisplayHandle.clearBuffer();
+  for(i = 0; i < uiCoreContext.nComponents; i++)
+  {
+    currentComponent = uiCoreContext.components[i];
+    if(currentComponent->tileRows & stripRows) // Components outside of the strip would be clipped anyway, don't even draw them
+    {
+      v_UiC_drawComponent(currentComponent);
+    }
+  }
+  DisplayHandle.sendBuffer();
+}
+
+#else
+static uint8_t u8_UiC_renderChanges()
 {
-  if(uiCoreContext.nPages >= MAX_NUMBER_PAGES-1)
+  uint8_t    tileRows = 0;
+  bool       anyDirty = false;
+  uint8_t    i;
+  uint8_t    j;
+  UiC_Area_t changingArea;
+  UiC_Area_t area;
+
+  if(uiCoreContext.fullRedraw)
   {
-    return UiC_ERROR;
+    uiCoreContext.fullRedraw = false;
+    DisplayHandle.clearBuffer();
+    for(i = 0; i < uiCoreContext.nComponents; i++)
+    {
+      uiCoreContext.components[i]->dirty = false;
+      v_UiC_drawComponent(uiCoreContext.components[i]);
+    }
+    for(i = 0; i < UIC_TILE_ROWS; i++)
+    {
+      uiCoreContext.flushFirstTile[i] = 0;
+      uiCoreContext.flushLastTile[i]  = UIC_TILE_COLUMNS - 1;
+    }
+    return UIC_ALL_TILE_ROWS;
   }
-  pPage->nComponents = 0;
-  uiCoreContext.pageList[uiCoreContext.nPages] = pPage;
-  
-  // Aditionally, if this is the first created page, assign it to the current page
-  if(uiCoreContext.nPages == 0)
+
+  // Erase what changed first, then draw it again
+  for(i = 0; i < uiCoreContext.nComponents; i++)
   {
-    uiCoreContext.currentPage = pPage;
+    if(uiCoreContext.components[i]->dirty)
+    {
+      v_UiC_getChangingArea(uiCoreContext.components[i], &changingArea);
+      v_UiC_eraseArea(&changingArea);
+      tileRows |= u8_UiC_addFlushArea(&changingArea);
+      anyDirty  = true;
+    }
+  }
+  if(!anyDirty)
+  {
+    return 0;
   }
 
-  uiCoreContext.nPages++;
-  return UiC_OK;
+  // A component overlapping an erased area of another one lost some of its output, it is drawn again in full.
+  // Drawing only sets pixels, so redrawing what is still there changes nothing
+  for(j = 0; j < uiCoreContext.nComponents; j++)
+  {
+    bool overlapped = false;
+    v_UiC_getArea(uiCoreContext.components[j], &area);
+    for(i = 0; (i < uiCoreContext.nComponents) && !overlapped; i++)
+    {
+      if((i != j) && uiCoreContext.components[i]->dirty)
+      {
+        v_UiC_getChangingArea(uiCoreContext.components[i], &changingArea);
+        overlapped = b_UiC_areasOverlap(&area, &changingArea);
+      }
+    }
+
+    if(overlapped)
+    {
+      v_UiC_drawComponent(uiCoreContext.components[j]);
+    }
+    else if(uiCoreContext.components[j]->dirty)
+    {
+      v_UiC_drawChanges(uiCoreContext.components[j]);
+    }
+  }
+
+  for(i = 0; i < uiCoreContext.nComponents; i++)
+  {
+    uiCoreContext.components[i]->dirty = false;
+  }
+  return tileRows;
 }
 
-void v_UiC_changePage(Page_t* nextPage)
+static void v_UiC_sendTileRow(uint8_t tileRow)
 {
-  uiCoreContext.currentPage = nextPage;
+  uint8_t firstTile = uiCoreContext.flushFirstTile[tileRow];
+  DisplayHandle.updateDisplayArea(firstTile, tileRow, (uint8_t)(uiCoreContext.flushLastTile[tileRow] - firstTile + 1u), 1);
+}
+
+// Adds the tiles covered by <pArea> to the ones to send. Returns the tile rows it covers
+static uint8_t u8_UiC_addFlushArea(const UiC_Area_t* pArea)
+{
+  uint8_t tileRows  = u8_UiC_tileRowsOf(pArea->top, pArea->bottom);
+  uint8_t firstTile = (uint8_t)(max(pArea->left, 0) >> 3);
+  uint8_t lastTile  = (uint8_t)(min(pArea->right, UIC_DISPLAY_WIDTH - 1) >> 3);
+  uint8_t row;
+
+  if(pArea->right < max(pArea->left, 0)) // Nothing changed on the display
+  {
+    return 0;
+  }
+  for(row = 0; row < UIC_TILE_ROWS; row++)
+  {
+    if(!(tileRows & (1u << row)))
+    {
+      continue;
+    }
+    if(uiCoreContext.frameTileRows & (1u << row)) // Row already has tiles to send in this frame
+    {
+      uiCoreContext.flushFirstTile[row] = min(uiCoreContext.flushFirstTile[row], firstTile);
+      uiCoreContext.flushLastTile[row]  = max(uiCoreContext.flushLastTile[row], lastTile);
+    }
+    else
+    {
+      uiCoreContext.flushFirstTile[row] = firstTile;
+      uiCoreContext.flushLastTile[row]  = lastTile;
+    }
+    uiCoreContext.frameTileRows |= (uint8_t)(1u << row);
+  }
+  return tileRows;
+}
 
+static void v_UiC_eraseArea(const UiC_Area_t* pArea)
+{
+  int16_t left   = max(pArea->left, 0);
+  int16_t top    = max(pArea->top, 0);
+  int16_t right  = min(pArea->right, UIC_DISPLAY_WIDTH - 1);
+  int16_t bottom = min(pArea->bottom, UIC_DISPLAY_HEIGHT - 1);
+  if((right < left) || (bottom < top))
+  {
+    return;
+  }
+  DisplayHandle.setDrawColor(0);
+  DisplayHandle.drawBox(left, top, right - left + 1, bottom - top + 1);
+  DisplayHandle.setDrawColor(1);
 }
 
-Page_t* UiC_getActivePage()
+static bool b_UiC_areasOverlap(const UiC_Area_t* pArea1, const UiC_Area_t* pArea2)
 {
-  return uiCoreContext.currentPage;
+  return (pArea1->left <= pArea1->right) && (pArea2->left <= pArea2->right) && // Empty areas overlap nothing
+         (pArea1->left <= pArea2->right) && (pArea2->left <= pArea1->right) &&
+         (pArea1->top <= pArea2->bottom) && (pArea2->top <= pArea1->bottom);
 }
 
-static UiC_ErrorType e_UiC_addComponentToPage(Component_t* pComponent, Page_t* pPage)
+static void v_UiC_getChangingArea(const Component_t* pComponent, UiC_Area_t* pArea)
 {
-  if(pPage->nComponents >= MAX_COMPONENTS_PER_VIEW-1)
+  int16_t x = pComponent->pos.x;
+  int16_t y = pComponent->pos.y;
+  switch(pComponent->type)
   {
-    return UiC_ERROR;
+    case UIC_COMPONENT_ANALOGMONITOR: // Inside of the frame, between the drawn end of the bar and the new one
+    {
+      const Component_t_AnalogMonitor* pAnalogMonitor = (const Component_t_AnalogMonitor*) pComponent;
+      *pArea = {(int16_t)max(x + 1, x + min(pAnalogMonitor->drawnWidth, pAnalogMonitor->barWidth)), (int16_t)(y + 1),
+                (int16_t)min(x + 106, x + max(pAnalogMonitor->drawnWidth, pAnalogMonitor->barWidth) - 1), (int16_t)(y + 4)};
+    }
+    break;
+
+    case UIC_COMPONENT_MENU_ITEM:
+      if(((const Component_t_MenuItem*)pComponent)->fixedText != NULL) // Only the selection marker
+      {
+        *pArea = {(int16_t)(x - 4), (int16_t)(y - 3), (int16_t)(x - 2), (int16_t)(y - 1)};
+        break;
+      }
+      v_UiC_getArea(pComponent, pArea);
+    break;
+
+    default:
+      v_UiC_getArea(pComponent, pArea);
+    break;
   }
-  
-  // Add the component to the page
-  pPage->componentList[pPage->nComponents] = (Component_t*) pComponent;
-  pPage->nComponents++; 
-  return UiC_OK;
-  
 }
 
-static UiC_ErrorType e_UiC_addMenuItemToMenu(Component_t_MenuItem* pItem, Page_t* pPage)
+// Same pixels as the draw function of the type, inside of the changing area
+static void v_UiC_drawChanges(Component_t* pComponent)
 {
-  /* First we fetch the last added MenuList. We do this by iterating in reverse from the latest items added to the page */
-  Component_t_MenuList* pMenu;
-  uint8_t i;
-  UiC_ErrorType error = UiC_ERROR;
-  for(i = (pPage->nComponents - 1); i >= 0; i--)
+  switch(pComponent->type)
   {
-    if(pPage->componentList[i]->type == UIC_COMPONENT_MENU_LIST)
+    case UIC_COMPONENT_ANALOGMONITOR:
     {
-      error = UiC_OK;
-      pMenu = (Component_t_MenuList*) (pPage->componentList[i]);
-      break;
+      Component_t_AnalogMonitor* pAnalogMonitor = (Component_t_AnalogMonitor*) pComponent;
+      uint8_t                    innerWidth     = min(pAnalogMonitor->barWidth, (uint8_t)107u);
+      if(innerWidth > 1u)
+      {
+        DisplayHandle.drawBox(pComponent->pos.x + 1, pComponent->pos.y + 1, innerWidth - 1u, 4);
+      }
+      pAnalogMonitor->drawnWidth = pAnalogMonitor->barWidth;
     }
+    break;
+
+    case UIC_COMPONENT_MENU_ITEM:
+      if(((Component_t_MenuItem*)pComponent)->fixedText != NULL)
+      {
+        if(((Component_t_MenuItem*)pComponent)->isSelected)
+        {
+          DisplayHandle.drawCircle(pComponent->pos.x - 3, pComponent->pos.y - 2, 1);
+        }
+        break;
+      }
+      v_UiC_drawComponent(pComponent);
+    break;
+
+    default:
+      v_UiC_drawComponent(pComponent);
+    break;
   }
+}
+#endif
 
-  /* Then we can check if the ptr is valid or if we are beyond the nr of items */
-  if((pMenu == NULL) || (pMenu->nItems >= MAX_NR_MENU_ITEMS-1))
+static void v_UiC_getArea(const Component_t* pComponent, UiC_Area_t* pArea)
+{
+  int16_t x = pComponent->pos.x;
+  int16_t y = pComponent->pos.y;
+  switch(pComponent->type)
   {
-    return UiC_ERROR;
+    case UIC_COMPONENT_TEXT:
+      *pArea = {x, (int16_t)(y - UIC_TEXT_ASCENT), (int16_t)(x + MAX_NR_CHARS * UIC_TEXT_ADVANCE - 1), (int16_t)(y + UIC_TEXT_DESCENT)};
+    break;
+
+    case UIC_COMPONENT_FLASH_TEXT:
+      *pArea = {x, (int16_t)(y - UIC_TEXT_ASCENT), (int16_t)(x + (UIC_LAYOUT_TEXT_CHARS - 1) * UIC_TEXT_ADVANCE - 1), (int16_t)(y + UIC_TEXT_DESCENT)};
+    break;
+
+    case UIC_COMPONENT_ANALOGMONITOR:
+      *pArea = {x, y, (int16_t)(x + 107), (int16_t)(y + 5)};
+    break;
+
+    case UIC_COMPONENT_ANALOGADJUSTMENT:
+      // From the value2 label above the frame down to the value1 label below it. The markers and labels go anywhere
+      // along the display width
+      *pArea = {0, (int16_t)(y - 7 - UIC_TEXT_ASCENT), UIC_DISPLAY_WIDTH - 1, (int16_t)(y + 20 + UIC_TEXT_DESCENT)};
+    break;
+
+    case UIC_COMPONENT_BAR_GRAPH: // Bars, baseline and marks, up to the right edge whatever the number of bars
+      *pArea = {x, y, UIC_DISPLAY_WIDTH - 1, (int16_t)(y + UIC_BAR_GRAPH_HEIGHT + 3)};
+    break;
+
+    case UIC_COMPONENT_MENU_ITEM: // Selection marker on the left
+      *pArea = {(int16_t)(x - 4), (int16_t)(y - UIC_TEXT_ASCENT), (int16_t)(x + (UIC_LAYOUT_TEXT_CHARS - 1) * UIC_TEXT_ADVANCE - 1), (int16_t)(y + UIC_TEXT_DESCENT)};
+    break;
+
+    default: // The list has no output of its own, its items are also page components and carry their own areas
+      *pArea = {0, 0, -1, -1};
+    break;
   }
-  
-  // Add the component to the page
-  pMenu->menuItems[pMenu->nItems] = pItem;
-  pMenu->nItems++; 
-  
-  
-  return UiC_OK;
 }
 
-static bool b_UiC_isComponentInPage(Component_t* pComponent, Page_t* pPage)
+static uint8_t u8_UiC_tileRowsOf(int16_t top, int16_t bottom)
 {
-  // This isn't very efficient, however, there aren't many components in each page (max ~20) and this is a quick ptr comparison
-  // which is equal throughout the program runtime and therefore, I trust that branch predictors will do a good job :)
-  uint8_t i;
-  for(i = 0; i < pPage->nComponents; i++)
+  uint8_t tileRows = 0;
+  int16_t row;
+  top    = max(top, 0);
+  bottom = min(bottom, UIC_DISPLAY_HEIGHT - 1);
+  for(row = (top >> 3); row <= (bottom >> 3); row++)
   {
-    if(pPage->componentList[i] == pComponent)
-    {
-      return true;
-    }
+    tileRows |= (uint8_t)(1u << row);
   }
-  return false;
+  return tileRows;
+}
 
+bool b_UiC_isFrameInProgress()
+{
+  return uiCoreContext.frameInProgress;
 }
 
-/** Error handling  **/
-static void v_UiC_setInternalErrorState(UiC_ErrorType currentError)
+bool b_UiC_takeFrameTime(uint32_t* pFrameTime)
 {
-  uiCoreContext.internalErrorState = currentError;
+  if(!uiCoreContext.frameTimeReady)
+  {
+    return false;
+  }
+  *pFrameTime = uiCoreContext.lastFrameTime;
+  uiCoreContext.frameTimeReady = false;
+  return true;
 }
 
-UiC_ErrorType UiC_getErrorState()
+void v_UiC_redraw()
 {
-  return uiCoreContext.internalErrorState;
+  uiCoreContext.fullRedraw = true;
 }
 
+/** Page Handling  **/
 
-/** Component handling **/
+void v_UiC_changePage(const Page_t* nextPage)
+{
+  // Switching pages in the middle of a frame would mix strips of both pages on the display, and the components being
+  // drawn would be replaced by the ones of the next page
+  if(uiCoreContext.frameInProgress)
+  {
+    uiCoreContext.pendingPage = nextPage;
+  }
+  else
+  {
+    v_UiC_applyPageChange(nextPage);
+  }
+}
 
+static void v_UiC_applyPageChange(const Page_t* nextPage)
+{
+  if(nextPage != uiCoreContext.currentPage)
+  {
+    uiCoreContext.currentPage = nextPage;
+    uiCoreContext.fullRedraw  = true;
+    v_UiC_setInternalErrorState(e_UiC_instantiatePage(nextPage));
+  }
+}
 
-UiC_ErrorType e_UiC_addComponent(Component_t* pComponent, Page_t* pPage, ComponentType eComponentType, Component_t_Data componentParameters)
-{ 
-  //TODO: Create a static init function for each component, to make this function cleaner
-  UiC_ErrorType error = UiC_OK;
-  // Accessing pos and type directly is safe? Normally, in terms of memory, the "base" from the more complex type we receive here
-  // would be in the same place as pos and type from a generic component.
+const Page_t* UiC_getActivePage()
+{
+  return uiCoreContext.currentPage;
+}
 
-  pComponent->pos.x = componentParameters.x;
-  pComponent->pos.y = componentParameters.y;
-  pComponent->type  = eComponentType; 
+static UiC_ErrorType e_UiC_instantiatePage(const Page_t* pPage)
+{
+  const UiC_ComponentLayout_t* pLayout     = (const UiC_ComponentLayout_t*) pgm_read_ptr(&pPage->layout);
+  uint8_t                      nComponents = pgm_read_byte(&pPage->nComponents);
+  uint16_t                     poolOffset  = 0;
+  UiC_ErrorType                error       = UiC_OK;
+  uint8_t                      i;
+
+  uiCoreContext.nComponents = 0;
+  for(i = 0; i < nComponents; i++)
+  {
+    UiC_ComponentLayout_t entry;
+    memcpy_P(&entry, &pLayout[i], sizeof(entry));
+    uint8_t size = u8_UiC_poolSize(entry.type);
+    if((i >= MAX_COMPONENTS_PER_VIEW) || ((poolOffset + size) > uiCoreContext.poolBytes))
+    {
+      return UiC_ERROR;
+    }
+
+    Component_t* pComponent = (Component_t*) &uiCoreContext.pool[poolOffset];
+    memset(pComponent, 0, size);
+    poolOffset += size;
+    uiCoreContext.components[i] = pComponent;
+    uiCoreContext.nComponents++;
+
+    pComponent->type    = entry.type;
+    pComponent->pos.x   = entry.x;
+    pComponent->pos.y   = entry.y;
+    pComponent->binding = entry.binding;
+    pComponent->dirty   = true;
+    error = (UiC_ErrorType) (error | e_UiC_initComponent(pComponent, &pLayout[i]));
+  }
+  return error;
+}
+
+// <pEntry> is the entry in flash, fixed texts are used from there
+static UiC_ErrorType e_UiC_initComponent(Component_t* pComponent, const UiC_ComponentLayout_t* pEntry)
+{
+  UiC_ErrorType error = UiC_OK;
+  UiC_Area_t    area;
 
-  switch(eComponentType) // TODO: I wanted a LUT for the draw and update functions. I would have to change the types to void*, however this function would be considerably smaller
+  switch(pComponent->type) // Draw and update functions come from the vtable of the type, only the type specific data is set here
   {
     case UIC_COMPONENT_TEXT:
-      ((Component_t_Text*)pComponent)->base.draw   = (void(*) (Component_t*))        drawTextComponent;
-      ((Component_t_Text*)pComponent)->base.update = (void(*) (Component_t*, void*)) updateTextComponent;
-      // strncpy <n> parameter takes the size of the <destination>, as per documentation, if <source> is larger, the remainder of the bytes are 0-padded
-      // No issues shall arise if we pass in too big of a string.
-      strncpy(((Component_t_Text*)pComponent)->value, componentParameters.stringData, sizeof((Component_t_Text*)pComponent)->value); 
+      // strncpy <n> parameter takes the size of the <destination>. The last character is kept for the terminator
+      strncpy_P(((Component_t_Text*)pComponent)->value, pEntry->text, sizeof((Component_t_Text*)pComponent)->value - 1u);
     break;
 
-    case UIC_COMPONENT_ANALOGMONITOR:
-      ((Component_t_AnalogMonitor*)pComponent)->base.draw   = (void(*) (Component_t*))        drawAnalogMonitorComponent;
-      ((Component_t_AnalogMonitor*)pComponent)->base.update = (void(*) (Component_t*, void*)) updateAnalogMonitorComponent;
-    break;
-
-    case UIC_COMPONENT_ANALOGADJUSTMENT:
-      ((Component_t_AnalogAdjustment*)pComponent)->base.draw   = (void(*) (Component_t*))        drawAnalogAdjustmentComponent;
-      ((Component_t_AnalogAdjustment*)pComponent)->base.update = (void(*) (Component_t*, void*)) updateAnalogAdjustmentComponent;
+    case UIC_COMPONENT_FLASH_TEXT:
+      ((Component_t_FlashText*)pComponent)->value = (const __FlashStringHelper*) pEntry->text;
     break;
 
     case UIC_COMPONENT_MENU_ITEM:
-      ((Component_t_MenuItem*)pComponent)->base.draw   = (void(*) (Component_t*))        drawMenuItemComponent;
-      ((Component_t_MenuItem*)pComponent)->base.update = (void(*) (Component_t*, void*)) updateMenuItemComponent;
-      
-      strncpy(((Component_t_MenuItem*)pComponent)->itemText, componentParameters.stringData, sizeof((Component_t_MenuItem*)pComponent)->itemText);
-
-      ((Component_t_MenuItem*)pComponent)->callback = (void(*) (void*))componentParameters.extraData; // Set the callback
-
-      // Aditionally, add the item to the previously created MenuList
-      error = e_UiC_addMenuItemToMenu((Component_t_MenuItem*) pComponent, pPage);
+      if(pgm_read_byte(&pEntry->text[0]) != '\0')
+      {
+        ((Component_t_MenuItem*)pComponent)->fixedText = (const __FlashStringHelper*) pEntry->text;
+      }
+      ((Component_t_MenuItem*)pComponent)->callback = (void(*) (void*)) pgm_read_ptr(&pEntry->callback);
+
+      // Aditionally, add the item to the previous MenuList
+      error = e_UiC_addMenuItemToMenu(uiCoreContext.nComponents - 1u);
     break;
 
     case UIC_COMPONENT_MENU_LIST:
-      ((Component_t_MenuList*)pComponent)->base.draw   = (void(*) (Component_t*))       drawMenuListComponent;
-      ((Component_t_MenuList*)pComponent)->base.update = (void(*) (Component_t*, void*))updateMenuListComponent;
+      ((Component_t_MenuList*)pComponent)->pSelectedIdx = (uint8_t*) pgm_read_ptr(&pEntry->pSelection);
+      if(((Component_t_MenuList*)pComponent)->pSelectedIdx == NULL)
+      {
+        ((Component_t_MenuList*)pComponent)->pSelectedIdx = &((Component_t_MenuList*)pComponent)->ownSelectedIdx;
+      }
+    break;
+    case UIC_COMPONENT_BAR_GRAPH:
+      ((Component_t_BarGraph*)pComponent)->source = NULL;
+      ((Component_t_BarGraph*)pComponent)->nBars  = 0u;
     break;
-  }
 
-  error = (UiC_ErrorType) (error | e_UiC_addComponentToPage((Component_t*) pComponent, pPage));
-  v_UiC_setInternalErrorState(error);
+    default: // Analog monitor and adjustment start from their update
+    break;
+  }
 
+  v_UiC_getArea(pComponent, &area);
+  pComponent->tileRows = u8_UiC_tileRowsOf(area.top, area.bottom);
   return error;
 }
 
+static UiC_ErrorType e_UiC_addMenuItemToMenu(uint8_t itemHandle)
+{
+  /* First we fetch the last instantiated MenuList. We do this by iterating in reverse from the item */
+  Component_t_MenuList* pMenu = NULL;
+  uint8_t i;
+  for(i = itemHandle; i > 0; i--)
+  {
+    if(uiCoreContext.components[i - 1u]->type == UIC_COMPONENT_MENU_LIST)
+    {
+      pMenu = (Component_t_MenuList*) (uiCoreContext.components[i - 1u]);
+      break;
+    }
+  }
+
+  /* Then we can check if the ptr is valid or if we are beyond the nr of items */
+  if((pMenu == NULL) || (pMenu->nItems >= MAX_NR_MENU_ITEMS))
+  {
+    return UiC_ERROR;
+  }
+  
+  // Add the item to the menu. The one of the kept selection starts selected
+  pMenu->menuItems[pMenu->nItems] = itemHandle;
+  ((Component_t_MenuItem*) uiCoreContext.components[itemHandle])->isSelected = (pMenu->nItems == *pMenu->pSelectedIdx);
+  pMenu->nItems++; 
+  
+  return UiC_OK;
+}
+
+static Component_t_MenuItem* pUiC_getMenuItem(Component_t_MenuList* pMenu, uint8_t itemIdx)
+{
+  return (Component_t_MenuItem*) uiCoreContext.components[pMenu->menuItems[itemIdx]];
+}
+
+/** Error handling  **/
+static void v_UiC_setInternalErrorState(UiC_ErrorType currentError)
+{
+  uiCoreContext.internalErrorState = currentError;
+}
+
+UiC_ErrorType UiC_getErrorState()
+{
+  return uiCoreContext.internalErrorState;
+}
+
 
+/** Component handling **/
 
-void v_UiC_updateComponent(Component_t* pComponent, void* pValue)
+void v_UiC_updateComponent(uint8_t binding, void* pValue)
 {
-  bool isComponentInPage = b_UiC_isComponentInPage(pComponent, uiCoreContext.currentPage);
-  if(isComponentInPage) // Only update if the component is in the current active page
+  // There aren't many components in a page (max ~20) and this is a quick byte comparison
+  uint8_t i;
+  for(i = 0; i < uiCoreContext.nComponents; i++)
   {
-    pComponent->update(pComponent, pValue);
+    if(uiCoreContext.components[i]->binding == binding)
+    {
+      Component_t* pComponent = uiCoreContext.components[i];
+      ((void(*) (Component_t*, void*)) pgm_read_ptr(&componentVTables[pComponent->type].update))(pComponent, pValue);
+      return;
+    }
   }
 }
 
+static void v_UiC_drawComponent(Component_t* pComponent)
+{
+  ((void(*) (Component_t*)) pgm_read_ptr(&componentVTables[pComponent->type].draw))(pComponent);
+}
+
+
+/** Memory report **/
+
+void v_UiC_printMemoryReport(Print* pOutput)
+{
+  pOutput->print(F("UiC core: "));
+  pOutput->print(sizeof(UiCore_t));
+  pOutput->print(F(" B, component pool: "));
+  pOutput->print(uiCoreContext.poolBytes);
+  pOutput->println(F(" B"));
+}
+
+void v_UiC_printPageMemory(Print* pOutput, const Page_t* pPage)
+{
+  const UiC_ComponentLayout_t* pLayout     = (const UiC_ComponentLayout_t*) pgm_read_ptr(&pPage->layout);
+  uint8_t                      nComponents = pgm_read_byte(&pPage->nComponents);
+  uint8_t                      typeCounts[N_COMPONENT_TYPES];
+  uint16_t                     pageBytes   = 0;
+  uint8_t                      i;
+  uint8_t                      t;
+
+  memset(typeCounts, 0, sizeof(typeCounts));
+  for(i = 0; i < nComponents; i++)
+  {
+    t = pgm_read_byte(&pLayout[i].type);
+    typeCounts[t]++;
+    pageBytes += u8_UiC_poolSize(t);
+  }
+  pOutput->print(nComponents);
+  pOutput->print(F(" components, "));
+  pOutput->print(pageBytes);
+  pOutput->println(F(" B"));
+  for(t = 0; t < N_COMPONENT_TYPES; t++)
+  {
+    if(typeCounts[t] == 0)
+    {
+      continue;
+    }
+    pOutput->print(F("  "));
+    pOutput->print((const __FlashStringHelper*) pgm_read_ptr(&componentVTables[t].name));
+    pOutput->print(F(": "));
+    pOutput->print(typeCounts[t]);
+    pOutput->print(F(" x "));
+    pOutput->print(u8_UiC_poolSize(t));
+    pOutput->print(F(" = "));
+    pOutput->print(typeCounts[t] * u8_UiC_poolSize(t));
+    pOutput->println(F(" B"));
+  }
+}
 
 
 /* Component draw and update functions - Display specific functions TODO: implement in another unit? */
@@ -267,18 +762,64 @@ static void drawAnalogMonitorComponent(Component_t_AnalogMonitor* pAnalogMonitor
 {
 
   DisplayHandle.drawFrame(pAnalogMonitor->base.pos.x, pAnalogMonitor->base.pos.y, 108, 6);
-  DisplayHandle.drawBox(pAnalogMonitor->base.pos.x, pAnalogMonitor->base.pos.y, map(pAnalogMonitor->value, 0, 1023, 0, 108), 6); // TODO: the map function assumes that we always have values from 0-1023. that's not generic enough for me
+  DisplayHandle.drawBox(pAnalogMonitor->base.pos.x, pAnalogMonitor->base.pos.y, pAnalogMonitor->barWidth, 6);
+#if OLED_SCREEN_LOW_MEM_MODE == OFF
+  pAnalogMonitor->drawnWidth = pAnalogMonitor->barWidth;
+#endif
 }
 
 static void updateAnalogMonitorComponent(Component_t_AnalogMonitor* pAnalogMonitor, uint16_t* value)
 {
-  pAnalogMonitor->value = *value;
+  uint8_t barWidth = map(*value, 0, 1023, 0, 108); // TODO: the map function assumes that we always have values from 0-1023. that's not generic enough for me
+  if(barWidth != pAnalogMonitor->barWidth) // Value changes smaller than a pixel don't need a redraw
+  {
+    pAnalogMonitor->barWidth   = barWidth;
+    pAnalogMonitor->base.dirty = true;
+  }
+}
+
+static void drawBarGraphComponent(Component_t_BarGraph* pBarGraph)
+{
+  uint8_t x      = pBarGraph->base.pos.x;
+  uint8_t bottom = pBarGraph->base.pos.y + UIC_BAR_GRAPH_HEIGHT - 1u;
+  uint8_t i;
+
+  if(pBarGraph->source == NULL)
+  {
+    return;
+  }
+  DisplayHandle.drawHLine(x, bottom + 1u, pBarGraph->nBars);
+  for(i = 0; i < pBarGraph->nBars; i++)
+  {
+    uint8_t value  = pBarGraph->source(i);
+    uint8_t height = min((uint8_t)(value & (uint8_t)~UIC_BAR_GRAPH_MARK), (uint8_t)UIC_BAR_GRAPH_HEIGHT);
+    if(height > 0u)
+    {
+      DisplayHandle.drawVLine(x + i, bottom + 1u - height, height);
+    }
+    if(value & UIC_BAR_GRAPH_MARK)
+    {
+      DisplayHandle.drawVLine(x + i, bottom + 3u, 2);
+    }
+  }
+}
+
+// Every bar is read on each draw, only the source and its version are compared here
+static void updateBarGraphComponent(Component_t_BarGraph* pBarGraph, const UiC_BarGraphData_t* pData)
+{
+  if((pData->source != pBarGraph->source) || (pData->nBars != pBarGraph->nBars) || (pData->version != pBarGraph->version))
+  {
+    pBarGraph->source     = pData->source;
+    pBarGraph->nBars      = pData->nBars;
+    pBarGraph->version    = pData->version;
+    pBarGraph->base.dirty = true;
+  }
 }
 
 static void drawAnalogAdjustmentComponent(Component_t_AnalogAdjustment* pAnalogAdjust)
 {
-  uint16_t x1 = map(pAnalogAdjust->value1, 0, 1023, 3, 125);// TODO: the map function assumes that we always have values from 0-1023. that's not generic enough for me
-  uint16_t x2 = map(pAnalogAdjust->value2, 0, 1023, 3, 125);
+  uint8_t x1 = pAnalogAdjust->x1;
+  uint8_t x2 = pAnalogAdjust->x2;
   DisplayHandle.drawFrame(pAnalogAdjust->base.pos.x, pAnalogAdjust->base.pos.y, 125, 13);
 
   DisplayHandle.drawLine(x1, pAnalogAdjust->base.pos.y-3, x1, pAnalogAdjust->base.pos.y+16);
@@ -295,18 +836,47 @@ static void drawAnalogAdjustmentComponent(Component_t_AnalogAdjustment* pAnalogA
 
 static void updateAnalogAdjustmentComponent(Component_t_AnalogAdjustment* pAnalogAdjust, uint32_t* values)
 {
-  pAnalogAdjust->value1 = (uint16_t)(*values & 0xFFFF);
-  pAnalogAdjust->value2 = (uint16_t)(*values >> 16) & 0xFFFF;
+  uint16_t value1 = (uint16_t)(*values & 0xFFFF);
+  uint16_t value2 = (uint16_t)(*values >> 16) & 0xFFFF;
+  if((value1 != pAnalogAdjust->value1) || (value2 != pAnalogAdjust->value2) || pAnalogAdjust->base.dirty) // Values are printed, every change is visible
+  {
+    pAnalogAdjust->value1     = value1;
+    pAnalogAdjust->value2     = value2;
+    pAnalogAdjust->x1         = map(value1, 0, 1023, 3, 125); // TODO: the map function assumes that we always have values from 0-1023. that's not generic enough for me
+    pAnalogAdjust->x2         = map(value2, 0, 1023, 3, 125);
+    pAnalogAdjust->base.dirty = true;
+  }
 }
 
 static void drawTextComponent(Component_t_Text* pText)
 {
   DisplayHandle.drawStr(pText->base.pos.x, pText->base.pos.y, pText->value);
 }
-// TODO: Consider changing char* to const __FlashStringHelper in order to allow for less RAM usage
+// The last character is kept for the terminator, a longer value is cut
 static void updateTextComponent(Component_t_Text* pText, char* value) 
 {
-  strncpy(pText->value, value, sizeof(pText->value));
+  if(strncmp(pText->value, value, sizeof(pText->value) - 1u) != 0)
+  {
+    strncpy(pText->value, value, sizeof(pText->value) - 1u);
+    pText->value[sizeof(pText->value) - 1u] = '\0';
+    pText->base.dirty = true;
+  }
+}
+
+static void drawFlashTextComponent(Component_t_FlashText* pText)
+{
+  DisplayHandle.setCursor(pText->base.pos.x, pText->base.pos.y);
+  DisplayHandle.print(pText->value);
+}
+
+// Flash strings are never modified, a different text is a different pointer
+static void updateFlashTextComponent(Component_t_FlashText* pText, const __FlashStringHelper* value)
+{
+  if(pText->value != value)
+  {
+    pText->value      = value;
+    pText->base.dirty = true;
+  }
 }
 
 
@@ -314,7 +884,15 @@ static void updateTextComponent(Component_t_Text* pText, char* value)
 static void drawMenuItemComponent(Component_t_MenuItem* pItem)
 {
 
-  DisplayHandle.drawStr(pItem->base.pos.x, pItem->base.pos.y, pItem->itemText);
+  if(pItem->fixedText != NULL)
+  {
+    DisplayHandle.setCursor(pItem->base.pos.x, pItem->base.pos.y);
+    DisplayHandle.print(pItem->fixedText);
+  }
+  else
+  {
+    DisplayHandle.drawStr(pItem->base.pos.x, pItem->base.pos.y, pItem->itemText);
+  }
   if(pItem->isSelected)
   {
     DisplayHandle.drawCircle(pItem->base.pos.x - 3, pItem->base.pos.y - 2, 1);
@@ -322,9 +900,14 @@ static void drawMenuItemComponent(Component_t_MenuItem* pItem)
 
 }
 
-static void updateMenuItemComponent(Component_t_MenuItem* pItem, UiC_Input_t* newState)
+// Selection and clicks are handled by the list, items only take their text. The last character stays a terminator
+static void updateMenuItemComponent(Component_t_MenuItem* pItem, char* text)
 {
-
+  if(strncmp(pItem->itemText, text, sizeof(pItem->itemText) - 1u) != 0)
+  {
+    strncpy(pItem->itemText, text, sizeof(pItem->itemText) - 1u);
+    pItem->base.dirty = (pItem->fixedText == NULL);
+  }
 }
 
 static void drawMenuListComponent(Component_t_MenuList* pMenu)
@@ -333,7 +916,7 @@ static void drawMenuListComponent(Component_t_MenuList* pMenu)
 
   for(i = 0; i < pMenu->nItems; i++)
   {
-    pMenu->menuItems[i]->base.draw((Component_t*) pMenu->menuItems[i]);
+    drawMenuItemComponent(pUiC_getMenuItem(pMenu, i));
   }
 
 }
@@ -341,33 +924,40 @@ static void drawMenuListComponent(Component_t_MenuList* pMenu)
 static void updateMenuListComponent(Component_t_MenuList* pMenu, UiC_Input_t* pInputs)
 {
   uint8_t i;
+  uint8_t selectedIdx = (*pMenu->pSelectedIdx < pMenu->nItems) ? *pMenu->pSelectedIdx : 0u; // The kept selection may be from a longer list
+  uint8_t previouslySelectedIdx = selectedIdx;
+
+  if(pMenu->nItems == 0)
+  {
+    return;
+  }
     
   // 'De-select' all menu entries and ultimately select the one calculated below.
-  // Also restart the selectedMenuItem and remove any clicked item
-  pMenu->menuItems[pMenu->currentlySelectedIdx]->isClicked = false;
   for(i = 0; i < pMenu->nItems; i++)
   {
-    pMenu->menuItems[i]->isSelected = false;
+    pUiC_getMenuItem(pMenu, i)->isSelected = false;
   }
 
   if(pInputs->inputDown)
   {
-    pMenu->currentlySelectedIdx = (pMenu->currentlySelectedIdx + 1) % pMenu->nItems; 
+    selectedIdx = (selectedIdx + 1) % pMenu->nItems; 
   }
   else if(pInputs->inputUp)
   {
-    pMenu->currentlySelectedIdx = (pMenu->currentlySelectedIdx == 0) ? pMenu->nItems-1 : pMenu->currentlySelectedIdx -1; 
+    selectedIdx = (selectedIdx == 0) ? pMenu->nItems-1 : selectedIdx -1; 
   }
-  else if(pInputs->inputSelect)
+  else if(pInputs->inputSelect && (pUiC_getMenuItem(pMenu, selectedIdx)->callback != NULL))
   {
-    pMenu->menuItems[pMenu->currentlySelectedIdx]->isClicked = true; // Set the internal "clicked" state of button
-    
-    if(pMenu->menuItems[pMenu->currentlySelectedIdx]->callback != NULL)
-    {
-      pMenu->menuItems[pMenu->currentlySelectedIdx]->callback((void*) pMenu->currentlySelectedIdx);   // Call the "callback" function to execute an action
-    }
-
+    pUiC_getMenuItem(pMenu, selectedIdx)->callback((void*)(uintptr_t)selectedIdx);   // Call the "callback" function to execute an action
   }
+  *pMenu->pSelectedIdx = selectedIdx;
+
+  pUiC_getMenuItem(pMenu, selectedIdx)->isSelected = true;
 
-  pMenu->menuItems[pMenu->currentlySelectedIdx]->isSelected = true;
+  // Only the selection marker moves, so only the previous and the new selected item need a redraw
+  if(previouslySelectedIdx != selectedIdx)
+  {
+    pUiC_getMenuItem(pMenu, previouslySelectedIdx)->base.dirty = true;
+    pUiC_getMenuItem(pMenu, selectedIdx)->base.dirty           = true;
+  }
 }
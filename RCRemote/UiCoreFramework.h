@@ -15,15 +15,55 @@
 #ifndef UICOREFRAMEWORK_H
 #define UICOREFRAMEWORK_H
 #include <U8g2lib.h>
+#include "Configuration.h"
+#if DISPLAY_ASYNC_I2C == ON
+// Transfers are queued and sent by the TWI interrupt, drawing goes on meanwhile
+#include "DisplayTwi.h"
+#if OLED_SCREEN_LOW_MEM_MODE == ON
+typedef U8G2_SSD1306_128X64_NONAME_1_TWI_ASYNC U8G2_SSD1306;
+#else
+typedef U8G2_SSD1306_128X64_NONAME_F_TWI_ASYNC U8G2_SSD1306;
+#endif
+#else
 #include <Wire.h>
+#if OLED_SCREEN_LOW_MEM_MODE == ON
+// One tile row (128 bytes) of buffer. A frame is drawn and sent a page strip at a time
 typedef U8G2_SSD1306_128X64_NONAME_1_HW_I2C U8G2_SSD1306;
+#else
+// Full 1KB framebuffer. Only what changed is redrawn into it, only the tiles that changed are sent
+typedef U8G2_SSD1306_128X64_NONAME_F_HW_I2C U8G2_SSD1306;
+#endif
+#endif
 
 
 // Tweaking these values will allow for more or less memory usage by the overall Ui Core and Management systems
-#define MAX_COMPONENTS_PER_VIEW 21u
-#define MAX_NUMBER_PAGES        6u
+#define MAX_COMPONENTS_PER_VIEW 24u
 #define MAX_NR_CHARS            5u
-#define MAX_NR_MENU_ITEMS       8u 
+#define MAX_NR_MENU_ITEMS       9u 
+#define UIC_LAYOUT_TEXT_CHARS   9u  // Fixed text of a layout entry, terminator included. Flash only
+
+// Time budget of a single v_UiC_draw call, in uSeconds. Each call sends at least one page strip (one tile row in
+// framebuffer mode) and keeps going while the budget isn't used up. 0 means exactly one per call, so drawing never
+// stalls the caller for long.
+#define UIC_DRAW_BUDGET_US      0u
+
+// 128x64 display, in 8x8 pixel tiles
+#define UIC_DISPLAY_WIDTH       128
+#define UIC_DISPLAY_HEIGHT      64
+#define UIC_TILE_ROWS           (UIC_DISPLAY_HEIGHT / 8)
+#define UIC_TILE_COLUMNS        (UIC_DISPLAY_WIDTH / 8)
+
+// Components are placed in the pool at this alignment. 1 on the AVR, so nothing is lost to padding there
+#define UIC_POOL_ALIGN          alignof(void*)
+
+#define UIC_NO_BINDING          0u
+
+// Bar graph: height of the bars in pixels. A bar value with UIC_BAR_GRAPH_MARK set is also marked below the baseline
+#define UIC_BAR_GRAPH_HEIGHT    32u
+#define UIC_BAR_GRAPH_MARK      0x80u
+
+// Number of entries of a layout table
+#define UIC_LAYOUT_LENGTH(layout) ((uint8_t)(sizeof(layout) / sizeof((layout)[0])))
 
 
 enum UiC_ErrorType
@@ -40,6 +80,8 @@ enum ComponentType
     UIC_COMPONENT_ANALOGADJUSTMENT,
     UIC_COMPONENT_MENU_ITEM,
     UIC_COMPONENT_MENU_LIST,
+    UIC_COMPONENT_FLASH_TEXT,
+    UIC_COMPONENT_BAR_GRAPH,
     N_COMPONENT_TYPES // Last enum is essentially the total number of component types.
 };
 
@@ -50,25 +92,49 @@ typedef struct Component_t_Position
     uint8_t y;
 }Component_t_Position;
 
-// This structure contains all possible data needed to create, initialize and
-// add a new component to a page.
-typedef struct Component_t_Data // TODO: Change this name
+// One component of a page layout. Layouts are const tables in flash (PROGMEM), a page only exists in SRAM while it is
+// the active page: its components are then instantiated from the layout into the component pool.
+// The binding is how the application addresses the component (see v_UiC_updateComponent). UIC_NO_BINDING for static
+// output, e.g. labels, that is never updated.
+typedef struct UiC_ComponentLayout_t
 {
+    uint8_t type;                        // ComponentType
     uint8_t x;
     uint8_t y;
-    char*   stringData;
-    void*   extraData;
-}Component_t_Data;
+    uint8_t binding;
+    char    text[UIC_LAYOUT_TEXT_CHARS]; // Text, flash text and menu item: fixed text. Menu items without one show the text they are updated with
+    void    (*callback)(void* params);   // Menu item: called with the index of the item in its list when clicked
+    uint8_t* pSelection;                 // Menu list: where the selected index is kept while the page isn't active. NULL starts at the first item
+}UiC_ComponentLayout_t;
+
+// A page is nothing but its layout, also in flash
+typedef struct Page_t
+{
+    const UiC_ComponentLayout_t* layout;
+    uint8_t                      nComponents;
+}Page_t;
 
 // Component base. Every component child has a reference to this parent structure.
 // The idea is to have some sort of class and inheritance in C
+// The "methods" are not stored in each component: the type indexes a table of draw and update functions (the vtable)
+// that lives in flash, which saves 4 bytes of SRAM per component.
 typedef struct Component_t
 {
-    ComponentType       type;
+    uint8_t             type;     // ComponentType. 1 byte instead of the 2 of the enum
     Component_t_Position pos;
+    bool                dirty;    // Set by the update functions when the drawn output actually changes. Cleared when a frame starts
+    uint8_t             tileRows; // Bounding box of the drawn output, in display tile rows (bit n covers pixel rows 8n to 8n+7)
+    uint8_t             binding;
+}Component_t;
+
+// Functions and size of a component type. One per ComponentType, in PROGMEM
+typedef struct Component_t_VTable
+{
     void (*draw)  (Component_t* s);
     void (*update)(Component_t* s, void* v);
-}Component_t;
+    uint8_t     size;   // sizeof the component structure, for the SRAM report
+    const char* name;   // PROGMEM string
+}Component_t_VTable;
 
 typedef struct Component_t_Text
 {
@@ -76,12 +142,44 @@ typedef struct Component_t_Text
     char        value[MAX_NR_CHARS];
 }Component_t_Text;
 
+// Text that never leaves flash, e.g. a fixed label. Updated with another flash string (const __FlashStringHelper*),
+// only the pointer is kept in SRAM
+typedef struct Component_t_FlashText
+{
+    Component_t                base;
+    const __FlashStringHelper* value;
+}Component_t_FlashText;
+
 typedef struct Component_t_AnalogMonitor
 {
     Component_t base;
-    uint16_t    value;
+    uint8_t     barWidth; // Pixel width of the bar, computed from the value at update time
+#if OLED_SCREEN_LOW_MEM_MODE == OFF
+    uint8_t     drawnWidth; // Width of the bar in the framebuffer. Only the columns between the two change
+#endif
 }Component_t_AnalogMonitor;
 
+// Height (0 - UIC_BAR_GRAPH_HEIGHT, | UIC_BAR_GRAPH_MARK) of bar <bar>
+typedef uint8_t (*UiC_BarSource_t)(uint8_t bar);
+
+// Update value of the bar graph. Bars aren't kept in SRAM, they are read from the source when drawn: bump the version
+// when what the source gives changes
+typedef struct UiC_BarGraphData_t
+{
+    UiC_BarSource_t source;
+    uint8_t         nBars;
+    uint8_t         version;
+}UiC_BarGraphData_t;
+
+// One pixel wide bars side by side, over a baseline
+typedef struct Component_t_BarGraph
+{
+    Component_t     base;
+    UiC_BarSource_t source;
+    uint8_t         nBars;
+    uint8_t         version;
+}Component_t_BarGraph;
+
 
 // Updating the values on this component:
 // Placing the adjuster variable on the upper or lower 16bits of the 32bit variable will 
@@ -95,24 +193,28 @@ typedef struct Component_t_AnalogAdjustment
     Component_t base;
     uint16_t    value1;
     uint16_t    value2;
+    uint8_t     x1;     // Pixel positions of value1 and value2, computed at update time
+    uint8_t     x2;
 }Component_t_AnalogAdjustment; 
 
+// Updated with a RAM string, which is shown when the layout gives the item no fixed text
 typedef struct Component_t_MenuItem
 {
-    Component_t base;
-    char        itemText[MAX_NR_CHARS];
+    Component_t                base;
+    const __FlashStringHelper* fixedText; // Text of the layout entry, NULL when it has none
+    char                       itemText[MAX_NR_CHARS];
     // TODO: Add possibility to add an image to this menu item
-    bool        isSelected;
-    bool        isClicked;
-    void        (*callback)(void* params);
+    bool                       isSelected;
+    void                       (*callback)(void* params);
 }Component_t_MenuItem;
 
 typedef struct Component_t_MenuList
 {
     Component_t base;
-    Component_t_MenuItem* menuItems[MAX_NR_MENU_ITEMS];
-    uint8_t currentlySelectedIdx; // TODO: Better to have the index instead of ptr?
-    uint8_t nItems;
+    uint8_t     menuItems[MAX_NR_MENU_ITEMS]; // Handles of the items
+    uint8_t*    pSelectedIdx;                 // Bound to the layout pSelection, or to ownSelectedIdx
+    uint8_t     ownSelectedIdx;
+    uint8_t     nItems;
     
 }Component_t_MenuList;
 
@@ -124,57 +226,114 @@ typedef struct UiC_Input_t
 }UiC_Input_t;
 
 
-typedef struct Page_t
-{ 
-    // This must be a pointer array since the elements we are adding are of different, 
-    // bigger sizes than Component_t.
-    Component_t* componentList[MAX_COMPONENTS_PER_VIEW]; 
-    uint8_t      nComponents;
-}Page_t;
-
-
 // 17/06/2024 - Changed 'currentPage' from uint8 index to an actual pointer
 // This allows us to switch to pages in an absolute fashion without having to
 // have a 'fetch page' function like we had. 
 // Analogous to this, I will change the MenuItem 'currentlySelected' to an index
 // instead of a pointer, because for menus, I am more interested in having it
 // be relatively selected to other items
+// Components of the current page live in the pool given to v_UiC_init. A component handle is its index in <components>,
+// which is also the order of the layout.
 typedef struct UiCore_t
 {
-    Page_t* pageList[MAX_NUMBER_PAGES];
-    // uint8_t currentPage;
-    Page_t* currentPage; 
-    uint8_t nPages;
+    const Page_t* currentPage; 
+    const Page_t* pendingPage;     // Page requested while a frame was in progress. Applied once the frame is finished
+    Component_t*  components[MAX_COMPONENTS_PER_VIEW];
+    uint8_t       nComponents;
+    uint8_t*      pool;
+    uint16_t      poolBytes;
+    bool          frameInProgress; // A frame is sent over several v_UiC_draw calls, one (or more) page strips at a time
+    bool          fullRedraw;      // Every tile row must be redrawn on the next frame, e.g. after a page change
+    uint8_t       frameTileRows;   // Tile rows still to be sent in the current frame
+#if OLED_SCREEN_LOW_MEM_MODE == OFF
+    uint8_t       flushFirstTile[UIC_TILE_ROWS]; // Per tile row, first and last changed tile (column) still to be sent
+    uint8_t       flushLastTile[UIC_TILE_ROWS];
+#endif
+    uint32_t      frameTime;       // uSeconds spent in v_UiC_draw on the current frame
+    uint32_t      lastFrameTime;   // Same, of the last finished frame
+    bool          frameTimeReady;  // A frame finished since the last b_UiC_takeFrameTime
 
     UiC_ErrorType internalErrorState;
 }UiCore_t;
 
 
+/** Pool sizing. Compile time, so the application can size its pool for its largest layout **/
+
+constexpr uint8_t u8_UiC_componentSize(uint8_t type)
+{
+    return (type == UIC_COMPONENT_TEXT)             ? sizeof(Component_t_Text)             :
+           (type == UIC_COMPONENT_ANALOGMONITOR)    ? sizeof(Component_t_AnalogMonitor)    :
+           (type == UIC_COMPONENT_ANALOGADJUSTMENT) ? sizeof(Component_t_AnalogAdjustment) :
+           (type == UIC_COMPONENT_MENU_ITEM)        ? sizeof(Component_t_MenuItem)         :
+           (type == UIC_COMPONENT_MENU_LIST)        ? sizeof(Component_t_MenuList)         :
+           (type == UIC_COMPONENT_BAR_GRAPH)        ? sizeof(Component_t_BarGraph)         :
+                                                      sizeof(Component_t_FlashText);
+}
+
+/// @brief Pool bytes taken by a component of type <type>
+constexpr uint8_t u8_UiC_poolSize(uint8_t type)
+{
+    return (uint8_t)(((u8_UiC_componentSize(type) + UIC_POOL_ALIGN - 1u) / UIC_POOL_ALIGN) * UIC_POOL_ALIGN);
+}
+
+/// @brief Pool bytes needed by the <nComponents> first entries of <pLayout>
+constexpr uint16_t u16_UiC_layoutBytes(const UiC_ComponentLayout_t* pLayout, uint8_t nComponents)
+{
+    return (nComponents == 0u) ? 0u : (uint16_t)(u8_UiC_poolSize(pLayout->type) + u16_UiC_layoutBytes(pLayout + 1, nComponents - 1u));
+}
+
+
 /**  Core functionality **/
-void v_UiC_init();
+
+/// @brief Starts the display and the core context. The components of the active page are instantiated in <pPool>, which
+///        must hold the largest layout (u16_UiC_layoutBytes) and be aligned to UIC_POOL_ALIGN. No page is active until
+///        the first v_UiC_changePage.
+void v_UiC_init(uint8_t* pPool, uint16_t poolBytes);
+
+/// @brief Incremental draw of the current page. Starts a new frame if none is in progress, then draws page strips until
+///        the frame is finished or UIC_DRAW_BUDGET_US is used up. The next call resumes where this one stopped.
+///        A frame only covers the page strips touched by dirty components, and nothing is drawn when no component is dirty.
+///        In framebuffer mode (OLED_SCREEN_LOW_MEM_MODE OFF) the frame is drawn at once when it starts: only the dirty
+///        components are erased and redrawn, fixed labels and frames stay as drawn when the page became active. The
+///        changed tiles are then sent a tile row at a time, with updateDisplayArea.
+///        Components must not be updated while a frame is in progress (see b_UiC_isFrameInProgress), so a frame is always
+///        drawn from one consistent state.
 void v_UiC_draw();
+bool b_UiC_isFrameInProgress();
+
+/// @brief Gives the time spent drawing and sending the last finished frame, over all of its v_UiC_draw calls, in
+///        <pFrameTime> (uSeconds). Returns false, and leaves <pFrameTime> alone, if no frame finished since the last call.
+///        With DISPLAY_ASYNC_I2C, sending only counts while the transfer queue is full.
+bool b_UiC_takeFrameTime(uint32_t* pFrameTime);
+
+/// @brief Makes the next frame redraw and send the whole active page.
+void v_UiC_redraw();
 
 /** Page Handling  **/
-UiC_ErrorType e_UiC_newPage(Page_t* pPage);
-void          v_UiC_changePage(Page_t* nextPage); 
-Page_t*       UiC_getActivePage();
+
+/// @brief Makes <nextPage> (in flash) the active page. Its components are instantiated from its layout, replacing the
+///        ones of the previous page, once no frame is in progress. Sets the error state if the layout doesn't fit.
+void          v_UiC_changePage(const Page_t* nextPage); 
+const Page_t* UiC_getActivePage();
 
 /** Component handling **/
 
+/// @brief Updates the component of the active page bound to <binding> with <pValue>. The value type depends on the
+///        component type. Nothing happens when the active page has no such component, i.e. components of other pages
+///        are never updated.
+void          v_UiC_updateComponent(uint8_t binding, void* pValue);
+
+
+/** Memory report **/
+
+/// @brief Prints the SRAM used by the Ui Core and its pool to <pOutput>, with the sizes of the build it runs in.
+void          v_UiC_printMemoryReport(Print* pOutput);
 
-/// @brief Generic Ui Core function to add components to a certain page. This takes care of initializing a component of type <eComponentType>
-///        with all their base parameters as well potential optional parameters, passed through the <baseData> struct.
-///        Some components have mandatory extra parameters, others have optional extra parameters while others have no extra parameters at all.
-/// @param pComponent       The component to be initialized and added to page <pPage>
-/// @param pPage            The page to which component <pComponent> will be added
-/// @param eComponentType   The type of the component.
-/// @param baseData         
-/// @return 
-UiC_ErrorType e_UiC_addComponent(Component_t* pComponent, Page_t* pPage, ComponentType eComponentType, Component_t_Data componentParameters);
-void          v_UiC_updateComponent(Component_t* pComponent, void* pValue);
+/// @brief Prints the pool bytes taken by <pPage> (in flash) to <pOutput>, per component type.
+void          v_UiC_printPageMemory(Print* pOutput, const Page_t* pPage);
 
 
 /** Error Handling **/
 UiC_ErrorType UiC_getErrorState();
 
-#endif;
\ No newline at end of file
+#endif
\ No newline at end of file
@@ -14,59 +14,122 @@
 
 #include "UiManagement.h"
 
-/* Page/View declaration */
-Page_t monitoringPage;  // Default page where we can see the the analog monitors etc.
-Page_t optionsPage;     // Options menu. Contains a group of options and allows us to navigate to other pages such as configuration
-Page_t configurationPage; // Where we configure the current channel
-
-
-/* Component Declaration */
-
-#define N_OPTIONS 3u
-
-Component_t_AnalogMonitor progressBars[N_CHANNELS];
-Component_t_AnalogAdjustment adjustmentBar;
-Component_t_MenuItem    analogId[N_CHANNELS];
-Component_t_MenuItem    communicationState;
-
-// DEBUG
-Component_t_Text        testButton1;
-Component_t_Text        testButton2;
-
-Component_t_MenuList    optionsMenu;
-Component_t_MenuItem    options[N_OPTIONS];
-
-Component_t_MenuList    channelChooseMenu;
-
+// Indices of the entries in the options menu. Diag, Model and RF are only there when their feature is ON
+#define OPTION_IDX_TRIMMING 0u
+#define OPTION_IDX_ENDPOINT 1u
+#define OPTION_IDX_INVERT   2u
+#define OPTION_IDX_EXPO     3u
+#define OPTION_IDX_RATE     4u
+#define OPTION_IDX_DIAG     5u
+#define OPTION_IDX_MODEL    (OPTION_IDX_DIAG + ((LOOP_TIMING == ON) ? 1u : 0u))
+#define OPTION_IDX_MIX      (OPTION_IDX_MODEL + ((CONFIGURATION_STORAGE == ON) ? 1u : 0u))
+#define OPTION_IDX_RF       (OPTION_IDX_MIX + 1u)
+#define N_OPTIONS           (OPTION_IDX_RF + ((FREQUENCY_HOPPING == ON) ? 1u : 0u))
+#define OPTION_Y(idx)       (uint8_t)(13 + ((idx) * 7))
+
+// Fields of the mix page. Rule and point select what is edited, the others are the fields of the selected rule and
+// the value of the selected point of its curve table
+#define MIX_FIELD_RULE        0u
+#define MIX_FIELD_SOURCE      1u
+#define MIX_FIELD_DESTINATION 2u
+#define MIX_FIELD_WEIGHT      3u
+#define MIX_FIELD_OFFSET      4u
+#define MIX_FIELD_CURVE       5u
+#define MIX_FIELD_POINT       6u
+#define MIX_FIELD_POINT_VALUE 7u
+#define N_MIX_FIELDS          8u
+
+static_assert(N_OPTIONS <= MAX_NR_MENU_ITEMS, "Options must fit in one menu");
+static_assert(N_MODELS <= MAX_NR_MENU_ITEMS, "Models must fit in one menu, requestedModel is 3 bits");
+static_assert(N_MIX_FIELDS <= MAX_NR_MENU_ITEMS, "Mix fields must fit in one menu");
+static_assert((MIX_MAX_RULES <= 16u) && (MIX_CURVE_POINTS <= 8u), "Selected rule and point are 4 and 3 bits");
+
+#define N_DIAG_PAGE_STAGES    5u
+#if LOOP_TIMING == ON
+// Stages shown on the diagnostics page. Payload build, single draw calls and the whole loop are left out to fit the page,
+// they are still in the Serial dump. A whole frame tells the display modes (OLED_SCREEN_LOW_MEM_MODE) apart
+const DiagStage  diagPageStages[N_DIAG_PAGE_STAGES] = {DIAG_STAGE_INPUT_READ, DIAG_STAGE_RADIO_TX, DIAG_STAGE_BUTTONS, DIAG_STAGE_UI_UPDATE, DIAG_STAGE_UI_FRAME};
+#endif
+
+// Bindings of the components the update functions address. Components only exist while their page is active, updates
+// of the others go nowhere
+enum UiM_Binding
+{
+    UIM_BIND_NONE = UIC_NO_BINDING,
+    UIM_BIND_CHANNEL_MENU,
+    UIM_BIND_CHANNEL_NAME,                                                      // One per channel
+    UIM_BIND_CHANNEL_BAR         = UIM_BIND_CHANNEL_NAME + N_CHANNELS,          // One per channel
+    UIM_BIND_COMM_STATE          = UIM_BIND_CHANNEL_BAR + N_CHANNELS,
+    // Link quality, next to the communication state: 95th percentile latency, packet loss, mean retries, receiver voltage
+    UIM_BIND_LINK_LATENCY,
+    UIM_BIND_LINK_LOSS,
+    UIM_BIND_LINK_RETRIES,
+    UIM_BIND_RECEIVER_VOLTAGE,
+    UIM_BIND_TEST_BUTTONS,                                                      // DEBUG
+    UIM_BIND_OPTIONS_MENU,
+    UIM_BIND_CONFIG_TITLE,
+    UIM_BIND_CONFIG_SUBTITLE,
+    UIM_BIND_ENDPOINT_PERCENTAGE,
+    UIM_BIND_ADJUSTMENT_BAR,
+    UIM_BIND_MODEL_MENU,
+    UIM_BIND_ACTIVE_MODEL,
+    UIM_BIND_MIX_MENU,
+    UIM_BIND_MIX_TITLE,
+    UIM_BIND_MIX_VALUE,                                                         // One per mix field
+    UIM_BIND_DIAG_MEAN           = UIM_BIND_MIX_VALUE + N_MIX_FIELDS,           // One per diagnostics stage
+    UIM_BIND_DIAG_MAX            = UIM_BIND_DIAG_MEAN + N_DIAG_PAGE_STAGES,     // One per diagnostics stage
+    UIM_BIND_DIAG_LOOP_RATE      = UIM_BIND_DIAG_MAX + N_DIAG_PAGE_STAGES,
+    UIM_BIND_DIAG_TX_RATE,
+    UIM_BIND_DIAG_ACK_RATIO,
+    UIM_BIND_DIAG_OVERRUNS,
+    UIM_BIND_RF_STATE,
+    UIM_BIND_RF_SCAN
+};
 
-Component_t_Data componentInputData;
 
-Component_t_Text configurationMainTitle;
-Component_t_Text configurationSubTitle;       
-Component_t_Text endpointPercentage;       
+static UiM_t_contextManager UiContextManager;
 
-UiC_ErrorType error;
+// Gestures of each button (UiM_Button order). Left is the back button (hold), right scrolls the menus (auto repeat) and
+// select confirms (press) or goes on with an adjustment (hold). No page uses double clicks
+static const UiM_ButtonTiming_t buttonTimings[N_BUTTONS] PROGMEM =
+{
+    {BUTTON_HOLD_MS, 0u,                     0u,                      0u}, // UIM_BUTTON_LEFT
+    {0u,             BUTTON_REPEAT_DELAY_MS, BUTTON_REPEAT_PERIOD_MS, 0u}, // UIM_BUTTON_RIGHT
+    {BUTTON_HOLD_MS, 0u,                     0u,                      0u}, // UIM_BUTTON_SELECT
+};
+static_assert(N_BUTTONS <= (sizeof(UiM_ButtonMask_t) * 8u), "One mask bit per button");
 
-
-static UiM_t_contextManager UiContextManager;
+// Gesture state, bit i / entry i is button i
+static UiM_ButtonMask_t buttonPrev;
+static UiM_ButtonMask_t buttonHoldArmed;                // Pressed, hold not reported yet
+static UiM_ButtonMask_t buttonClickArmed;               // Last press can still become a double click
+static uint16_t         buttonPressTime[N_BUTTONS];
+static uint16_t         buttonNextRepeat[N_BUTTONS];
 
 
 /** Internal function declaration **/
 static void v_UiM_processUIManagementInputs(UiM_t_Inputs* uiInputs);
-static bool b_UiM_risingEdge(uint8_t prevValue, uint8_t currentValue, uint8_t desiredEdge);
-static bool b_UiM_buttonHold(bool risingEdge, bool currentValue, unsigned long* timeHolding, bool* holdPreviouslyTriggered);
+// Gestures of every button, from their levels <buttons> at <now> (ms). Edges are a few mask operations, only the buttons
+// being pressed are looked at one by one, for their timings.
+static void v_UiM_processButtons(UiM_t_Inputs* uiInputs, UiM_ButtonMask_t buttons, uint16_t now);
+// Gestures are latched by v_UiM_processUIManagementInputs until the components consume them, once per frame.
+static void v_UiM_clearLatchedInputs(UiM_t_Inputs* uiInputs);
+static void v_UiM_updateComponents(void);
 static void v_UiM_updateProviderPorts(void);
 // Wrapper function to the UiC page function. Here we make sure inputs are restarted so they aren't re-used on the next page.
 // This also enforces the idea that inputs are obtained in RAW form in the application, processed here in UiM and only passed
 // to certain components on UiC that require updates from them. However, the actual User Input is UiM responsability.
 // Aditionally, the page is only actually changed at the end of the current update cycle. This function simply places a
 // page request on hold.
-static void v_UiM_requestPageChange(Page_t* page);
+static void v_UiM_requestPageChange(const Page_t* page);
 // Actual page change processing where UI inputs are cleared and UiC_changePage is called.
 static void v_UiM_processPageChange();
 
 /**  Project Specific functions  **/ // Todo: eventually we can have a separate project specific file.
-static void buildCommunicationString(bool connectionDropped, unsigned long txTime, char* commStateString);
+static void buildCommunicationString(bool connectionDropped, uint16_t latency, char* commStateString);
+static void buildLatencyString(uint16_t latency, char* latencyStr);
+static void updateLinkQuality(const RemoteCommunicationState_t* pCommState);
+static void updateChannelNames(const RemoteChannelInput_t* pChannels);
 static void buildEndpointPercentageString(uint16_t endpointAdjustmentValue, char* endpointAdjustmentStr);
 static void switchToConfigurationOptionsPage(void* selectedChannelIdx);
 static void switchToConfigurationPage(void* selectedConfigurationIdx);
@@ -74,77 +137,301 @@ static void updateAdjustmentMonitors(uint16_t* adjustmentWheel, uint16_t updateN
 static void updateRemoteConfigurationTrimming(uint8_t channelIdx, uint16_t newTrimmingValue);
 static void updateRemoteConfigurationEndpoint(uint8_t channelIdx, uint16_t newEndpointLow, uint16_t newEndpointUpper);
 static void updateRemoteConfigurationInvert(uint8_t channelIdx);
+static void updateRemoteConfigurationCurve(uint8_t channelIdx, uint8_t curveOptionIdx, uint8_t newPercentage);
 static bool isConfigurationValid(uint16_t trimming, uint16_t endpointLow, uint16_t endpointUpper);
+#if CONFIGURATION_STORAGE == ON
+static void selectModel(void* selectedModelIdx);
+#endif
+static void toggleMixFieldEdit(void* selectedFieldIdx);
+static void updateMixPage(MixConfig_t* pMixes, uint16_t editWheel, const UiC_Input_t* pMenuInput);
+static bool updateMixField(MixConfig_t* pMixes, uint8_t field, uint16_t editWheel);
+static void buildMixFieldString(const MixConfig_t* pMixes, uint8_t field, char* fieldStr);
+static int16_t mapWheelToRange(uint16_t wheel, int16_t minValue, int16_t maxValue);
+#if LOOP_TIMING == ON
+static void updateDiagnosticsPage(const DiagLoopStats_t* pLoopStats);
+static void buildDurationString(uint32_t duration, char* durationStr);
+static void buildRateString(uint16_t rate, char* rateStr);
+#endif
+#if FREQUENCY_HOPPING == ON
+static void updateRfPage(void);
+static uint8_t u8_getScanBar(uint8_t channel);
+#endif
+
+/* Page layouts. Const tables in flash, instantiated by UiC into the component pool when their page becomes active.
+   Draw order is the layout order */
+
+// Type, x, y, binding, fixed text, menu item callback, menu list selection
+#define UIM_CHANNEL_ROW(i) \
+    {UIC_COMPONENT_MENU_ITEM,     3,  (uint8_t)((i) * 7 + 15), (uint8_t)(UIM_BIND_CHANNEL_NAME + (i)), "", switchToConfigurationOptionsPage, NULL}, \
+    {UIC_COMPONENT_ANALOGMONITOR, 18, (uint8_t)((i) * 7 + 10), (uint8_t)(UIM_BIND_CHANNEL_BAR + (i)),  "", NULL,                              NULL}
+
+static_assert(N_CHANNELS == 8u, "The monitoring page has a row per channel");
+static constexpr UiC_ComponentLayout_t monitoringLayout[] PROGMEM = // Default page where we can see the the analog monitors etc.
+{
+    {UIC_COMPONENT_MENU_LIST,  0,   0, UIM_BIND_CHANNEL_MENU,     "",       NULL, &UiContextManager.globals.channelMenuSelection},
+    UIM_CHANNEL_ROW(0), UIM_CHANNEL_ROW(1), UIM_CHANNEL_ROW(2), UIM_CHANNEL_ROW(3),
+    UIM_CHANNEL_ROW(4), UIM_CHANNEL_ROW(5), UIM_CHANNEL_ROW(6), UIM_CHANNEL_ROW(7),
+    {UIC_COMPONENT_TEXT,       35,  5, UIM_BIND_TEST_BUTTONS,     "",       NULL, NULL}, // DEBUG
+    {UIC_COMPONENT_TEXT,       1,   5, UIM_BIND_COMM_STATE,       "NoComm", NULL, NULL},
+    {UIC_COMPONENT_TEXT,       58,  5, UIM_BIND_LINK_LATENCY,     "",       NULL, NULL},
+    {UIC_COMPONENT_TEXT,       77,  5, UIM_BIND_LINK_LOSS,        "",       NULL, NULL},
+    {UIC_COMPONENT_TEXT,       94,  5, UIM_BIND_LINK_RETRIES,     "",       NULL, NULL},
+    {UIC_COMPONENT_TEXT,       112, 5, UIM_BIND_RECEIVER_VOLTAGE, "",       NULL, NULL}
+};
+
+// Options menu. Contains a group of options and allows us to navigate to other pages such as configuration.
+// Items are in OPTION_IDX order, the callbacks get that index
+static constexpr UiC_ComponentLayout_t optionsLayout[] PROGMEM =
+{
+    {UIC_COMPONENT_MENU_LIST,  0,  0,                          UIM_BIND_OPTIONS_MENU, "",         NULL,                      &UiContextManager.globals.optionsMenuSelection},
+    {UIC_COMPONENT_MENU_ITEM,  3,  OPTION_Y(0),                UIM_BIND_NONE,         "Trimming", switchToConfigurationPage, NULL},
+    {UIC_COMPONENT_MENU_ITEM,  3,  OPTION_Y(1),                UIM_BIND_NONE,         "EndPoint", switchToConfigurationPage, NULL},
+    {UIC_COMPONENT_MENU_ITEM,  3,  OPTION_Y(2),                UIM_BIND_NONE,         "Invert",   switchToConfigurationPage, NULL},
+    {UIC_COMPONENT_MENU_ITEM,  3,  OPTION_Y(3),                UIM_BIND_NONE,         "Expo",     switchToConfigurationPage, NULL},
+    {UIC_COMPONENT_MENU_ITEM,  3,  OPTION_Y(4),                UIM_BIND_NONE,         "Rate",     switchToConfigurationPage, NULL},
+#if LOOP_TIMING == ON
+    {UIC_COMPONENT_MENU_ITEM,  3,  OPTION_Y(OPTION_IDX_DIAG),  UIM_BIND_NONE,         "Diag",     switchToConfigurationPage, NULL},
+#endif
+#if CONFIGURATION_STORAGE == ON
+    {UIC_COMPONENT_MENU_ITEM,  3,  OPTION_Y(OPTION_IDX_MODEL), UIM_BIND_NONE,         "Model",    switchToConfigurationPage, NULL},
+#endif
+    {UIC_COMPONENT_MENU_ITEM,  3,  OPTION_Y(OPTION_IDX_MIX),   UIM_BIND_NONE,         "Mix",      switchToConfigurationPage, NULL},
+#if FREQUENCY_HOPPING == ON
+    {UIC_COMPONENT_MENU_ITEM,  70, OPTION_Y(0),                UIM_BIND_NONE,         "RF",       switchToConfigurationPage, NULL}, // The first column is full
+#endif
+    {UIC_COMPONENT_TEXT,       35, 5,                          UIM_BIND_TEST_BUTTONS, "",         NULL,                      NULL} // DEBUG
+};
+#define OPTIONS_LAYOUT_ITEM(idx) (1u + (idx)) // The list comes first
+
+// Where we configure the current channel
+static constexpr UiC_ComponentLayout_t configurationLayout[] PROGMEM =
+{
+    {UIC_COMPONENT_FLASH_TEXT,       55, 5,  UIM_BIND_CONFIG_TITLE,        "",    NULL, NULL},
+    {UIC_COMPONENT_TEXT,             55, 15, UIM_BIND_CONFIG_SUBTITLE,     "",    NULL, NULL},
+    {UIC_COMPONENT_TEXT,             60, 40, UIM_BIND_ENDPOINT_PERCENTAGE, "25%", NULL, NULL},
+    {UIC_COMPONENT_ANALOGADJUSTMENT, 2,  30, UIM_BIND_ADJUSTMENT_BAR,      "",    NULL, NULL}
+};
+
+#if LOOP_TIMING == ON
+// Loop timing statistics. Columns: stage, mean (us), max (us). Durations from 10ms up are shown in ms with an 'm' suffix.
+// Then scheduler overruns, last row: loop Hz, TX Hz and ACK ratio
+#define UIM_DIAG_ROW(i) \
+    {UIC_COMPONENT_TEXT, 40, (uint8_t)((i) * 9 + 8), (uint8_t)(UIM_BIND_DIAG_MEAN + (i)), "", NULL, NULL}, \
+    {UIC_COMPONENT_TEXT, 80, (uint8_t)((i) * 9 + 8), (uint8_t)(UIM_BIND_DIAG_MAX + (i)),  "", NULL, NULL}
+
+static_assert(N_DIAG_PAGE_STAGES == 5u, "The diagnostics page has a row per stage");
+static constexpr UiC_ComponentLayout_t diagnosticsLayout[] PROGMEM =
+{
+    {UIC_COMPONENT_FLASH_TEXT, 2,   8,  UIM_BIND_NONE,           "In",    NULL, NULL},
+    {UIC_COMPONENT_FLASH_TEXT, 2,   17, UIM_BIND_NONE,           "Tx",    NULL, NULL},
+    {UIC_COMPONENT_FLASH_TEXT, 2,   26, UIM_BIND_NONE,           "Btn",   NULL, NULL},
+    {UIC_COMPONENT_FLASH_TEXT, 2,   35, UIM_BIND_NONE,           "Ui",    NULL, NULL},
+    {UIC_COMPONENT_FLASH_TEXT, 2,   44, UIM_BIND_NONE,           "Frame", NULL, NULL},
+    UIM_DIAG_ROW(0), UIM_DIAG_ROW(1), UIM_DIAG_ROW(2), UIM_DIAG_ROW(3), UIM_DIAG_ROW(4),
+    {UIC_COMPONENT_FLASH_TEXT, 2,   53, UIM_BIND_NONE,           "Ovr",   NULL, NULL},
+    {UIC_COMPONENT_TEXT,       40,  53, UIM_BIND_DIAG_OVERRUNS,  "",      NULL, NULL},
+    {UIC_COMPONENT_FLASH_TEXT, 2,   62, UIM_BIND_NONE,           "Hz",    NULL, NULL},
+    {UIC_COMPONENT_TEXT,       40,  62, UIM_BIND_DIAG_LOOP_RATE, "",      NULL, NULL},
+    {UIC_COMPONENT_TEXT,       80,  62, UIM_BIND_DIAG_TX_RATE,   "",      NULL, NULL},
+    {UIC_COMPONENT_TEXT,       108, 62, UIM_BIND_DIAG_ACK_RATIO, "",      NULL, NULL}
+};
+#endif
+
+#if CONFIGURATION_STORAGE == ON
+// Model (configuration profile) selection
+static_assert(N_MODELS == 4u, "The model page has an item per model");
+static constexpr UiC_ComponentLayout_t modelLayout[] PROGMEM =
+{
+    {UIC_COMPONENT_MENU_LIST,  0,  0,  UIM_BIND_MODEL_MENU,   "",     NULL,        &UiContextManager.globals.modelMenuSelection},
+    {UIC_COMPONENT_MENU_ITEM,  3,  20, UIM_BIND_NONE,         "Mdl1", selectModel, NULL},
+    {UIC_COMPONENT_MENU_ITEM,  3,  27, UIM_BIND_NONE,         "Mdl2", selectModel, NULL},
+    {UIC_COMPONENT_MENU_ITEM,  3,  34, UIM_BIND_NONE,         "Mdl3", selectModel, NULL},
+    {UIC_COMPONENT_MENU_ITEM,  3,  41, UIM_BIND_NONE,         "Mdl4", selectModel, NULL},
+    {UIC_COMPONENT_FLASH_TEXT, 55, 5,  UIM_BIND_NONE,         "Act:", NULL,        NULL},
+    {UIC_COMPONENT_TEXT,       55, 15, UIM_BIND_ACTIVE_MODEL, "",     NULL,        NULL}
+};
+#endif
+
+// Mix table edition, one rule field at a time. One row per field: name, value. Values are filled in by updateMixPage
+#define UIM_MIX_ROW(field, name) \
+    {UIC_COMPONENT_MENU_ITEM, 3, (uint8_t)((field) * 7 + 8), UIM_BIND_NONE, name, toggleMixFieldEdit, NULL}
+
+static_assert(N_MIX_FIELDS == 8u, "The mix page has a row per field");
+static constexpr UiC_ComponentLayout_t mixLayout[] PROGMEM =
+{
+    {UIC_COMPONENT_MENU_LIST,  0,  0,  UIM_BIND_MIX_MENU,                                          "",    NULL, &UiContextManager.globals.mixMenuSelection},
+    UIM_MIX_ROW(MIX_FIELD_RULE,        "Rul"),
+    UIM_MIX_ROW(MIX_FIELD_SOURCE,      "Src"),
+    UIM_MIX_ROW(MIX_FIELD_DESTINATION, "Dst"),
+    UIM_MIX_ROW(MIX_FIELD_WEIGHT,      "Wgt"),
+    UIM_MIX_ROW(MIX_FIELD_OFFSET,      "Ofs"),
+    UIM_MIX_ROW(MIX_FIELD_CURVE,       "Crv"),
+    UIM_MIX_ROW(MIX_FIELD_POINT,       "Pt"),
+    UIM_MIX_ROW(MIX_FIELD_POINT_VALUE, "Val"),
+    {UIC_COMPONENT_TEXT,       30, 8,  UIM_BIND_MIX_VALUE + MIX_FIELD_RULE,        "", NULL, NULL},
+    {UIC_COMPONENT_TEXT,       30, 15, UIM_BIND_MIX_VALUE + MIX_FIELD_SOURCE,      "", NULL, NULL},
+    {UIC_COMPONENT_TEXT,       30, 22, UIM_BIND_MIX_VALUE + MIX_FIELD_DESTINATION, "", NULL, NULL},
+    {UIC_COMPONENT_TEXT,       30, 29, UIM_BIND_MIX_VALUE + MIX_FIELD_WEIGHT,      "", NULL, NULL},
+    {UIC_COMPONENT_TEXT,       30, 36, UIM_BIND_MIX_VALUE + MIX_FIELD_OFFSET,      "", NULL, NULL},
+    {UIC_COMPONENT_TEXT,       30, 43, UIM_BIND_MIX_VALUE + MIX_FIELD_CURVE,       "", NULL, NULL},
+    {UIC_COMPONENT_TEXT,       30, 50, UIM_BIND_MIX_VALUE + MIX_FIELD_POINT,       "", NULL, NULL},
+    {UIC_COMPONENT_TEXT,       30, 57, UIM_BIND_MIX_VALUE + MIX_FIELD_POINT_VALUE, "", NULL, NULL},
+    {UIC_COMPONENT_FLASH_TEXT, 90, 8,  UIM_BIND_MIX_TITLE,                         "Mix", NULL, NULL}
+};
+
+#if FREQUENCY_HOPPING == ON
+// Startup scan: received power per channel, hop channels marked below the baseline
+static constexpr UiC_ComponentLayout_t rfLayout[] PROGMEM =
+{
+    {UIC_COMPONENT_FLASH_TEXT, 1,   7,  UIM_BIND_NONE,     "RF scan", NULL, NULL},
+    {UIC_COMPONENT_TEXT,       100, 7,  UIM_BIND_RF_STATE, "",        NULL, NULL},
+    {UIC_COMPONENT_BAR_GRAPH,  1,   14, UIM_BIND_RF_SCAN,  "",        NULL, NULL},
+    {UIC_COMPONENT_FLASH_TEXT, 1,   60, UIM_BIND_NONE,     "0",       NULL, NULL},
+    {UIC_COMPONENT_FLASH_TEXT, 59,  60, UIM_BIND_NONE,     "62",      NULL, NULL},
+    {UIC_COMPONENT_FLASH_TEXT, 115, 60, UIM_BIND_NONE,     "125",     NULL, NULL}
+};
+#endif
+
+/* Page/View declaration. A page is its layout */
+#define UIM_PAGE(layout) {layout, UIC_LAYOUT_LENGTH(layout)}
+static const Page_t monitoringPage    PROGMEM = UIM_PAGE(monitoringLayout);
+static const Page_t optionsPage       PROGMEM = UIM_PAGE(optionsLayout);
+static const Page_t configurationPage PROGMEM = UIM_PAGE(configurationLayout);
+#if LOOP_TIMING == ON
+static const Page_t diagnosticsPage   PROGMEM = UIM_PAGE(diagnosticsLayout);
+#endif
+#if CONFIGURATION_STORAGE == ON
+static const Page_t modelPage         PROGMEM = UIM_PAGE(modelLayout);
+#endif
+static const Page_t mixPage           PROGMEM = UIM_PAGE(mixLayout);
+#if FREQUENCY_HOPPING == ON
+static const Page_t rfPage            PROGMEM = UIM_PAGE(rfLayout);
+#endif
+
+// Pool of the active page components, sized for the largest layout
+#define UIM_LAYOUT_BYTES(layout) u16_UiC_layoutBytes(layout, UIC_LAYOUT_LENGTH(layout))
+#if LOOP_TIMING == ON
+#define UIM_DIAGNOSTICS_BYTES    UIM_LAYOUT_BYTES(diagnosticsLayout)
+#else
+#define UIM_DIAGNOSTICS_BYTES    0u
+#endif
+#if CONFIGURATION_STORAGE == ON
+#define UIM_MODEL_BYTES          UIM_LAYOUT_BYTES(modelLayout)
+#else
+#define UIM_MODEL_BYTES          0u
+#endif
+#if FREQUENCY_HOPPING == ON
+#define UIM_RF_BYTES             UIM_LAYOUT_BYTES(rfLayout)
+#else
+#define UIM_RF_BYTES             0u
+#endif
+
+static constexpr uint16_t u16_UiM_max(uint16_t a, uint16_t b) { return (a > b) ? a : b; }
+#define UIM_COMPONENT_POOL_BYTES u16_UiM_max(u16_UiM_max(u16_UiM_max(UIM_LAYOUT_BYTES(monitoringLayout), UIM_LAYOUT_BYTES(optionsLayout)), \
+                                                         u16_UiM_max(UIM_LAYOUT_BYTES(configurationLayout), UIM_LAYOUT_BYTES(mixLayout))), \
+                                             u16_UiM_max(u16_UiM_max(UIM_DIAGNOSTICS_BYTES, UIM_MODEL_BYTES), UIM_RF_BYTES))
+
+static_assert((UIC_LAYOUT_LENGTH(monitoringLayout) <= MAX_COMPONENTS_PER_VIEW) && (UIC_LAYOUT_LENGTH(mixLayout) <= MAX_COMPONENTS_PER_VIEW), "Too many components in a page");
+#if LOOP_TIMING == ON
+static_assert(UIC_LAYOUT_LENGTH(diagnosticsLayout) <= MAX_COMPONENTS_PER_VIEW, "Too many components in a page");
+#endif
+
+static uint8_t componentPool[UIM_COMPONENT_POOL_BYTES] __attribute__((aligned(UIC_POOL_ALIGN)));
 
 
 void v_UiM_init(UiM_t_rPorts* pReceiverPorts, UiM_t_pPorts* pProviderPorts)
 {
-
-    uint8_t i;
-    
     UiContextManager.rPorts = pReceiverPorts;
     UiContextManager.pPorts = pProviderPorts;
 
     // Initialize UiCore framework. This starts up the display handle and the core context 
-    // (later we can maybe chose the handle to use)
-    v_UiC_init();
-    
-    // Initialize all pages
-    e_UiC_newPage(&monitoringPage);
-    e_UiC_newPage(&optionsPage);
-    e_UiC_newPage(&configurationPage);
+    // (later we can maybe chose the handle to use). Pages are in flash, only the first one is instantiated
+    v_UiC_init(componentPool, sizeof(componentPool));
+    v_UiC_changePage(&monitoringPage);
 
+    Serial.println(UiC_getErrorState());
 
-    // Initialize all components
-    e_UiC_addComponent((Component_t*)&channelChooseMenu,      &monitoringPage, UIC_COMPONENT_MENU_LIST, {0});
-    
-    for(i = 0; i < N_CHANNELS; i++)
-    {
-        uint8_t y = (i*7) + 10; // TODO: Improve this
-        e_UiC_addComponent((Component_t*)&(analogId[i]),       &monitoringPage, UIC_COMPONENT_MENU_ITEM,  {3,  y+5, pReceiverPorts->remoteChannelInputs[i].c_Name, (void*) switchToConfigurationOptionsPage}); // TODO call back needs to be caleld with the parameter to which channel to update.
-        e_UiC_addComponent((Component_t*)&(progressBars[i]),   &monitoringPage, UIC_COMPONENT_ANALOGMONITOR, {18, y});
+}
 
-    }
-    
-    e_UiC_addComponent((Component_t*)&optionsMenu,             &optionsPage,    UIC_COMPONENT_MENU_LIST, {0});
-    e_UiC_addComponent((Component_t*)&(options[0]),            &optionsPage,    UIC_COMPONENT_MENU_ITEM, {3, 20, "Trimming", (void*) switchToConfigurationPage});
-    e_UiC_addComponent((Component_t*)&(options[1]),            &optionsPage,    UIC_COMPONENT_MENU_ITEM, {3, 27, "EndPoint",  (void*) switchToConfigurationPage});
-    e_UiC_addComponent((Component_t*)&(options[2]),            &optionsPage,    UIC_COMPONENT_MENU_ITEM, {3, 34, "Invert",   (void*) switchToConfigurationPage});
-    e_UiC_addComponent((Component_t*)&(configurationMainTitle),&configurationPage,  UIC_COMPONENT_TEXT, {55, 5, ""});
-    e_UiC_addComponent((Component_t*)&(configurationSubTitle), &configurationPage,  UIC_COMPONENT_TEXT, {55, 15, ""});
-    e_UiC_addComponent((Component_t*)&(endpointPercentage),    &configurationPage,  UIC_COMPONENT_TEXT, {60, 40, "25%%"});
+void v_UiM_printMemoryReport(Print* pOutput)
+{
+    v_UiC_printMemoryReport(pOutput);
+    pOutput->print(F("Monitoring: "));
+    v_UiC_printPageMemory(pOutput, &monitoringPage);
+    pOutput->print(F("Options: "));
+    v_UiC_printPageMemory(pOutput, &optionsPage);
+    pOutput->print(F("Configuration: "));
+    v_UiC_printPageMemory(pOutput, &configurationPage);
+#if LOOP_TIMING == ON
+    pOutput->print(F("Diagnostics: "));
+    v_UiC_printPageMemory(pOutput, &diagnosticsPage);
+#endif
+#if CONFIGURATION_STORAGE == ON
+    pOutput->print(F("Model: "));
+    v_UiC_printPageMemory(pOutput, &modelPage);
+#endif
+    pOutput->print(F("Mix: "));
+    v_UiC_printPageMemory(pOutput, &mixPage);
+#if FREQUENCY_HOPPING == ON
+    pOutput->print(F("RF: "));
+    v_UiC_printPageMemory(pOutput, &rfPage);
+#endif
+}
 
-    
 
-    // DEBUG    
-    e_UiC_addComponent((Component_t*) &(testButton1),          &optionsPage,     UIC_COMPONENT_TEXT, {35, 5, ""});
-    e_UiC_addComponent((Component_t*) &(testButton2),          &monitoringPage,  UIC_COMPONENT_TEXT, {35, 5, ""});
-    e_UiC_addComponent((Component_t*) &(communicationState),   &monitoringPage,  UIC_COMPONENT_TEXT,  {1, 5, "NoComm"});
-    
-    e_UiC_addComponent((Component_t*) &(adjustmentBar),        &configurationPage,  UIC_COMPONENT_ANALOGADJUSTMENT,  {2, 30});
+void v_UiM_update()
+{
+    // Process input buttons
+    v_UiM_processUIManagementInputs(UiContextManager.rPorts->uiManagementInputs);
 
+    // The display is drawn a strip at a time over several update calls. Components are only updated between frames,
+    // so every frame is drawn from one consistent state.
+    if(!b_UiC_isFrameInProgress())
+    {
+        v_UiM_updateComponents();
+        v_UiM_updateProviderPorts();
+        v_UiM_clearLatchedInputs(UiContextManager.rPorts->uiManagementInputs);
+    }
 
-    Serial.println(UiC_getErrorState());
+    // Draw current active page and, once the frame is finished, process the next page
+    DIAG_STAGE_BEGIN(DIAG_STAGE_UI_DRAW);
+    v_UiC_draw();
+    DIAG_STAGE_END(DIAG_STAGE_UI_DRAW);
+#if LOOP_TIMING == ON
+    uint32_t frameTime;
+    if(b_UiC_takeFrameTime(&frameTime))
+    {
+        DIAG_RECORD_DURATION(DIAG_STAGE_UI_FRAME, frameTime);
+    }
+#endif
 
+    if(!b_UiC_isFrameInProgress())
+    {
+        v_UiM_processPageChange();
+    }
 }
 
 
-void v_UiM_update()
+static void v_UiM_updateComponents(void)
 {
     char commStateStr[MAX_NR_CHARS] = "NCom";
-    char tb1[7];
+#if CONFIGURATION_STORAGE == ON
+    char modelStr[MAX_NR_CHARS];
+#endif
+    char tb1[MAX_NR_CHARS];
     uint8_t i;
+    const UiM_t_Inputs* pInputs = UiContextManager.rPorts->uiManagementInputs;
+    UiM_ButtonMask_t    buttons = pInputs->buttons;
+    // Up and down auto repeat when their button has a repeat timing, for fast scrolling
+    UiC_Input_t         menuInput = {(pInputs->repeated & UIM_BUTTON_MASK(UIM_BUTTON_LEFT))   != 0u,
+                                     (pInputs->repeated & UIM_BUTTON_MASK(UIM_BUTTON_RIGHT))  != 0u,
+                                     (pInputs->pressed  & UIM_BUTTON_MASK(UIM_BUTTON_SELECT)) != 0u};
     // DEBUG
-    snprintf(tb1, 7, "%d %d %d", UiContextManager.rPorts->uiManagementInputs->inputButtonLeft, 
-                                 UiContextManager.rPorts->uiManagementInputs->inputButtonSelect, 
-                                 UiContextManager.rPorts->uiManagementInputs->inputButtonRight);
-    buildCommunicationString(UiContextManager.rPorts->remoteCommState->b_ConnectionLost, UiContextManager.rPorts->remoteCommState->l_TransmissionTime, commStateStr);
-    
-    // Process input buttons
-    v_UiM_processUIManagementInputs(UiContextManager.rPorts->uiManagementInputs);
+    snprintf(tb1, MAX_NR_CHARS, "%u%u%u", (buttons >> UIM_BUTTON_LEFT) & 1u, (buttons >> UIM_BUTTON_SELECT) & 1u, (buttons >> UIM_BUTTON_RIGHT) & 1u);
+    buildCommunicationString(UiContextManager.rPorts->remoteCommState->b_ConnectionLost, UiContextManager.rPorts->remoteCommState->u16_LatencyP50, commStateStr);
 
     // Update pages (Temporary: for now, on every page, if I hold the Left button it goes back to monitoring
-    if(UiContextManager.rPorts->uiManagementInputs->holdButtonLeft)
+    if(pInputs->held & UIM_BUTTON_MASK(UIM_BUTTON_LEFT))
     {
         v_UiM_requestPageChange(&monitoringPage);
     }
@@ -153,44 +440,46 @@ void v_UiM_update()
     // Update all components with received data
     for(i = 0; i < N_CHANNELS; i++)
     {
-        v_UiC_updateComponent((Component_t*) &(progressBars[i]), &(UiContextManager.rPorts->remoteChannelInputs[i].u16_Value));
+        v_UiC_updateComponent(UIM_BIND_CHANNEL_BAR + i, &(UiContextManager.rPorts->remoteChannelInputs[i].u16_Value));
     }
 
     // TODO: Maybe menu items can received the same exact struct as the uiManagementInputs?
-    v_UiC_updateComponent((Component_t*) &optionsMenu,          &(UiC_Input_t){UiContextManager.rPorts->uiManagementInputs->risingEdgeButtonLeft, 
-                                                                               UiContextManager.rPorts->uiManagementInputs->risingEdgeButtonRight, 
-                                                                               UiContextManager.rPorts->uiManagementInputs->risingEdgeButtonSelect});
-
-    v_UiC_updateComponent((Component_t*) &channelChooseMenu,    &(UiC_Input_t){UiContextManager.rPorts->uiManagementInputs->risingEdgeButtonLeft, 
-                                                                               UiContextManager.rPorts->uiManagementInputs->risingEdgeButtonRight, 
-                                                                               UiContextManager.rPorts->uiManagementInputs->risingEdgeButtonSelect});
-    v_UiC_updateComponent((Component_t*) &(communicationState), (void*) commStateStr);
-    v_UiC_updateComponent((Component_t*) &(testButton1),        (void*) tb1);
-    v_UiC_updateComponent((Component_t*) &(testButton2),        (void*) tb1);
-
-
-
-    updateAdjustmentMonitors(&(UiContextManager.rPorts->uiManagementInputs->scrollWheelLeft), UiContextManager.rPorts->uiManagementInputs->holdButtonSelect);
-
-
-    v_UiM_updateProviderPorts();
-
-    // Draw current active page and process the next page
-
-    v_UiC_draw();
-
-    v_UiM_processPageChange();
-
+    v_UiC_updateComponent(UIM_BIND_OPTIONS_MENU,   &menuInput);
+
+    v_UiC_updateComponent(UIM_BIND_CHANNEL_MENU,   &menuInput);
+#if CONFIGURATION_STORAGE == ON
+    v_UiC_updateComponent(UIM_BIND_MODEL_MENU,     &menuInput);
+    snprintf(modelStr, MAX_NR_CHARS, "Mdl%c", (char)('1' + UiContextManager.rPorts->activeModel)); // As named on the model page, one digit
+    v_UiC_updateComponent(UIM_BIND_ACTIVE_MODEL,   (void*) modelStr);
+#endif
+    updateChannelNames(UiContextManager.rPorts->remoteChannelInputs); // Every model has its own names
+    v_UiC_updateComponent(UIM_BIND_COMM_STATE,     (void*) commStateStr);
+    updateLinkQuality(UiContextManager.rPorts->remoteCommState);
+    v_UiC_updateComponent(UIM_BIND_TEST_BUTTONS,   (void*) tb1);
+
+
+
+    updateAdjustmentMonitors(&(UiContextManager.rPorts->uiManagementInputs->scrollWheelLeft), (pInputs->held & UIM_BUTTON_MASK(UIM_BUTTON_SELECT)) != 0u);
+#if LOOP_TIMING == ON
+    updateDiagnosticsPage(UiContextManager.rPorts->loopStats);
+#endif
+    updateMixPage(UiContextManager.rPorts->mixConfig, pInputs->scrollWheelLeft, &menuInput);
+#if FREQUENCY_HOPPING == ON
+    updateRfPage();
+#endif
 }
 
 
 static void v_UiM_updateProviderPorts(void)
 {
-    bool trimmingSelected = UiContextManager.globals.configurationMenuSelectedOptionIdx == 0; // TODO: Replace with macro instead of magic 0
+    // Trimming and curve adjustments are applied live, so the output keeps being sent while they are edited
+    bool liveAdjustmentSelected = (UiContextManager.globals.configurationMenuSelectedOptionIdx == OPTION_IDX_TRIMMING) ||
+                                  (UiContextManager.globals.configurationMenuSelectedOptionIdx == OPTION_IDX_EXPO)     ||
+                                  (UiContextManager.globals.configurationMenuSelectedOptionIdx == OPTION_IDX_RATE);
 
     // For now, updates the "analogSendAllowed" based on the current page.
     UiContextManager.pPorts->analogSendAllowed = false;
-    Page_t* activePage = UiC_getActivePage();
+    const Page_t* activePage = UiC_getActivePage();
 
     if(activePage == &monitoringPage)
     {
@@ -199,7 +488,7 @@ static void v_UiM_updateProviderPorts(void)
     }
     else if(activePage == &configurationPage)
     {
-        if(trimmingSelected)
+        if(liveAdjustmentSelected)
         {
             UiContextManager.pPorts->analogSendAllowed = true;
         }
@@ -209,58 +498,88 @@ static void v_UiM_updateProviderPorts(void)
 
 static void v_UiM_processUIManagementInputs(UiM_t_Inputs* uiInputs)
 {  
-    // TODO: Improve this and make it more generic so different uis can simply have an arbitrary nr of buttons. Code is the same for every one anyway,
-    static unsigned long timeHoldingSelect = 0;
-    static unsigned long timeHoldingLeft   = 0;
-    static unsigned long timeHoldingRight  = 0;
-
-    static bool holdPreviouslyTriggeredSelect = false;
-    static bool holdPreviouslyTriggeredLeft = false;
-    static bool holdPreviouslyTriggeredRight = false;
-
-    uiInputs->risingEdgeButtonSelect       = b_UiM_risingEdge(uiInputs->prevButtonSelect,   uiInputs->inputButtonSelect, HIGH);
-    uiInputs->risingEdgeButtonLeft         = b_UiM_risingEdge(uiInputs->prevButtonLeft,     uiInputs->inputButtonLeft,   HIGH);
-    uiInputs->risingEdgeButtonRight        = b_UiM_risingEdge(uiInputs->prevButtonRight,    uiInputs->inputButtonRight,  HIGH);
-    
-    uiInputs->holdButtonSelect             = b_UiM_buttonHold(uiInputs->risingEdgeButtonSelect, uiInputs->inputButtonSelect, &timeHoldingSelect, &holdPreviouslyTriggeredSelect);
-    uiInputs->holdButtonLeft               = b_UiM_buttonHold(uiInputs->risingEdgeButtonLeft,   uiInputs->inputButtonLeft,   &timeHoldingLeft,   &holdPreviouslyTriggeredLeft);
-    uiInputs->holdButtonRight              = b_UiM_buttonHold(uiInputs->risingEdgeButtonRight,  uiInputs->inputButtonRight,  &timeHoldingRight,  &holdPreviouslyTriggeredRight);
-
-    // Update button states for next cycle
-    uiInputs->prevButtonSelect             = uiInputs->inputButtonSelect;
-    uiInputs->prevButtonLeft               = uiInputs->inputButtonLeft;
-    uiInputs->prevButtonRight              = uiInputs->inputButtonRight;
-
+#if BUTTON_EVENTS == ON
+    // Every press since the last update is queued, however short it was and however long the loop took. Each one is
+    // processed at its own time, holds and repeats then come from the timings of UiM
+    BtnEvent_t event;
+    while(b_Btn_takeEvent(&event))
+    {
+        if(event.u8_Type == BTN_EVENT_PRESS)
+        {
+            uiInputs->buttons |= UIM_BUTTON_MASK(event.u8_Button);
+        }
+        else
+        {
+            uiInputs->buttons &= (UiM_ButtonMask_t)~UIM_BUTTON_MASK(event.u8_Button);
+        }
+        v_UiM_processButtons(uiInputs, uiInputs->buttons, event.u16_Time);
+    }
+#endif
+    v_UiM_processButtons(uiInputs, uiInputs->buttons, (uint16_t)millis()); // Holds and repeats of the buttons still pressed
 }
 
-static bool b_UiM_risingEdge(uint8_t prevValue, uint8_t currentValue, uint8_t desiredEdge)
+static void v_UiM_processButtons(UiM_t_Inputs* uiInputs, UiM_ButtonMask_t buttons, uint16_t now)
 {
-    return (prevValue != currentValue) && (currentValue == desiredEdge);
-}
+    UiM_ButtonMask_t changed = buttons ^ buttonPrev;
+    UiM_ButtonMask_t rising  = changed & buttons;
+    UiM_ButtonMask_t down    = buttons;
+    UiM_ButtonTiming_t timing;
+    uint8_t i;
 
-static bool b_UiM_buttonHold(bool risingEdge, bool currentValue, unsigned long* timeHolding, bool* holdPreviouslyTriggered)
-{
-    if(risingEdge)
-    {
-        *timeHolding = millis();
-        *holdPreviouslyTriggered = false;
-    }
+    // Latched (OR-ed) until consumed, a press happening while a frame is being drawn isn't lost
+    uiInputs->pressed  |= rising;
+    uiInputs->repeated |= rising; // The press is the first repeat
+    buttonHoldArmed     = (buttonHoldArmed | rising) & buttons;
+    buttonPrev          = buttons;
 
-    if(((millis() - *timeHolding) > 1500) && (currentValue == HIGH) && (!(*holdPreviouslyTriggered)))
+    for(i = 0; down != 0u; i++, down >>= 1)
     {
-        *holdPreviouslyTriggered = true;
-        return true;
-    }
+        if(!(down & 1u))
+        {
+            continue;
+        }
+        UiM_ButtonMask_t mask = UIM_BUTTON_MASK(i);
+        memcpy_P(&timing, &buttonTimings[i], sizeof(timing));
 
-    if(currentValue == LOW)
-    {
-        *holdPreviouslyTriggered = false; // Reset the flag so we can trigger holds again.
+        if(rising & mask)
+        {
+            if((buttonClickArmed & mask) && ((uint16_t)(now - buttonPressTime[i]) <= timing.u16_DoubleClickMs))
+            {
+                uiInputs->doubleClicked |= mask;
+                buttonClickArmed        &= (UiM_ButtonMask_t)~mask;
+            }
+            else if(timing.u16_DoubleClickMs != 0u)
+            {
+                buttonClickArmed |= mask;
+            }
+            buttonPressTime[i]  = now;
+            buttonNextRepeat[i] = now + timing.u16_RepeatDelayMs;
+            continue;
+        }
+
+        if((buttonHoldArmed & mask) && (timing.u16_HoldMs != 0u) && ((uint16_t)(now - buttonPressTime[i]) >= timing.u16_HoldMs))
+        {
+            uiInputs->held   |= mask;
+            buttonHoldArmed  &= (UiM_ButtonMask_t)~mask;
+            buttonClickArmed &= (UiM_ButtonMask_t)~mask; // A hold is not a click
+        }
+        if((timing.u16_RepeatDelayMs != 0u) && ((int16_t)(now - buttonNextRepeat[i]) >= 0))
+        {
+            uiInputs->repeated  |= mask;
+            buttonNextRepeat[i] += timing.u16_RepeatPeriodMs;
+        }
     }
+}
 
-    return false;
+static void v_UiM_clearLatchedInputs(UiM_t_Inputs* uiInputs)
+{
+    uiInputs->pressed       = 0u;
+    uiInputs->repeated      = 0u;
+    uiInputs->held          = 0u;
+    uiInputs->doubleClicked = 0u;
 }
 
-static void v_UiM_requestPageChange(Page_t* page)
+static void v_UiM_requestPageChange(const Page_t* page)
 {
     UiContextManager.globals.nextPageRequest = page;
 }
@@ -281,24 +600,87 @@ static void v_UiM_processPageChange()
 
 
 /** Project specific **/
-static void buildCommunicationString(bool connectionDropped, unsigned long txTime, char* commStateString)
+static void buildCommunicationString(bool connectionDropped, uint16_t latency, char* commStateString)
 {
     if(!connectionDropped)
     {
-        txTime *= 0.001; // Conversion from us to ms
-        snprintf(commStateString, MAX_NR_CHARS, "%lums", txTime);
+        buildLatencyString(latency, commStateString); // Median time to ACK
+    }
+}
+
+// Milliseconds with one decimal below 10ms ("0.6m"), whole milliseconds above ("12m")
+static void buildLatencyString(uint16_t latency, char* latencyStr)
+{
+    if(latency < 10000u)
+    {
+        uint8_t tenths = (uint8_t)(latency / 100u); // Below 100 here
+        snprintf(latencyStr, MAX_NR_CHARS, "%u.%um", tenths / 10u, tenths % 10u);
+    }
+    else
+    {
+        snprintf(latencyStr, MAX_NR_CHARS, "%um", latency / 1000u);
+    }
+}
+
+static void updateLinkQuality(const RemoteCommunicationState_t* pCommState)
+{
+    char latencyStr[MAX_NR_CHARS] = "";
+    char lossStr[MAX_NR_CHARS]    = "";
+    char retriesStr[MAX_NR_CHARS] = "";
+    char voltageStr[MAX_NR_CHARS] = "";
+
+    if(!pCommState->b_ConnectionLost)
+    {
+        buildLatencyString(pCommState->u16_LatencyP95, latencyStr);
+        snprintf(lossStr, MAX_NR_CHARS, "%u%%", pCommState->u8_LossPercent);
+        if(pCommState->u8_RetriesX10 < 100u)
+        {
+            snprintf(retriesStr, MAX_NR_CHARS, "r%u.%u", pCommState->u8_RetriesX10 / 10u, pCommState->u8_RetriesX10 % 10u);
+        }
+        else
+        {
+            snprintf(retriesStr, MAX_NR_CHARS, "r%u", pCommState->u8_RetriesX10 / 10u);
+        }
+    }
+    if(pCommState->b_TelemetryValid && (pCommState->u16_RxVoltage != 0u))
+    {
+        if(pCommState->u16_RxVoltage < 10000u)
+        {
+            uint8_t tenths = (uint8_t)(pCommState->u16_RxVoltage / 100u); // Below 100 here
+            snprintf(voltageStr, MAX_NR_CHARS, "%u.%uV", tenths / 10u, tenths % 10u);
+        }
+        else
+        {
+            snprintf(voltageStr, MAX_NR_CHARS, "%uV", pCommState->u16_RxVoltage / 1000u);
+        }
+    }
+
+    v_UiC_updateComponent(UIM_BIND_LINK_LATENCY,     (void*) latencyStr);
+    v_UiC_updateComponent(UIM_BIND_LINK_LOSS,        (void*) lossStr);
+    v_UiC_updateComponent(UIM_BIND_LINK_RETRIES,     (void*) retriesStr);
+    v_UiC_updateComponent(UIM_BIND_RECEIVER_VOLTAGE, (void*) voltageStr);
+}
+
+// Channel menu items take their name as update. Only a change is redrawn
+static void updateChannelNames(const RemoteChannelInput_t* pChannels)
+{
+    uint8_t i;
+    for(i = 0; i < N_CHANNELS; i++)
+    {
+        v_UiC_updateComponent(UIM_BIND_CHANNEL_NAME + i, (void*) pChannels[i].c_Name);
     }
 }
 
 static void buildEndpointPercentageString(uint16_t endpointAdjustmentValue, char* endpointAdjustmentStr)
 {
-    snprintf(endpointAdjustmentStr, MAX_NR_CHARS, "%d%%", (abs(((int32_t)endpointAdjustmentValue-ANALOG_HALF_VALUE))*100)/ANALOG_HALF_VALUE);
+    uint8_t percentage = (uint8_t)((abs(((int32_t)endpointAdjustmentValue-ANALOG_HALF_VALUE))*100)/ANALOG_HALF_VALUE); // 0 - 100
+    snprintf(endpointAdjustmentStr, MAX_NR_CHARS, "%u%%", percentage);
 }
 
 
 static void switchToConfigurationOptionsPage(void* selectedChannelIdx)
 {
-    UiContextManager.globals.channelMenuSelectedOptionIdx = (uint8_t) selectedChannelIdx;
+    UiContextManager.globals.channelMenuSelectedOptionIdx = (uint8_t)(uintptr_t)selectedChannelIdx;
     v_UiM_requestPageChange(&optionsPage);
 }
 
@@ -306,15 +688,37 @@ static void switchToConfigurationPage(void* selectedConfigurationIdx)
 {
     // If the selected option is invert, no need to go to the adjustment/configuration page. Simply
     // call the configuration update functions and go to the main page.
-    if((uint8_t) selectedConfigurationIdx == 2) // TODO: replace with macro instead of magic 0
+    if((uint8_t)(uintptr_t)selectedConfigurationIdx == OPTION_IDX_INVERT)
     {
         updateRemoteConfigurationInvert(UiContextManager.globals.channelMenuSelectedOptionIdx);
         v_UiM_requestPageChange(&monitoringPage);
     }
+#if LOOP_TIMING == ON
+    else if((uint8_t)(uintptr_t)selectedConfigurationIdx == OPTION_IDX_DIAG) // Not a channel configuration, simply show the diagnostics page
+    {
+        v_UiM_requestPageChange(&diagnosticsPage);
+    }
+#endif
+#if CONFIGURATION_STORAGE == ON
+    else if((uint8_t)(uintptr_t)selectedConfigurationIdx == OPTION_IDX_MODEL) // Not a channel configuration either
+    {
+        v_UiM_requestPageChange(&modelPage);
+    }
+#endif
+    else if((uint8_t)(uintptr_t)selectedConfigurationIdx == OPTION_IDX_MIX) // The mix table isn't per channel
+    {
+        v_UiM_requestPageChange(&mixPage);
+    }
+#if FREQUENCY_HOPPING == ON
+    else if((uint8_t)(uintptr_t)selectedConfigurationIdx == OPTION_IDX_RF)
+    {
+        v_UiM_requestPageChange(&rfPage);
+    }
+#endif
     else
     {
         v_UiM_requestPageChange(&configurationPage);
-        UiContextManager.globals.configurationMenuSelectedOptionIdx = (uint8_t) selectedConfigurationIdx;
+        UiContextManager.globals.configurationMenuSelectedOptionIdx = (uint8_t)(uintptr_t)selectedConfigurationIdx;
     }
     
 }
@@ -328,7 +732,10 @@ static void updateAdjustmentMonitors(uint16_t* adjustmentWheel, uint16_t updateN
     static uint16_t lastValueBeforeUpdating = (*adjustmentWheel);
     static bool     updateNextValue         = false;
     static bool     invalidConfiguration    = false;
-    bool            trimmingSelected        = UiContextManager.globals.configurationMenuSelectedOptionIdx == 0; // TODO: Replace with macro instead of magic 0
+    bool            trimmingSelected        = UiContextManager.globals.configurationMenuSelectedOptionIdx == OPTION_IDX_TRIMMING;
+    bool            curveSelected           = (UiContextManager.globals.configurationMenuSelectedOptionIdx == OPTION_IDX_EXPO) || 
+                                              (UiContextManager.globals.configurationMenuSelectedOptionIdx == OPTION_IDX_RATE);
+    uint8_t         curvePercentage         = (uint8_t)(((uint32_t)(*adjustmentWheel) * CURVE_MAX_PERCENT) / ANALOG_MAX_VALUE);
     bool            shouldContinue          = !updateNextValue && updateNextValueButton;  // Whether or not to continue through. Trimming page will end the edit and endpoint will select the next point to adjust. 
     bool            adjustmentFinished      = updateNextValue && updateNextValueButton; // If we are already in next value and hold button is pressed, adjustment is finished.
     if(UiC_getActivePage() == &configurationPage)
@@ -356,6 +763,16 @@ static void updateAdjustmentMonitors(uint16_t* adjustmentWheel, uint16_t updateN
             
             updateValue = ((((uint32_t)*adjustmentWheel) << 16) | ((uint32_t)*adjustmentWheel & 0xFFFF));
         }
+        else if(curveSelected)
+        {
+            // Live update as well. The curve table of the channel is only rebuilt when the percentage actually changes
+            updateRemoteConfigurationCurve(UiContextManager.globals.channelMenuSelectedOptionIdx, UiContextManager.globals.configurationMenuSelectedOptionIdx, curvePercentage);
+            if(shouldContinue)
+            {
+                v_UiM_requestPageChange(&monitoringPage);
+            }
+            updateValue = ((((uint32_t)*adjustmentWheel) << 16) | ((uint32_t)*adjustmentWheel & 0xFFFF));
+        }
         else // Otherwise, we must be in endpoint adjustment, since invert was taken care on the first page switch.
         {
             if(shouldContinue) // If hold button is clicked, go to next value adjustment and update the lastValue.
@@ -382,9 +799,16 @@ static void updateAdjustmentMonitors(uint16_t* adjustmentWheel, uint16_t updateN
             updateValue = updateNextValue ? ((((uint32_t)*adjustmentWheel) << 16) | ((uint32_t)lastValueBeforeUpdating & 0xFFFF)) : (uint32_t)(*adjustmentWheel); // TODO: complex expression, wrap some macros for bit management here
         }
 
-        v_UiC_updateComponent((Component_t*) &(adjustmentBar), (void*) (&updateValue));
-        buildEndpointPercentageString(*adjustmentWheel, endpointPercentageString);
-        v_UiC_updateComponent((Component_t*) &(endpointPercentage), (void*) endpointPercentageString);
+        v_UiC_updateComponent(UIM_BIND_ADJUSTMENT_BAR, (void*) (&updateValue));
+        if(curveSelected)
+        {
+            snprintf(endpointPercentageString, MAX_NR_CHARS, "%d%%", curvePercentage);
+        }
+        else
+        {
+            buildEndpointPercentageString(*adjustmentWheel, endpointPercentageString);
+        }
+        v_UiC_updateComponent(UIM_BIND_ENDPOINT_PERCENTAGE, (void*) endpointPercentageString);
     }
     else
     {
@@ -393,8 +817,9 @@ static void updateAdjustmentMonitors(uint16_t* adjustmentWheel, uint16_t updateN
     }
 
     // If we have an invalid configuration after trying to continue, display 'Invalid Configuration'
-    v_UiC_updateComponent((Component_t*)&(configurationMainTitle), (void*) (invalidConfiguration ? "Invd" : options[UiContextManager.globals.configurationMenuSelectedOptionIdx].itemText));
-    v_UiC_updateComponent((Component_t*)&(configurationSubTitle),  (void*) (invalidConfiguration ? "Cfg"  : analogId[UiContextManager.globals.channelMenuSelectedOptionIdx].itemText));
+    // The title is the option name, straight from the options layout
+    v_UiC_updateComponent(UIM_BIND_CONFIG_TITLE,    (void*) (invalidConfiguration ? F("Invd") : (const __FlashStringHelper*) optionsLayout[OPTIONS_LAYOUT_ITEM(UiContextManager.globals.configurationMenuSelectedOptionIdx)].text));
+    v_UiC_updateComponent(UIM_BIND_CONFIG_SUBTITLE, (void*) (invalidConfiguration ? "Cfg"  : UiContextManager.rPorts->remoteChannelInputs[UiContextManager.globals.channelMenuSelectedOptionIdx].c_Name));
 }
 
 
@@ -419,9 +844,237 @@ static void updateRemoteConfigurationInvert(uint8_t channelIdx)
     UiContextManager.pPorts->configurationUpdated = true;
 }
 
+static void updateRemoteConfigurationCurve(uint8_t channelIdx, uint8_t curveOptionIdx, uint8_t newPercentage)
+{
+    uint8_t* pSetting = (curveOptionIdx == OPTION_IDX_EXPO) ? &(UiContextManager.rPorts->remoteChannelInputs[channelIdx].u8_Expo) :
+                                                              &(UiContextManager.rPorts->remoteChannelInputs[channelIdx].u8_Rate);
+    if(*pSetting != newPercentage) // Only flag real changes, every configuration update triggers a curve table rebuild
+    {
+        *pSetting = newPercentage;
+        UiContextManager.pPorts->configurationUpdated = true;
+    }
+}
+
 static bool isConfigurationValid(uint16_t trimming, uint16_t endpointLow, uint16_t endpointUpper)
 {
 
     return ((trimming > endpointLow) && (trimming < endpointUpper)); // This condition should be sufficient to ensure than endpoint low is lower than upper, as well.
 
-}
\ No newline at end of file
+}
+
+#if LOOP_TIMING == ON
+static void updateDiagnosticsPage(const DiagLoopStats_t* pLoopStats)
+{
+    char    valueStr[MAX_NR_CHARS];
+    uint8_t i;
+    if(UiC_getActivePage() != &diagnosticsPage) // Formatting all the strings isn't free, skip it when nobody looks at them
+    {
+        return;
+    }
+
+    for(i = 0; i < N_DIAG_PAGE_STAGES; i++)
+    {
+        buildDurationString(u32_Diag_getStageMean(diagPageStages[i]), valueStr);
+        v_UiC_updateComponent(UIM_BIND_DIAG_MEAN + i, (void*) valueStr);
+        buildDurationString(pLoopStats->stages[diagPageStages[i]].u16_Count ? pLoopStats->stages[diagPageStages[i]].u32_Max : 0ul, valueStr);
+        v_UiC_updateComponent(UIM_BIND_DIAG_MAX + i, (void*) valueStr);
+    }
+
+    buildRateString(pLoopStats->u16_LoopHz, valueStr);
+    v_UiC_updateComponent(UIM_BIND_DIAG_LOOP_RATE, (void*) valueStr);
+    buildRateString(pLoopStats->u16_TxHz, valueStr);
+    v_UiC_updateComponent(UIM_BIND_DIAG_TX_RATE, (void*) valueStr);
+    snprintf(valueStr, MAX_NR_CHARS, "%u%%", pLoopStats->u8_AckPercent);
+    v_UiC_updateComponent(UIM_BIND_DIAG_ACK_RATIO, (void*) valueStr);
+    snprintf(valueStr, MAX_NR_CHARS, "%u", min(pLoopStats->u16_Overruns, (uint16_t)9999u)); // 4 digits at most
+    v_UiC_updateComponent(UIM_BIND_DIAG_OVERRUNS, (void*) valueStr);
+}
+
+static void buildDurationString(uint32_t duration, char* durationStr)
+{
+    if(duration < 10000ul)
+    {
+        snprintf(durationStr, MAX_NR_CHARS, "%lu", (unsigned long)duration);
+    }
+    else
+    {
+        snprintf(durationStr, MAX_NR_CHARS, "%lum", (unsigned long)min(duration / 1000ul, 999ul)); // Conversion from us to ms, 999m at most
+    }
+}
+
+static void buildRateString(uint16_t rate, char* rateStr)
+{
+    if(rate < 10000u)
+    {
+        snprintf(rateStr, MAX_NR_CHARS, "%u", rate);
+    }
+    else
+    {
+        snprintf(rateStr, MAX_NR_CHARS, "%uk", rate / 1000u);
+    }
+}
+#endif
+
+#if CONFIGURATION_STORAGE == ON
+// The switch itself happens between two TX frames, once the current model is saved
+static void selectModel(void* selectedModelIdx)
+{
+    UiContextManager.pPorts->requestedModel       = (uint8_t)(uintptr_t)selectedModelIdx;
+    UiContextManager.pPorts->modelChangeRequested = true;
+    v_UiM_requestPageChange(&monitoringPage);
+}
+#endif
+
+
+// Select on a field starts editing it with the scroll wheel, select again ends the edit. The field stays selected
+// in the menu meanwhile
+static void toggleMixFieldEdit(void* selectedFieldIdx)
+{
+    UiContextManager.globals.mixEditedField = (uint8_t)(uintptr_t)selectedFieldIdx;
+    UiContextManager.globals.mixEditing     = !UiContextManager.globals.mixEditing;
+}
+
+static void updateMixPage(MixConfig_t* pMixes, uint16_t editWheel, const UiC_Input_t* pMenuInput)
+{
+    char        fieldStr[MAX_NR_CHARS];
+    UiC_Input_t mixMenuInput;
+    uint8_t     i;
+    if(UiC_getActivePage() != &mixPage)
+    {
+        UiContextManager.globals.mixEditing = false;
+        return;
+    }
+
+    // Left and right would move the selection away from the edited field, only select goes through while editing
+    mixMenuInput.inputUp     = !UiContextManager.globals.mixEditing && pMenuInput->inputUp;
+    mixMenuInput.inputDown   = !UiContextManager.globals.mixEditing && pMenuInput->inputDown;
+    mixMenuInput.inputSelect = pMenuInput->inputSelect;
+    v_UiC_updateComponent(UIM_BIND_MIX_MENU, &mixMenuInput);
+
+    if(UiContextManager.globals.mixEditing && updateMixField(pMixes, UiContextManager.globals.mixEditedField, editWheel))
+    {
+        UiContextManager.pPorts->configurationUpdated = true; // Recompiles the mixer and saves the table
+    }
+
+    for(i = 0; i < N_MIX_FIELDS; i++)
+    {
+        buildMixFieldString(pMixes, i, fieldStr);
+        v_UiC_updateComponent(UIM_BIND_MIX_VALUE + i, (void*) fieldStr);
+    }
+    v_UiC_updateComponent(UIM_BIND_MIX_TITLE, (void*) (UiContextManager.globals.mixEditing ? F("Edit") : F("Mix")));
+}
+
+// Returns true if the mix table itself changed, not only the selected rule or point
+static bool updateMixField(MixConfig_t* pMixes, uint8_t field, uint16_t editWheel)
+{
+    MixRule_t* pRule = &pMixes->rules[UiContextManager.globals.mixSelectedRule];
+    int8_t*    pValue;
+    int16_t    value;
+    switch(field)
+    {
+        case MIX_FIELD_RULE:
+            UiContextManager.globals.mixSelectedRule  = (uint8_t) mapWheelToRange(editWheel, 0, MIX_MAX_RULES - 1);
+            return false;
+        case MIX_FIELD_POINT:
+            UiContextManager.globals.mixSelectedPoint = (uint8_t) mapWheelToRange(editWheel, 0, MIX_CURVE_POINTS - 1);
+            return false;
+        case MIX_FIELD_SOURCE:
+            value = mapWheelToRange(editWheel, 0, N_CHANNELS - 1);
+            if(pRule->u8_Source == value) return false;
+            pRule->u8_Source = (uint8_t) value;
+            return true;
+        case MIX_FIELD_DESTINATION:
+            value = mapWheelToRange(editWheel, 0, N_ANALOG_CHANNELS - 1);
+            if(pRule->u8_Destination == value) return false;
+            pRule->u8_Destination = (uint8_t) value;
+            return true;
+        case MIX_FIELD_CURVE:
+            value = mapWheelToRange(editWheel, 0, MIX_CURVE_COUNT - 1);
+            if(pRule->u8_Curve == value) return false;
+            pRule->u8_Curve = (uint8_t) value;
+            return true;
+        case MIX_FIELD_WEIGHT:
+            pValue = &(pRule->i8_Weight);
+            value  = mapWheelToRange(editWheel, -MIX_MAX_WEIGHT, MIX_MAX_WEIGHT);
+            break;
+        case MIX_FIELD_OFFSET:
+            pValue = &(pRule->i8_Offset);
+            value  = mapWheelToRange(editWheel, -MIX_MAX_OFFSET, MIX_MAX_OFFSET);
+            break;
+        default: // Point value, only rules using a curve table have points to edit
+            if(pRule->u8_Curve < MIX_CURVE_TABLE)
+            {
+                return false;
+            }
+            pValue = &(pMixes->i8_Curves[pRule->u8_Curve - MIX_CURVE_TABLE][UiContextManager.globals.mixSelectedPoint]);
+            value  = mapWheelToRange(editWheel, -MIX_MAX_POINT, MIX_MAX_POINT);
+            break;
+    }
+    if(*pValue == value)
+    {
+        return false;
+    }
+    *pValue = (int8_t) value;
+    return true;
+}
+
+static void buildMixFieldString(const MixConfig_t* pMixes, uint8_t field, char* fieldStr)
+{
+    static const char curveNames[MIX_CURVE_TABLE][MAX_NR_CHARS] PROGMEM = {"Lin", "Pos", "Neg"};
+    const MixRule_t* pRule = &pMixes->rules[UiContextManager.globals.mixSelectedRule];
+    switch(field)
+    {
+        case MIX_FIELD_RULE:        snprintf(fieldStr, MAX_NR_CHARS, "%u", UiContextManager.globals.mixSelectedRule + 1u); break;
+        case MIX_FIELD_SOURCE:      strncpy(fieldStr, UiContextManager.rPorts->remoteChannelInputs[pRule->u8_Source].c_Name, MAX_NR_CHARS); break;
+        case MIX_FIELD_DESTINATION: strncpy(fieldStr, UiContextManager.rPorts->remoteChannelInputs[pRule->u8_Destination].c_Name, MAX_NR_CHARS); break;
+        case MIX_FIELD_WEIGHT:      snprintf(fieldStr, MAX_NR_CHARS, "%d", pRule->i8_Weight); break;
+        case MIX_FIELD_OFFSET:      snprintf(fieldStr, MAX_NR_CHARS, "%d", pRule->i8_Offset); break;
+        case MIX_FIELD_CURVE:
+            if(pRule->u8_Curve < MIX_CURVE_TABLE)
+            {
+                strncpy_P(fieldStr, curveNames[pRule->u8_Curve], MAX_NR_CHARS);
+            }
+            else
+            {
+                snprintf(fieldStr, MAX_NR_CHARS, "C%u", pRule->u8_Curve - MIX_CURVE_TABLE + 1u);
+            }
+            break;
+        case MIX_FIELD_POINT:       snprintf(fieldStr, MAX_NR_CHARS, "%u", UiContextManager.globals.mixSelectedPoint + 1u); break;
+        default:
+            if(pRule->u8_Curve < MIX_CURVE_TABLE)
+            {
+                strncpy(fieldStr, "-", MAX_NR_CHARS);
+            }
+            else
+            {
+                snprintf(fieldStr, MAX_NR_CHARS, "%d", pMixes->i8_Curves[pRule->u8_Curve - MIX_CURVE_TABLE][UiContextManager.globals.mixSelectedPoint]);
+            }
+            break;
+    }
+    fieldStr[MAX_NR_CHARS - 1u] = '\0';
+}
+
+// Equal slices of the wheel travel for every value of [minValue, maxValue]
+static int16_t mapWheelToRange(uint16_t wheel, int16_t minValue, int16_t maxValue)
+{
+    return minValue + (int16_t)(((uint32_t)wheel * (uint32_t)(maxValue - minValue + 1)) / (ANALOG_MAX_VALUE + 1u));
+}
+
+#if FREQUENCY_HOPPING == ON
+static void updateRfPage(void)
+{
+    UiC_BarGraphData_t scan = {u8_getScanBar, HOP_N_SCAN_CHANNELS, 0u}; // The scan only runs at startup, it never changes
+    if(UiC_getActivePage() != &rfPage)
+    {
+        return;
+    }
+    v_UiC_updateComponent(UIM_BIND_RF_STATE, (void*) ((e_Hop_getState() == HOP_HOPPING) ? "Hop" : "Bind"));
+    v_UiC_updateComponent(UIM_BIND_RF_SCAN,  (void*) &scan);
+}
+
+static uint8_t u8_getScanBar(uint8_t channel)
+{
+    uint8_t bar = (uint8_t)(((uint16_t)u8_Hop_getScanLevel(channel) * UIC_BAR_GRAPH_HEIGHT) / HOP_SCAN_MAX_LEVEL);
+    return b_Hop_isHopChannel(channel) ? (uint8_t)(bar | UIC_BAR_GRAPH_MARK) : bar;
+}
+#endif
@@ -25,28 +25,47 @@
 #define UIMANAGEMENT_H
 #include "UiCoreFramework.h"
 #include "Configuration.h"
+#include "Diagnostics.h"
+#include "Mixer.h"
+#include "ButtonEvents.h"
+#include "FrequencyHopping.h"
 
 
 
-// Contains all the inputs the application is able to handle for User Interaction as well as processed versions (rising edge, hold..)
-typedef struct UiM_t_Inputs
+// Button bits of the UiM_t_Inputs masks. With BUTTON_EVENTS ON, the button pins are given to v_Btn_init in this order
+enum UiM_Button
 {
-    // Project specific set of Ui interface
-    uint16_t     inputButtonLeft        : 1;
-    uint16_t     inputButtonRight       : 1;
-    uint16_t     inputButtonSelect      : 1;
+    UIM_BUTTON_LEFT,
+    UIM_BUTTON_RIGHT,
+    UIM_BUTTON_SELECT
+};
 
-    uint16_t     risingEdgeButtonLeft   : 1;
-    uint16_t     risingEdgeButtonRight  : 1;
-    uint16_t     risingEdgeButtonSelect : 1;
+// One bit per button (bit UiM_Button). Every button is processed at once, with word operations. A wider type takes more buttons
+typedef uint8_t UiM_ButtonMask_t;
+#define UIM_BUTTON_MASK(button) ((UiM_ButtonMask_t)(1u << (button)))
 
-    uint16_t     holdButtonLeft         : 1;
-    uint16_t     holdButtonRight        : 1;
-    uint16_t     holdButtonSelect       : 1;
+// Gesture timings of a button, in ms. 0 disables the gesture
+typedef struct UiM_ButtonTiming_t
+{
+    uint16_t u16_HoldMs;            // Held this long after the press
+    uint16_t u16_RepeatDelayMs;     // First auto repeat, after the press
+    uint16_t u16_RepeatPeriodMs;    // Next auto repeats
+    uint16_t u16_DoubleClickMs;     // Between the two presses
+}UiM_ButtonTiming_t;
+
+// Contains all the inputs the application is able to handle for User Interaction as well as processed versions (press, hold..)
+// The application gives the button levels, UiM turns them into gestures. With BUTTON_EVENTS ON, the levels are also
+// filled by UiM from the button events, the application only passes the scroll wheels
+typedef struct UiM_t_Inputs
+{
+    // Project specific set of Ui interface
+    UiM_ButtonMask_t buttons;           // Pressed buttons
 
-    uint16_t     prevButtonLeft         : 1;
-    uint16_t     prevButtonRight        : 1;
-    uint16_t     prevButtonSelect       : 1;
+    // Latched until consumed, once per frame
+    UiM_ButtonMask_t pressed;           // Rising edges
+    UiM_ButtonMask_t repeated;          // Rising edges, then auto repeats while held
+    UiM_ButtonMask_t held;              // Once per press
+    UiM_ButtonMask_t doubleClicked;
 
     uint16_t     scrollWheelLeft; 
     uint16_t     scrollWheelRight; 
@@ -60,6 +79,11 @@ typedef struct UiM_t_rPorts
     UiM_t_Inputs*               uiManagementInputs;
     RemoteChannelInput_t*       remoteChannelInputs;
     RemoteCommunicationState_t* remoteCommState;
+    uint8_t                     activeModel;
+    MixConfig_t*                mixConfig;
+#if LOOP_TIMING == ON
+    const DiagLoopStats_t*      loopStats;
+#endif
 
 }UiM_t_rPorts;
 
@@ -71,6 +95,10 @@ typedef struct UiM_t_pPorts
     // For this particular project we only need a 'configuration updated' flag, since the configuration pointer is passed through the rports
     // This is activated once after a config update and then replaced with 0 again.
     bool configurationUpdated : 1;     
+
+    // Set once when a model is picked on the model page, the application does the switch
+    bool    modelChangeRequested : 1;
+    uint8_t requestedModel       : 3;
 }UiM_t_pPorts;
 
 
@@ -78,12 +106,22 @@ typedef struct UiM_t_pPorts
 typedef struct UiM_t_Globals
 {      
     /** Generic state globals **/
-    Page_t* nextPageRequest; // Holds the next requested page by the UiManager. Page gets changed at the end of the current update cycle
+    const Page_t* nextPageRequest; // Holds the next requested page by the UiManager. Page gets changed at the end of the current update cycle
 
 
     /** Project specific **/
     uint8_t channelMenuSelectedOptionIdx       : 3;
     uint8_t configurationMenuSelectedOptionIdx : 3;
+    uint8_t mixSelectedRule                    : 4;
+    uint8_t mixSelectedPoint                   : 3;
+    uint8_t mixEditedField                     : 3;
+    bool    mixEditing                         : 1; // The scroll wheel sets the edited field of the mix page
+
+    // Selection of each menu, kept while its page isn't instantiated (bound through the page layouts)
+    uint8_t channelMenuSelection;
+    uint8_t optionsMenuSelection;
+    uint8_t modelMenuSelection;
+    uint8_t mixMenuSelection;
 
 }UiM_t_Globals;
 
@@ -114,5 +152,8 @@ typedef struct UiM_t_contextManager
 void v_UiM_init(UiM_t_rPorts* pReceiverPorts, UiM_t_pPorts* pProviderPorts);
 void v_UiM_update();
 
+/// @brief Prints the SRAM used by the Ui: core, component pool and the pool bytes of each page.
+void v_UiM_printMemoryReport(Print* pOutput);
+
 
-#endif;
\ No newline at end of file
+#endif
\ No newline at end of file
@@ -0,0 +1,278 @@
+/**
+ * @file Arduino.cpp
+ * @author Marcelo Fraga
+ * @brief Host implementation of the Arduino core stand-in. See Arduino.h
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "Arduino.h"
+#include <time.h>
+
+static uint16_t      hostAnalogValues[NUM_DIGITAL_PINS];
+static uint8_t       hostDigitalValues[NUM_DIGITAL_PINS];
+static FILE*         hostSerialOutput   = stdout;
+static uint8_t       hostSerialInput[64];
+static uint8_t       hostSerialInputHead = 0;
+static uint8_t       hostSerialInputCount = 0;
+static bool          hostVirtualTime    = false;
+static unsigned long hostVirtualMicros  = 0;
+static uint64_t      hostStartNanos     = 0;
+
+uint8_t           TCCR1A;
+uint8_t           TCCR1B;
+HostTimer1Counter TCNT1;
+static uint64_t   hostTimer1Offset = 0;
+
+HardwareSerial Serial;
+
+// Used by the sketch's freeRam(). There is no heap/stack split to report on the host, so this only needs to link.
+int  __heap_start;
+int* __brkval;
+
+
+static uint64_t u64_hostNanos(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    uint64_t nanos = (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+    if(hostStartNanos == 0)
+    {
+        hostStartNanos = nanos;
+    }
+    return nanos - hostStartNanos;
+}
+
+static uint64_t u64_hostMicros(void)
+{
+    return hostVirtualTime ? hostVirtualMicros : (u64_hostNanos() / 1000ull);
+}
+
+
+/** Pins **/
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    if((pin < NUM_DIGITAL_PINS) && (mode == INPUT_PULLUP))
+    {
+        hostDigitalValues[pin] = HIGH;
+    }
+}
+
+void digitalWrite(uint8_t pin, uint8_t val)
+{
+    if(pin < NUM_DIGITAL_PINS)
+    {
+        hostDigitalValues[pin] = val ? HIGH : LOW;
+    }
+}
+
+int digitalRead(uint8_t pin)
+{
+    return (pin < NUM_DIGITAL_PINS) ? hostDigitalValues[pin] : LOW;
+}
+
+int analogRead(uint8_t pin)
+{
+    return (pin < NUM_DIGITAL_PINS) ? hostAnalogValues[pin] : 0;
+}
+
+long map(long x, long in_min, long in_max, long out_min, long out_max)
+{
+    return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+
+/** Time **/
+
+unsigned long millis(void)
+{
+    return (unsigned long)(u64_hostMicros() / 1000ull);
+}
+
+unsigned long micros(void)
+{
+    return (unsigned long)u64_hostMicros();
+}
+
+void delay(unsigned long ms)
+{
+    delayMicroseconds(ms * 1000ul);
+}
+
+void delayMicroseconds(unsigned int us)
+{
+    if(hostVirtualTime)
+    {
+        hostVirtualMicros += us;
+        return;
+    }
+    uint64_t end = u64_hostNanos() + (uint64_t)us * 1000ull;
+    while(u64_hostNanos() < end)
+    {
+    }
+}
+
+HostTimer1Counter::operator uint16_t() const
+{
+    uint64_t ticks = hostVirtualTime ? ((uint64_t)hostVirtualMicros * (F_CPU / 1000000ul)) : (u64_hostNanos() * (F_CPU / 1000000ul) / 1000ull);
+    return (uint16_t)(ticks - hostTimer1Offset);
+}
+
+HostTimer1Counter& HostTimer1Counter::operator=(uint16_t value)
+{
+    hostTimer1Offset = 0;
+    hostTimer1Offset = (uint16_t)(*this) - value;
+    return *this;
+}
+
+
+/** Print and Serial **/
+
+size_t Print::write(const uint8_t* buffer, size_t size)
+{
+    size_t n = 0;
+    while(size--)
+    {
+        n += write(*buffer++);
+    }
+    return n;
+}
+
+size_t Print::print(const __FlashStringHelper* s) { return print(reinterpret_cast<const char*>(s)); }
+size_t Print::print(const char* s)                { return write((const uint8_t*)s, strlen(s)); }
+size_t Print::print(char c)                       { return write((uint8_t)c); }
+size_t Print::print(unsigned char n, int base)    { return print((unsigned long)n, base); }
+size_t Print::print(int n, int base)              { return print((long)n, base); }
+size_t Print::print(unsigned int n, int base)     { return print((unsigned long)n, base); }
+size_t Print::print(unsigned long n, int base)    { return printNumber(n, (uint8_t)base); }
+
+size_t Print::print(long n, int base)
+{
+    if((base == DEC) && (n < 0))
+    {
+        return print('-') + printNumber((unsigned long)(-n), DEC);
+    }
+    return printNumber((unsigned long)n, (uint8_t)base);
+}
+
+size_t Print::print(double n, int digits)
+{
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.*f", digits, n);
+    return print(buffer);
+}
+
+size_t Print::println(void)                         { return print("\r\n"); }
+size_t Print::println(const __FlashStringHelper* s) { return print(s) + println(); }
+size_t Print::println(const char* s)                { return print(s) + println(); }
+size_t Print::println(char c)                       { return print(c) + println(); }
+size_t Print::println(unsigned char n, int base)    { return print(n, base) + println(); }
+size_t Print::println(int n, int base)              { return print(n, base) + println(); }
+size_t Print::println(unsigned int n, int base)     { return print(n, base) + println(); }
+size_t Print::println(long n, int base)             { return print(n, base) + println(); }
+size_t Print::println(unsigned long n, int base)    { return print(n, base) + println(); }
+size_t Print::println(double n, int digits)         { return print(n, digits) + println(); }
+
+size_t Print::printNumber(unsigned long n, uint8_t base)
+{
+    char buffer[8 * sizeof(long) + 1];
+    char* str = &buffer[sizeof(buffer) - 1];
+    *str = '\0';
+    if(base < 2)
+    {
+        base = 10;
+    }
+    do
+    {
+        char c = n % base;
+        n /= base;
+        *--str = c < 10 ? c + '0' : c + 'A' - 10;
+    }while(n);
+    return print(str);
+}
+
+void HardwareSerial::begin(unsigned long baud)
+{
+    (void)baud;
+}
+
+int HardwareSerial::available(void)
+{
+    return hostSerialInputCount;
+}
+
+int HardwareSerial::read(void)
+{
+    int c;
+    if(hostSerialInputCount == 0)
+    {
+        return -1;
+    }
+    c = hostSerialInput[hostSerialInputHead];
+    hostSerialInputHead = (hostSerialInputHead + 1u) % sizeof(hostSerialInput);
+    hostSerialInputCount--;
+    return c;
+}
+
+size_t HardwareSerial::write(uint8_t c)
+{
+    if(hostSerialOutput != NULL)
+    {
+        fputc(c, hostSerialOutput);
+    }
+    return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size)
+{
+    if(hostSerialOutput != NULL)
+    {
+        fwrite(buffer, 1, size, hostSerialOutput);
+    }
+    return size;
+}
+
+
+/** Host harness controls **/
+
+void host_setAnalogValue(uint8_t pin, uint16_t value)
+{
+    if(pin < NUM_DIGITAL_PINS)
+    {
+        hostAnalogValues[pin] = value;
+    }
+}
+
+void host_setDigitalValue(uint8_t pin, uint8_t value)
+{
+    digitalWrite(pin, value);
+}
+
+void host_setSerialOutput(FILE* stream)
+{
+    hostSerialOutput = stream;
+}
+
+void host_pushSerialInput(const uint8_t* data, size_t len)
+{
+    while(len-- && (hostSerialInputCount < sizeof(hostSerialInput)))
+    {
+        hostSerialInput[(hostSerialInputHead + hostSerialInputCount) % sizeof(hostSerialInput)] = *data++;
+        hostSerialInputCount++;
+    }
+}
+
+void host_useVirtualTime(bool enable)
+{
+    hostVirtualMicros = u64_hostMicros();
+    hostVirtualTime   = enable;
+}
+
+void host_advanceMicros(unsigned long us)
+{
+    hostVirtualMicros += us;
+}
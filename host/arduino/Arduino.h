@@ -0,0 +1,158 @@
+/**
+ * @file Arduino.h
+ * @author Marcelo Fraga
+ * @brief Host (Linux) stand-in for the subset of the Arduino AVR core used by the transmitter sketch.
+ *        Pins are backed by plain arrays that the host harness can drive, time comes either from the
+ *        system monotonic clock or from a virtual clock advanced by the harness.
+ *        Only meant for the host build (see host/Makefile), never included in the board build.
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "avr/pgmspace.h"
+
+#define HOST_BUILD 1
+
+#ifndef F_CPU
+#define F_CPU 16000000ul
+#endif
+
+typedef uint8_t byte;
+typedef bool    boolean;
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT        0x0
+#define OUTPUT       0x1
+#define INPUT_PULLUP 0x2
+
+// Same numbering as the ATmega328 variants, so the sketch pinout maps 1:1
+#define NUM_DIGITAL_PINS 22u
+#define A0 14u
+#define A1 15u
+#define A2 16u
+#define A3 17u
+#define A4 18u
+#define A5 19u
+#define A6 20u
+#define A7 21u
+
+#define PI 3.1415926535897932384626433832795
+
+// Arduino defines these as macros (and not as the overloaded std functions), which matters for abs() on floats
+#define abs(x)                ((x)>0?(x):-(x))
+#define min(a,b)              ((a)<(b)?(a):(b))
+#define max(a,b)              ((a)>(b)?(a):(b))
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+
+#define bit(b)                (1UL << (b))
+#define bitRead(value, b)     (((value) >> (b)) & 0x01)
+#define bitSet(value, b)      ((value) |= (1UL << (b)))
+#define bitClear(value, b)    ((value) &= ~(1UL << (b)))
+
+void          pinMode(uint8_t pin, uint8_t mode);
+void          digitalWrite(uint8_t pin, uint8_t val);
+int           digitalRead(uint8_t pin);
+int           analogRead(uint8_t pin);
+unsigned long millis(void);
+unsigned long micros(void);
+void          delay(unsigned long ms);
+void          delayMicroseconds(unsigned int us);
+long          map(long x, long in_min, long in_max, long out_min, long out_max);
+
+// Interrupts have no meaning on the host, the harness is single threaded
+inline void cli(void) {}
+inline void sei(void) {}
+inline void interrupts(void) {}
+inline void noInterrupts(void) {}
+
+// Timer1 emulation. TCNT1 counts at F_CPU from the host clock, so cycle measurements made with it on the
+// board read as "16MHz ticks" on the host. The control registers are accepted and ignored.
+struct HostTimer1Counter
+{
+    operator uint16_t() const;
+    HostTimer1Counter& operator=(uint16_t value);
+};
+extern uint8_t           TCCR1A;
+extern uint8_t           TCCR1B;
+extern HostTimer1Counter TCNT1;
+#define CS10 0
+#define CS11 1
+#define CS12 2
+
+
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper *>(PSTR(string_literal)))
+
+#define DEC 10
+#define HEX 16
+#define BIN 2
+
+class Print
+{
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size);
+
+    size_t print(const __FlashStringHelper* s);
+    size_t print(const char* s);
+    size_t print(char c);
+    size_t print(unsigned char n, int base = DEC);
+    size_t print(int n, int base = DEC);
+    size_t print(unsigned int n, int base = DEC);
+    size_t print(long n, int base = DEC);
+    size_t print(unsigned long n, int base = DEC);
+    size_t print(double n, int digits = 2);
+
+    size_t println(void);
+    size_t println(const __FlashStringHelper* s);
+    size_t println(const char* s);
+    size_t println(char c);
+    size_t println(unsigned char n, int base = DEC);
+    size_t println(int n, int base = DEC);
+    size_t println(unsigned int n, int base = DEC);
+    size_t println(long n, int base = DEC);
+    size_t println(unsigned long n, int base = DEC);
+    size_t println(double n, int digits = 2);
+
+private:
+    size_t printNumber(unsigned long n, uint8_t base);
+};
+
+class HardwareSerial : public Print
+{
+public:
+    void   begin(unsigned long baud);
+    int    available(void);
+    int    read(void);
+    size_t write(uint8_t c);
+    size_t write(const uint8_t* buffer, size_t size);
+    using Print::write;
+};
+extern HardwareSerial Serial;
+
+
+/** Host harness controls. Not part of the Arduino API **/
+void host_setAnalogValue(uint8_t pin, uint16_t value);
+void host_setDigitalValue(uint8_t pin, uint8_t value);
+void host_setSerialOutput(FILE* stream); // NULL silences the sketch's Serial output
+void host_pushSerialInput(const uint8_t* data, size_t len); // Bytes the sketch will read from Serial
+void host_useVirtualTime(bool enable);
+void host_advanceMicros(unsigned long us);
+
+#endif
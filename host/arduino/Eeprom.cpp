@@ -0,0 +1,116 @@
+/**
+ * @file Eeprom.cpp
+ * @author Marcelo Fraga
+ * @brief Host implementation of the avr/eeprom.h stand-in. See avr/eeprom.h
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "Arduino.h"
+#include "avr/eeprom.h"
+
+#define HOST_EEPROM_WRITE_US 3300ul // Erase + write time of one byte, from the datasheet
+
+static uint8_t       hostEeprom[E2END + 1];
+static bool          hostEepromErased = false;
+static unsigned long hostEepromReadyTime;
+static uint32_t      hostEepromWrites = 0;
+
+
+static void v_hostEepromErase(void)
+{
+    if(!hostEepromErased)
+    {
+        memset(hostEeprom, 0xFF, sizeof(hostEeprom));
+        hostEepromErased = true;
+    }
+}
+
+static size_t u32_hostEepromAddress(const void* addr)
+{
+    return (size_t)(uintptr_t)addr & E2END;
+}
+
+
+bool eeprom_is_ready(void)
+{
+    return (long)(micros() - hostEepromReadyTime) >= 0;
+}
+
+uint8_t eeprom_read_byte(const uint8_t* addr)
+{
+    v_hostEepromErase();
+    return hostEeprom[u32_hostEepromAddress(addr)];
+}
+
+void eeprom_read_block(void* dst, const void* src, size_t n)
+{
+    size_t i;
+    for(i = 0; i < n; i++)
+    {
+        ((uint8_t*)dst)[i] = eeprom_read_byte((const uint8_t*)src + i);
+    }
+}
+
+void eeprom_write_byte(uint8_t* addr, uint8_t value)
+{
+    v_hostEepromErase();
+    while(!eeprom_is_ready())
+    {
+        delayMicroseconds(10);
+    }
+    hostEeprom[u32_hostEepromAddress(addr)] = value;
+    hostEepromReadyTime = micros() + HOST_EEPROM_WRITE_US;
+    hostEepromWrites++;
+}
+
+void eeprom_update_byte(uint8_t* addr, uint8_t value)
+{
+    if(eeprom_read_byte(addr) != value)
+    {
+        eeprom_write_byte(addr, value);
+    }
+}
+
+
+/** Host harness controls **/
+
+bool host_loadEeprom(const char* path)
+{
+    FILE* file = fopen(path, "rb");
+    v_hostEepromErase();
+    if(file == NULL)
+    {
+        return false;
+    }
+    size_t read = fread(hostEeprom, 1, sizeof(hostEeprom), file);
+    fclose(file);
+    return read == sizeof(hostEeprom);
+}
+
+bool host_saveEeprom(const char* path)
+{
+    FILE* file = fopen(path, "wb");
+    v_hostEepromErase();
+    if(file == NULL)
+    {
+        return false;
+    }
+    size_t written = fwrite(hostEeprom, 1, sizeof(hostEeprom), file);
+    fclose(file);
+    return written == sizeof(hostEeprom);
+}
+
+void host_eraseEeprom(void)
+{
+    memset(hostEeprom, 0xFF, sizeof(hostEeprom));
+    hostEepromErased = true;
+}
+
+uint32_t host_getEepromWrites(void)
+{
+    return hostEepromWrites;
+}
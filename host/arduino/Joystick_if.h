@@ -0,0 +1,15 @@
+/**
+ * @file Joystick_if.h
+ * @author Marcelo Fraga
+ * @brief Host stand-in for the Joystick_if library header included by the sketch. Nothing from it is used.
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef JOYSTICK_IF_H
+#define JOYSTICK_IF_H
+
+#endif
@@ -0,0 +1,504 @@
+/**
+ * @file RF24.cpp
+ * @author Marcelo Fraga
+ * @brief Host implementation of the RF24 stand-in. See RF24.h
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "RF24.h"
+
+static RF24*    etherInstances[RF24_MAX_INSTANCES];
+static bool     loopbackAck   = true;
+static uint32_t loopbackCount = 0;
+static uint8_t  loopbackPayload[RF24_MAX_PAYLOAD_SIZE];
+static uint8_t  loopbackLength = 0;
+static uint8_t  loopbackAckPayload[RF24_MAX_PAYLOAD_SIZE];
+static uint8_t  loopbackAckPayloadLength = 0;
+static uint8_t  lossPercent = 0;
+static uint32_t lossRandomState = 1; // Fixed seed, runs are reproducible
+static uint8_t  interferencePercent[126];
+static uint32_t rpdRandomState = 1;  // Own sequence, scanning doesn't change the losses of a run
+static uint8_t  loopbackChannel = 0;
+static rf24_datarate_e loopbackDataRate = RF24_1MBPS;
+static bool     loopbackDataRateSet = false; // Until the harness sets one, any data rate is heard
+static uint8_t  loopbackPaLevel = RF24_PA_MAX;
+static uint8_t  pathLoss = 0;
+static unsigned long airTime = 0;
+static unsigned long rxLatency = 0;
+static unsigned long rxJitter = 0;
+static uint32_t jitterRandomState = 1;
+static uint32_t deliveredCount = 0;
+
+// Datasheet figures, in dBm
+static const int8_t paOutput[4]    = {-18, -12, -6, 0};   // By rf24_pa_dbm_e
+static const int8_t sensitivity[3] = {-85, -82, -94};     // By rf24_datarate_e
+
+// Fully received with 6dB of margin and more, never under -4dB, in between 10% lost per dB
+static uint8_t u8_marginLossPercent(uint8_t paLevel, rf24_datarate_e dataRate)
+{
+    int16_t margin = paOutput[paLevel & 3u] - (int16_t)pathLoss - sensitivity[dataRate];
+    return (uint8_t)constrain((6 - margin) * 10, 0, 100);
+}
+
+static bool b_isAttemptLost(uint8_t channel, uint8_t paLevel, rf24_datarate_e dataRate)
+{
+    lossRandomState = lossRandomState * 1103515245ul + 12345ul;
+    return ((lossRandomState >> 16) % 100u) < max(max(lossPercent, interferencePercent[channel]), u8_marginLossPercent(paLevel, dataRate));
+}
+
+
+RF24::RF24()
+{
+    memset(this, 0, sizeof(RF24));
+    addressWidth = 5;
+    paLevel      = RF24_PA_MAX;
+    dataRate     = RF24_1MBPS;
+    channel      = 76; // RF24 library default
+    payloadSize  = RF24_MAX_PAYLOAD_SIZE;
+    autoAck      = true;
+    retryDelay   = 5;  // RF24 library defaults
+    retryCount   = 15;
+}
+
+RF24::RF24(uint8_t cePin, uint8_t csnPin) : RF24()
+{
+    (void)cePin;
+    (void)csnPin;
+}
+
+// The sketch constructs a temporary and assigns it to the global. Only the configuration is copied, registration in
+// the ether stays tied to the object that is actually used.
+RF24& RF24::operator=(const RF24& other)
+{
+    bool wasRegistered = registered;
+    memcpy(this, &other, sizeof(RF24));
+    registered = wasRegistered;
+    return *this;
+}
+
+RF24::~RF24()
+{
+    uint8_t i;
+    for(i = 0; i < RF24_MAX_INSTANCES; i++)
+    {
+        if(etherInstances[i] == this)
+        {
+            etherInstances[i] = NULL;
+        }
+    }
+}
+
+bool RF24::begin(void)
+{
+    v_registerInstance();
+    return true;
+}
+
+bool RF24::isChipConnected(void)
+{
+    return true;
+}
+
+void RF24::startListening(void)
+{
+    listening = true;
+}
+
+void RF24::stopListening(void)
+{
+    listening = false;
+    rpdRandomState = rpdRandomState * 1103515245ul + 12345ul;
+    rpd = ((rpdRandomState >> 16) % 100u) < interferencePercent[channel];
+}
+
+bool RF24::available(void)
+{
+    return (rxCount > 0) && ((long)(micros() - rxReadyTime[0]) >= 0);
+}
+
+bool RF24::available(uint8_t* pipeNum)
+{
+    if(pipeNum != NULL)
+    {
+        *pipeNum = 1;
+    }
+    return available();
+}
+
+void RF24::read(void* buf, uint8_t len)
+{
+    if(rxCount == 0)
+    {
+        return;
+    }
+    memcpy(buf, rxFifo[0], min(len, (uint8_t)RF24_MAX_PAYLOAD_SIZE));
+    memmove(rxFifo[0], rxFifo[1], (RF24_RX_FIFO_SIZE - 1) * RF24_MAX_PAYLOAD_SIZE);
+    memmove(&rxLength[0], &rxLength[1], RF24_RX_FIFO_SIZE - 1);
+    memmove(&rxReadyTime[0], &rxReadyTime[1], (RF24_RX_FIFO_SIZE - 1) * sizeof(rxReadyTime[0]));
+    rxCount--;
+}
+
+bool RF24::write(const void* buf, uint8_t len)
+{
+    return b_send(buf, len);
+}
+
+// The payload reaches the receiver right away, only the outcome is delayed to the end of the simulated air time
+bool RF24::startWrite(const void* buf, uint8_t len, const bool multicast)
+{
+    (void)multicast;
+    txPendingAck = b_send(buf, len);
+    txPending    = true;
+    txDoneTime   = micros() + ((u32_attemptTime(len) + 250ul * (1ul + retryDelay)) * lastArc) + (txPendingAck ? u32_attemptTime(len) : 0ul);
+    return true;
+}
+
+void RF24::whatHappened(bool& tx_ok, bool& tx_fail, bool& rx_ready)
+{
+    bool done = txPending && ((long)(micros() - txDoneTime) >= 0);
+    tx_ok     = done && txPendingAck;
+    tx_fail   = done && !txPendingAck;
+    rx_ready  = available();
+    txPending = txPending && !done;
+}
+
+void RF24::maskIRQ(bool tx_ok, bool tx_fail, bool rx_ready)
+{
+    (void)tx_ok;
+    (void)tx_fail;
+    (void)rx_ready;
+}
+
+uint8_t RF24::getARC(void)
+{
+    return lastArc;
+}
+
+void RF24::enableAckPayload(void)
+{
+    ackPayloads     = true;
+    dynamicPayloads = true; // Same as the library, ACK payloads need dynamic payloads
+}
+
+bool RF24::writeAckPayload(uint8_t pipe, const void* buf, uint8_t len)
+{
+    (void)pipe;
+    ackPayloadLength = min(len, (uint8_t)RF24_MAX_PAYLOAD_SIZE);
+    memcpy(ackPayload, buf, ackPayloadLength);
+    return true;
+}
+
+void RF24::openWritingPipe(const uint8_t* address)
+{
+    memcpy(txAddress, address, addressWidth);
+}
+
+void RF24::openReadingPipe(uint8_t number, const uint8_t* address)
+{
+    (void)number;
+    memcpy(rxAddress, address, addressWidth);
+    rxPipeOpen = true;
+}
+
+void RF24::setAddressWidth(uint8_t width)
+{
+    addressWidth = constrain(width, 3, 5);
+}
+
+void RF24::setPALevel(uint8_t level, bool lnaEnable)
+{
+    (void)lnaEnable;
+    paLevel = min(level, (uint8_t)RF24_PA_MAX);
+}
+
+uint8_t RF24::getPALevel(void)
+{
+    return paLevel;
+}
+
+bool RF24::setDataRate(rf24_datarate_e speed)
+{
+    dataRate = speed;
+    return true;
+}
+
+rf24_datarate_e RF24::getDataRate(void)
+{
+    return dataRate;
+}
+
+void RF24::setChannel(uint8_t newChannel)
+{
+    channel = min(newChannel, (uint8_t)125);
+}
+
+uint8_t RF24::getChannel(void)
+{
+    return channel;
+}
+
+void RF24::setPayloadSize(uint8_t size)
+{
+    payloadSize = constrain(size, 1, RF24_MAX_PAYLOAD_SIZE);
+}
+
+uint8_t RF24::getPayloadSize(void)
+{
+    return payloadSize;
+}
+
+void RF24::enableDynamicPayloads(void)
+{
+    dynamicPayloads = true;
+}
+
+uint8_t RF24::getDynamicPayloadSize(void)
+{
+    return (rxCount > 0) ? rxLength[0] : 0u;
+}
+
+void RF24::setRetries(uint8_t delay, uint8_t count)
+{
+    retryDelay = min(delay, (uint8_t)15);
+    retryCount = min(count, (uint8_t)15);
+}
+
+void RF24::setAutoAck(bool enable)
+{
+    autoAck = enable;
+}
+
+uint8_t RF24::flush_rx(void)
+{
+    rxCount = 0;
+    return 0;
+}
+
+uint8_t RF24::flush_tx(void)
+{
+    txPending = false;
+    return 0;
+}
+
+bool RF24::testRPD(void)
+{
+    return rpd;
+}
+
+bool RF24::testCarrier(void)
+{
+    return rpd;
+}
+
+void RF24::v_registerInstance(void)
+{
+    uint8_t i;
+    if(registered)
+    {
+        return;
+    }
+    for(i = 0; i < RF24_MAX_INSTANCES; i++)
+    {
+        if(etherInstances[i] == NULL)
+        {
+            etherInstances[i] = this;
+            registered = true;
+            return;
+        }
+    }
+}
+
+// Returns whether a matching receiver exists. <acknowledged> tells if it actually took the payload
+bool RF24::b_deliver(const void* buf, uint8_t len, bool* acknowledged)
+{
+    uint8_t i;
+    for(i = 0; i < RF24_MAX_INSTANCES; i++)
+    {
+        RF24* pReceiver = etherInstances[i];
+        if((pReceiver == NULL) || (pReceiver == this) || !pReceiver->listening || !pReceiver->rxPipeOpen)
+        {
+            continue;
+        }
+        if((pReceiver->channel != channel) || (pReceiver->dataRate != dataRate) || (memcmp(pReceiver->rxAddress, txAddress, addressWidth) != 0))
+        {
+            continue;
+        }
+        *acknowledged = pReceiver->rxCount < RF24_RX_FIFO_SIZE; // Same as the real chip, a receiver with a full rx FIFO doesn't ACK
+        if(!(*acknowledged))
+        {
+            return true;
+        }
+        unsigned long readyTime = micros() + rxLatency;
+        if(rxJitter > 0)
+        {
+            jitterRandomState = jitterRandomState * 1103515245ul + 12345ul;
+            readyTime += (jitterRandomState >> 8) % (rxJitter + 1ul);
+        }
+        if((pReceiver->rxCount > 0) && ((long)(readyTime - pReceiver->rxReadyTime[pReceiver->rxCount - 1]) < 0))
+        {
+            readyTime = pReceiver->rxReadyTime[pReceiver->rxCount - 1]; // Never overtakes the previous payload
+        }
+        pReceiver->v_pushRx(buf, dynamicPayloads ? len : payloadSize, readyTime);
+        deliveredCount++;
+        if(ackPayloads && (pReceiver->ackPayloadLength > 0))
+        {
+            v_pushRx(pReceiver->ackPayload, pReceiver->ackPayloadLength, micros());
+            pReceiver->ackPayloadLength = 0;
+        }
+        return true;
+    }
+    return false;
+}
+
+// Lost attempts are retransmitted. The first attempt that gets through decides the outcome: a delivery that isn't
+// acknowledged (full receiver FIFO, --no-ack) is not retried, it ends as if every retransmit was used.
+bool RF24::b_send(const void* buf, uint8_t len)
+{
+    uint8_t attempt;
+    uint8_t maxRetries = autoAck ? retryCount : 0;
+
+    for(attempt = 0; attempt <= maxRetries; attempt++)
+    {
+        airTime += u32_attemptTime(len);
+        if(!b_isAttemptLost(channel, paLevel, dataRate))
+        {
+            bool acknowledged = b_deliverOnce(buf, len);
+            lastArc = acknowledged ? attempt : maxRetries;
+            airTime += u32_attemptTime(len) * (lastArc - attempt); // Retransmits of an unacknowledged delivery
+            return acknowledged;
+        }
+    }
+    lastArc = maxRetries;
+    return false;
+}
+
+bool RF24::b_deliverOnce(const void* buf, uint8_t len)
+{
+    bool acknowledged;
+    if(b_deliver(buf, len, &acknowledged))
+    {
+        return acknowledged;
+    }
+    if(loopbackDataRateSet && (dataRate != loopbackDataRate))
+    {
+        return false; // Not heard, nothing to ACK
+    }
+
+    loopbackLength = min(len, (uint8_t)RF24_MAX_PAYLOAD_SIZE);
+    memcpy(loopbackPayload, buf, loopbackLength);
+    loopbackChannel = channel;
+    loopbackPaLevel = paLevel;
+    loopbackCount++;
+    acknowledged = loopbackAck || !autoAck;
+    if(acknowledged && ackPayloads && (loopbackAckPayloadLength > 0))
+    {
+        v_pushRx(loopbackAckPayload, loopbackAckPayloadLength, micros());
+        loopbackAckPayloadLength = 0;
+    }
+    return acknowledged;
+}
+
+void RF24::v_pushRx(const void* buf, uint8_t len, unsigned long readyTime)
+{
+    if(rxCount >= RF24_RX_FIFO_SIZE)
+    {
+        return;
+    }
+    memset(rxFifo[rxCount], 0, RF24_MAX_PAYLOAD_SIZE);
+    memcpy(rxFifo[rxCount], buf, min(len, (uint8_t)RF24_MAX_PAYLOAD_SIZE));
+    rxLength[rxCount]    = min(len, (uint8_t)RF24_MAX_PAYLOAD_SIZE);
+    rxReadyTime[rxCount] = readyTime;
+    rxCount++;
+}
+
+// One acknowledged attempt: 130us TX settling and the packet (preamble, address, PCF, payload, CRC) on air.
+// A failed attempt additionally waits the auto retransmit delay (ARD). Static payloads always take payloadSize bytes.
+unsigned long RF24::u32_attemptTime(uint8_t len)
+{
+    unsigned long bits    = 8ul * (1ul + addressWidth + (dynamicPayloads ? len : payloadSize) + 2ul) + 9ul;
+    unsigned long bitTime = (dataRate == RF24_2MBPS) ? 1ul : ((dataRate == RF24_1MBPS) ? 2ul : 8ul); // In half uSeconds
+    return 130ul + ((bits * bitTime) / 2ul);
+}
+
+
+/** Host harness controls **/
+
+void host_setRadioLoopbackAck(bool acknowledged)
+{
+    loopbackAck = acknowledged;
+}
+
+uint32_t host_getRadioLoopbackCount(void)
+{
+    return loopbackCount;
+}
+
+void host_setRadioLoopbackAckPayload(const uint8_t* buf, uint8_t len)
+{
+    loopbackAckPayloadLength = min(len, (uint8_t)RF24_MAX_PAYLOAD_SIZE);
+    memcpy(loopbackAckPayload, buf, loopbackAckPayloadLength);
+}
+
+void host_setRadioLossPercent(uint8_t percent)
+{
+    lossPercent = min(percent, (uint8_t)100);
+}
+
+void host_setRadioInterference(uint8_t firstChannel, uint8_t lastChannel, uint8_t percent)
+{
+    uint16_t i;
+    for(i = firstChannel; (i <= lastChannel) && (i < sizeof(interferencePercent)); i++)
+    {
+        interferencePercent[i] = min(percent, (uint8_t)100);
+    }
+}
+
+uint8_t host_getRadioLoopbackChannel(void)
+{
+    return loopbackChannel;
+}
+
+void host_setRadioLoopbackDataRate(rf24_datarate_e dataRate)
+{
+    loopbackDataRate    = dataRate;
+    loopbackDataRateSet = true;
+}
+
+uint8_t host_getRadioLoopbackPALevel(void)
+{
+    return loopbackPaLevel;
+}
+
+void host_setRadioPathLoss(uint8_t dB)
+{
+    pathLoss = dB;
+}
+
+unsigned long host_getRadioAirTime(void)
+{
+    return airTime;
+}
+
+void host_setRadioLatency(unsigned long us, unsigned long jitterUs)
+{
+    rxLatency = us;
+    rxJitter  = jitterUs;
+}
+
+uint32_t host_getRadioDeliveredCount(void)
+{
+    return deliveredCount;
+}
+
+const uint8_t* host_getRadioLoopbackPayload(uint8_t* len)
+{
+    if(len != NULL)
+    {
+        *len = loopbackLength;
+    }
+    return loopbackPayload;
+}
@@ -0,0 +1,147 @@
+/**
+ * @file RF24.h
+ * @author Marcelo Fraga
+ * @brief Host stand-in for the TMRh20 RF24 driver. Every RF24 instance created in the process shares a single
+ *        simulated "ether": a write is delivered to the rx FIFO of any listening instance with a matching
+ *        address, channel and data rate, and is acknowledged. When nobody is listening the payload is looped
+ *        back into a host visible buffer and the ACK result is decided by the harness (see host_ functions).
+ *        write() completes at once. startWrite() reports its outcome through whatHappened() only after the
+ *        time the chip would take on air: one attempt when acknowledged, every auto retransmit otherwise.
+ *        Attempts can be lost at random (host_setRadioLossPercent), which shows up as auto retransmits (getARC()).
+ *        Channels can carry interference (host_setRadioInterference): attempts on them are lost at least that often,
+ *        and the received power detector (testRPD()) trips that often on a stopListening() there.
+ *        A path loss (host_setRadioPathLoss) loses attempts depending on the margin left by the PA level and the
+ *        sensitivity of the data rate. Looped back payloads are only received at the data rate of the harness receiver.
+ *        An ACK payload preloaded by the receiver, or by the harness in loopback, comes back with the next ACK.
+ *        A payload delivered to a listening instance only shows up there (available()) after a latency and a random
+ *        jitter (host_setRadioLatency), in order. The ACK is not delayed, the chip sends it on its own.
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef RF24_H
+#define RF24_H
+
+#include <Arduino.h>
+
+#define RF24_MAX_PAYLOAD_SIZE 32u
+#define RF24_RX_FIFO_SIZE     3u
+#define RF24_MAX_INSTANCES    4u
+
+typedef enum
+{
+    RF24_PA_MIN = 0,
+    RF24_PA_LOW,
+    RF24_PA_HIGH,
+    RF24_PA_MAX,
+    RF24_PA_ERROR
+}rf24_pa_dbm_e;
+
+typedef enum
+{
+    RF24_1MBPS = 0,
+    RF24_2MBPS,
+    RF24_250KBPS
+}rf24_datarate_e;
+
+class RF24
+{
+public:
+    RF24();
+    RF24(uint8_t cePin, uint8_t csnPin);
+    RF24& operator=(const RF24& other);
+    ~RF24();
+
+    bool    begin(void);
+    bool    isChipConnected(void);
+    void    startListening(void);
+    void    stopListening(void);
+
+    bool    available(void);
+    bool    available(uint8_t* pipeNum);
+    void    read(void* buf, uint8_t len);
+    bool    write(const void* buf, uint8_t len);
+    bool    startWrite(const void* buf, uint8_t len, const bool multicast);
+    void    whatHappened(bool& tx_ok, bool& tx_fail, bool& rx_ready);
+    void    maskIRQ(bool tx_ok, bool tx_fail, bool rx_ready);
+    uint8_t getARC(void);
+    void    enableAckPayload(void);
+    bool    writeAckPayload(uint8_t pipe, const void* buf, uint8_t len);
+
+    void    openWritingPipe(const uint8_t* address);
+    void    openReadingPipe(uint8_t number, const uint8_t* address);
+    void    setAddressWidth(uint8_t width);
+
+    void    setPALevel(uint8_t level, bool lnaEnable = 1);
+    uint8_t getPALevel(void);
+    bool    setDataRate(rf24_datarate_e speed);
+    rf24_datarate_e getDataRate(void);
+    void    setChannel(uint8_t channel);
+    uint8_t getChannel(void);
+    void    setPayloadSize(uint8_t size);
+    uint8_t getPayloadSize(void);
+    void    enableDynamicPayloads(void);
+    uint8_t getDynamicPayloadSize(void);
+    void    setRetries(uint8_t delay, uint8_t count);
+    void    setAutoAck(bool enable);
+    uint8_t flush_rx(void);
+    uint8_t flush_tx(void);
+    bool    testRPD(void);
+    bool    testCarrier(void);
+
+private:
+    void    v_registerInstance(void);
+    bool    b_deliver(const void* buf, uint8_t len, bool* acknowledged);
+    bool    b_send(const void* buf, uint8_t len);
+    bool    b_deliverOnce(const void* buf, uint8_t len);
+    void    v_pushRx(const void* buf, uint8_t len, unsigned long readyTime);
+    unsigned long u32_attemptTime(uint8_t len);
+
+    bool            registered;
+    bool            listening;
+    uint8_t         addressWidth;
+    uint8_t         txAddress[5];
+    uint8_t         rxAddress[5];
+    bool            rxPipeOpen;
+    uint8_t         paLevel;
+    rf24_datarate_e dataRate;
+    uint8_t         channel;
+    uint8_t         payloadSize;
+    bool            autoAck;
+    bool            dynamicPayloads;
+    bool            ackPayloads;
+    uint8_t         ackPayload[RF24_MAX_PAYLOAD_SIZE];  // Preloaded by writeAckPayload, sent with the next ACK
+    uint8_t         ackPayloadLength;
+    uint8_t         lastArc;                            // Auto retransmits of the last write
+    uint8_t         retryDelay;
+    uint8_t         retryCount;
+    bool            txPending;     // startWrite() in flight
+    bool            txPendingAck;
+    unsigned long   txDoneTime;    // micros() at which the pending transmission ends
+    uint8_t         rxFifo[RF24_RX_FIFO_SIZE][RF24_MAX_PAYLOAD_SIZE];
+    uint8_t         rxLength[RF24_RX_FIFO_SIZE];
+    unsigned long   rxReadyTime[RF24_RX_FIFO_SIZE]; // micros() from which the payload can be read
+    uint8_t         rxCount;
+    bool            rpd;           // Latched by stopListening()
+};
+
+
+/** Host harness controls. Not part of the RF24 API **/
+void           host_setRadioLoopbackAck(bool acknowledged);            // ACK result of writes that no simulated receiver picked up
+uint32_t       host_getRadioLoopbackCount(void);                       // Number of writes looped back so far
+const uint8_t* host_getRadioLoopbackPayload(uint8_t* len);             // Last looped back payload
+void           host_setRadioLoopbackAckPayload(const uint8_t* buf, uint8_t len); // Returned with the next looped back ACK
+void           host_setRadioLossPercent(uint8_t percent);              // Chance of every single attempt being lost
+void           host_setRadioInterference(uint8_t firstChannel, uint8_t lastChannel, uint8_t percent); // Busy channels
+uint8_t        host_getRadioLoopbackChannel(void);                     // Channel of the last looped back payload
+void           host_setRadioLoopbackDataRate(rf24_datarate_e dataRate); // Data rate the harness receiver listens at, any until set
+uint8_t        host_getRadioLoopbackPALevel(void);                     // PA level of the last looped back payload
+void           host_setRadioPathLoss(uint8_t dB);                      // Between the transmitter and any receiver. 0 is none
+unsigned long  host_getRadioAirTime(void);                             // uSeconds spent sending, every attempt
+void           host_setRadioLatency(unsigned long us, unsigned long jitterUs); // Until a delivered payload can be read
+uint32_t       host_getRadioDeliveredCount(void);                      // Payloads taken by a listening instance so far
+
+#endif
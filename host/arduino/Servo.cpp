@@ -0,0 +1,100 @@
+/**
+ * @file Servo.cpp
+ * @author Marcelo Fraga
+ * @brief Host implementation of the Servo stand-in. See Servo.h
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "Servo.h"
+
+static uint8_t  servoCount = 0;
+static uint16_t servoPulse[MAX_SERVOS];
+static uint8_t  servoPin[MAX_SERVOS];
+static bool     servoAttached[MAX_SERVOS];
+
+
+Servo::Servo()
+{
+    index    = (servoCount < MAX_SERVOS) ? servoCount++ : INVALID_SERVO;
+    minPulse = MIN_PULSE_WIDTH;
+    maxPulse = MAX_PULSE_WIDTH;
+    if(index != INVALID_SERVO)
+    {
+        servoPulse[index] = DEFAULT_PULSE_WIDTH;
+    }
+}
+
+uint8_t Servo::attach(int pin)
+{
+    return attach(pin, MIN_PULSE_WIDTH, MAX_PULSE_WIDTH);
+}
+
+uint8_t Servo::attach(int pin, int min, int max)
+{
+    if(index == INVALID_SERVO)
+    {
+        return INVALID_SERVO;
+    }
+    minPulse             = min;
+    maxPulse             = max;
+    servoPin[index]      = (uint8_t)pin;
+    servoAttached[index] = true;
+    return index;
+}
+
+void Servo::detach()
+{
+    if(index != INVALID_SERVO)
+    {
+        servoAttached[index] = false;
+    }
+}
+
+void Servo::write(int value)
+{
+    if(value < (int)MIN_PULSE_WIDTH)
+    {
+        value = map(constrain(value, 0, 180), 0, 180, minPulse, maxPulse);
+    }
+    writeMicroseconds(value);
+}
+
+void Servo::writeMicroseconds(int value)
+{
+    if(index != INVALID_SERVO)
+    {
+        servoPulse[index] = (uint16_t)constrain(value, minPulse, maxPulse);
+    }
+}
+
+int Servo::read()
+{
+    return map(readMicroseconds() + 1, minPulse, maxPulse, 0, 180);
+}
+
+int Servo::readMicroseconds()
+{
+    return (index != INVALID_SERVO) ? servoPulse[index] : 0;
+}
+
+bool Servo::attached()
+{
+    return (index != INVALID_SERVO) && servoAttached[index];
+}
+
+
+/** Host harness controls **/
+
+uint16_t host_getServoPulse(uint8_t index)
+{
+    return ((index < MAX_SERVOS) && servoAttached[index]) ? servoPulse[index] : 0u;
+}
+
+uint8_t host_getServoPin(uint8_t index)
+{
+    return (index < MAX_SERVOS) ? servoPin[index] : 0u;
+}
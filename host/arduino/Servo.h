@@ -0,0 +1,48 @@
+/**
+ * @file Servo.h
+ * @author Marcelo Fraga
+ * @brief Host stand-in for the Arduino Servo library. No pin is driven: every attached servo keeps the pulse width it
+ *        was last given, which the harness reads back by attach order (host_getServoPulse).
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef SERVO_H
+#define SERVO_H
+
+#include <Arduino.h>
+
+#define MIN_PULSE_WIDTH     544u  // Library defaults, in uSeconds
+#define MAX_PULSE_WIDTH     2400u
+#define DEFAULT_PULSE_WIDTH 1500u
+#define MAX_SERVOS          12u   // One 16 bit timer on the ATmega328
+#define INVALID_SERVO       255u
+
+class Servo
+{
+public:
+    Servo();
+    uint8_t attach(int pin);
+    uint8_t attach(int pin, int min, int max);
+    void    detach();
+    void    write(int value);              // Angle (0 - 180), or pulse width when over MIN_PULSE_WIDTH
+    void    writeMicroseconds(int value);
+    int     read();
+    int     readMicroseconds();
+    bool    attached();
+
+private:
+    uint8_t index;                         // Attach order
+    int     minPulse;
+    int     maxPulse;
+};
+
+
+/** Host harness controls. Not part of the Servo API **/
+uint16_t host_getServoPulse(uint8_t index);   // In uSeconds, 0 while detached or never attached
+uint8_t  host_getServoPin(uint8_t index);
+
+#endif
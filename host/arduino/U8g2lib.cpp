@@ -0,0 +1,499 @@
+/**
+ * @file U8g2lib.cpp
+ * @author Marcelo Fraga
+ * @brief Host implementation of the U8g2 stand-in. See U8g2lib.h
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "U8g2lib.h"
+
+#define GLYPH_WIDTH    3u
+#define GLYPH_HEIGHT   5u
+#define GLYPH_ADVANCE  4u
+#define FIRST_GLYPH    ' '
+#define LAST_GLYPH     '~'
+#define SSD1306_I2C_ADDRESS    0x78u // 0x3C, in 8 bit form
+#define SSD1306_I2C_DATA_CHUNK 24u   // Data bytes per I2C transaction, as U8g2 sends them
+
+const u8g2_cb_t u8g2_cb_r0     = {0};
+const uint8_t   u8g2_font_4x6_tf[] = {0}; // Placeholder, the stand-in always draws with hostFont
+
+static uint32_t displayBusClock = 0;
+static U8G2*    hostDisplay     = NULL;
+
+// 3x5 glyphs for ' '..'~'. Rows top to bottom, 3 bits per row, MSB is the leftmost pixel of the top row.
+static const uint16_t hostFont[LAST_GLYPH - FIRST_GLYPH + 1] =
+{
+    0x0000, 0x2482, 0x5A00, 0x5F7D, 0x3C9E, 0x52A5, 0x2AAB, 0x2400,
+    0x1491, 0x4494, 0x0AA8, 0x05D0, 0x0014, 0x01C0, 0x0002, 0x12A4,
+    0x7B6F, 0x2C97, 0x73E7, 0x72CF, 0x5BC9, 0x79CF, 0x79EF, 0x7252,
+    0x7BEF, 0x7BCF, 0x0410, 0x0414, 0x1511, 0x0E38, 0x4454, 0x7282,
+    0x2BE3, 0x2BED, 0x6BAE, 0x3923, 0x6B6E, 0x79A7, 0x79A4, 0x396B,
+    0x5BED, 0x7497, 0x126A, 0x5BAD, 0x4927, 0x5FED, 0x6B6D, 0x2B6A,
+    0x6BA4, 0x2B73, 0x6BAD, 0x388E, 0x7492, 0x5B6B, 0x5B52, 0x5BFD,
+    0x5AAD, 0x5A92, 0x72A7, 0x3493, 0x4889, 0x6496, 0x2A00, 0x0007,
+    0x4400, 0x076B, 0x4D6E, 0x0723, 0x176B, 0x05E3, 0x15D2, 0x3ACE,
+    0x4D6D, 0x2092, 0x106A, 0x4BAD, 0x6497, 0x0FED, 0x0D6D, 0x056A,
+    0x0D74, 0x0759, 0x0724, 0x078E, 0x2E91, 0x0B6B, 0x0B52, 0x0BFD,
+    0x0A95, 0x0ACE, 0x0EE7, 0x3513, 0x2492, 0x6456, 0x0780,
+};
+
+
+U8G2::U8G2(uint8_t tileHeight)
+{
+    v_init(tileHeight);
+}
+
+U8G2::U8G2(void)
+{
+    v_init(0);
+}
+
+void U8G2::v_init(uint8_t tileHeight)
+{
+    memset(tileBuffer, 0, sizeof(tileBuffer));
+    memset(displayRam, 0, sizeof(displayRam));
+    memset(&u8g2, 0, sizeof(u8g2));
+    u8g2.tile_buf_height  = tileHeight;
+    u8g2.u8x8.i2c_address = SSD1306_I2C_ADDRESS;
+    currentTileRow   = 0;
+    drawColor        = 1;
+    cursorX          = 0;
+    cursorY          = 0;
+    tileRowTransfers = 0;
+    transferBytes    = 0;
+    hostDisplay      = this;
+}
+
+bool U8G2::begin(void)
+{
+    if(u8g2.u8x8.byte_cb != NULL)
+    {
+        u8g2.u8x8.byte_cb(&u8g2.u8x8, U8X8_MSG_BYTE_INIT, 0, NULL);
+    }
+    clearDisplay();
+    return true;
+}
+
+void U8G2::setBusClock(uint32_t clockSpeed)
+{
+    (void)clockSpeed; // The harness sets the emulated clock, host_setDisplayBusClock
+}
+
+void U8G2::clearDisplay(void)
+{
+    memset(displayRam, 0, sizeof(displayRam));
+    memset(tileBuffer, 0, sizeof(tileBuffer));
+    currentTileRow = 0;
+}
+
+void U8G2::setFont(const uint8_t* font)
+{
+    (void)font;
+}
+
+void U8G2::setDrawColor(uint8_t color)
+{
+    drawColor = color;
+}
+
+
+/** Page buffer loop **/
+
+void U8G2::firstPage(void)
+{
+    setBufferCurrTileRow(0);
+    clearBuffer();
+}
+
+uint8_t U8G2::nextPage(void)
+{
+    sendBuffer();
+    if((currentTileRow + u8g2.tile_buf_height) >= U8G2_TILE_ROWS)
+    {
+        setBufferCurrTileRow(0);
+        return 0;
+    }
+    setBufferCurrTileRow(currentTileRow + u8g2.tile_buf_height);
+    clearBuffer();
+    return 1;
+}
+
+
+/** Manual buffer handling **/
+
+void U8G2::clearBuffer(void)
+{
+    memset(tileBuffer, 0, u8g2.tile_buf_height * U8G2_DISPLAY_WIDTH);
+}
+
+void U8G2::sendBuffer(void)
+{
+    uint8_t nRows = min(u8g2.tile_buf_height, (uint8_t)(U8G2_TILE_ROWS - currentTileRow));
+    v_transferTileRows(currentTileRow, nRows, 0, U8G2_DISPLAY_WIDTH / 8u);
+}
+
+void U8G2::setBufferCurrTileRow(uint8_t row)
+{
+    currentTileRow = row;
+}
+
+uint8_t U8G2::getBufferCurrTileRow(void)
+{
+    return currentTileRow;
+}
+
+uint8_t U8G2::getBufferTileHeight(void)
+{
+    return u8g2.tile_buf_height;
+}
+
+uint8_t* U8G2::getBufferPtr(void)
+{
+    return tileBuffer;
+}
+
+void U8G2::updateDisplayArea(uint8_t tx, uint8_t ty, uint8_t tw, uint8_t th)
+{
+    // Only meaningful when the tile buffer holds the whole area, same restriction as U8g2
+    if((ty < currentTileRow) || ((ty + th) > (currentTileRow + u8g2.tile_buf_height)))
+    {
+        return;
+    }
+    v_transferTileRows(ty, th, tx, tw);
+}
+
+void U8G2::updateDisplay(void)
+{
+    sendBuffer();
+}
+
+void U8G2::v_transferTileRows(uint8_t firstRow, uint8_t nRows, uint8_t firstColumn, uint8_t nColumns)
+{
+    uint8_t  row;
+    uint16_t nBytes = 0;
+    for(row = firstRow; (row < (firstRow + nRows)) && (row < U8G2_TILE_ROWS); row++)
+    {
+        const uint8_t* pData = &tileBuffer[((row - currentTileRow) * U8G2_DISPLAY_WIDTH) + (firstColumn * 8u)];
+        uint8_t        x     = firstColumn * 8u;
+        memcpy(&displayRam[(row * U8G2_DISPLAY_WIDTH) + x], pData, nColumns * 8u);
+        tileRowTransfers++;
+        // SSD1306 framing of U8g2: column and page address commands, then the data in chunks. Each transaction is
+        // the address byte, a control byte and its payload
+        nBytes += 5u + (nColumns * 8u) + 2u * (((nColumns * 8u) + SSD1306_I2C_DATA_CHUNK - 1u) / SSD1306_I2C_DATA_CHUNK);
+
+        if(u8g2.u8x8.byte_cb != NULL)
+        {
+            uint8_t commands[3] = {(uint8_t)(0x10u | (x >> 4)), (uint8_t)(x & 0x0Fu), (uint8_t)(0xB0u | row)};
+            uint8_t left        = nColumns * 8u;
+            v_sendI2C(0x00u, commands, sizeof(commands));
+            while(left > 0u)
+            {
+                uint8_t chunk = min(left, (uint8_t)SSD1306_I2C_DATA_CHUNK);
+                v_sendI2C(0x40u, pData, chunk);
+                pData += chunk;
+                left  -= chunk;
+            }
+        }
+    }
+    transferBytes += nBytes;
+
+    // A custom byte callback accounts for the transfer time itself
+    if((displayBusClock != 0) && (u8g2.u8x8.byte_cb == NULL))
+    {
+        delayMicroseconds((unsigned int)(((uint32_t)nBytes * 9ul * 1000000ul) / displayBusClock));
+    }
+}
+
+// One I2C transaction through the byte callback: <control> (0x00 commands, 0x40 data) then <pBytes>
+void U8G2::v_sendI2C(uint8_t control, const uint8_t* pBytes, uint8_t nBytes)
+{
+    u8x8_t* pU8x8 = &u8g2.u8x8;
+    pU8x8->byte_cb(pU8x8, U8X8_MSG_BYTE_START_TRANSFER, 0, NULL);
+    pU8x8->byte_cb(pU8x8, U8X8_MSG_BYTE_SEND, 1, &control);
+    pU8x8->byte_cb(pU8x8, U8X8_MSG_BYTE_SEND, nBytes, (void*)pBytes);
+    pU8x8->byte_cb(pU8x8, U8X8_MSG_BYTE_END_TRANSFER, 0, NULL);
+}
+
+
+/** Drawing **/
+
+void U8G2::v_setPixel(int16_t x, int16_t y)
+{
+    int16_t bufferRow = (y >> 3) - currentTileRow;
+    if((x < 0) || (x >= (int16_t)U8G2_DISPLAY_WIDTH) || (y < 0) || (bufferRow < 0) || (bufferRow >= u8g2.tile_buf_height))
+    {
+        return;
+    }
+
+    uint8_t* pByte = &tileBuffer[(bufferRow * U8G2_DISPLAY_WIDTH) + x];
+    uint8_t  mask  = (uint8_t)(1u << (y & 7));
+    if(drawColor == 0)
+    {
+        *pByte &= ~mask;
+    }
+    else if(drawColor == 2)
+    {
+        *pByte ^= mask;
+    }
+    else
+    {
+        *pByte |= mask;
+    }
+}
+
+void U8G2::drawPixel(u8g2_uint_t x, u8g2_uint_t y)
+{
+    v_setPixel(x, y);
+}
+
+void U8G2::drawHLine(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w)
+{
+    uint16_t i;
+    for(i = 0; i < w; i++)
+    {
+        v_setPixel(x + i, y);
+    }
+}
+
+void U8G2::drawVLine(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t h)
+{
+    uint16_t i;
+    for(i = 0; i < h; i++)
+    {
+        v_setPixel(x, y + i);
+    }
+}
+
+void U8G2::drawLine(u8g2_uint_t x1, u8g2_uint_t y1, u8g2_uint_t x2, u8g2_uint_t y2)
+{
+    int16_t x  = x1;
+    int16_t y  = y1;
+    int16_t dx = abs((int16_t)x2 - (int16_t)x1);
+    int16_t dy = -abs((int16_t)y2 - (int16_t)y1);
+    int16_t sx = (x1 < x2) ? 1 : -1;
+    int16_t sy = (y1 < y2) ? 1 : -1;
+    int16_t err = dx + dy;
+
+    for(;;)
+    {
+        v_setPixel(x, y);
+        if((x == (int16_t)x2) && (y == (int16_t)y2))
+        {
+            break;
+        }
+        int16_t e2 = 2 * err;
+        if(e2 >= dy)
+        {
+            err += dy;
+            x += sx;
+        }
+        if(e2 <= dx)
+        {
+            err += dx;
+            y += sy;
+        }
+    }
+}
+
+void U8G2::drawBox(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h)
+{
+    uint16_t i;
+    for(i = 0; i < h; i++)
+    {
+        drawHLine(x, y + i, w);
+    }
+}
+
+void U8G2::drawFrame(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h)
+{
+    if((w == 0) || (h == 0))
+    {
+        return;
+    }
+    drawHLine(x, y, w);
+    drawHLine(x, y + h - 1, w);
+    drawVLine(x, y, h);
+    drawVLine(x + w - 1, y, h);
+}
+
+void U8G2::drawCircle(u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rad, uint8_t opt)
+{
+    (void)opt;
+    int16_t x = rad;
+    int16_t y = 0;
+    int16_t err = 1 - x;
+
+    while(x >= y)
+    {
+        v_setPixel(x0 + x, y0 + y);
+        v_setPixel(x0 + y, y0 + x);
+        v_setPixel(x0 - y, y0 + x);
+        v_setPixel(x0 - x, y0 + y);
+        v_setPixel(x0 - x, y0 - y);
+        v_setPixel(x0 - y, y0 - x);
+        v_setPixel(x0 + y, y0 - x);
+        v_setPixel(x0 + x, y0 - y);
+        y++;
+        if(err < 0)
+        {
+            err += 2 * y + 1;
+        }
+        else
+        {
+            x--;
+            err += 2 * (y - x) + 1;
+        }
+    }
+}
+
+u8g2_uint_t U8G2::u8_drawGlyph(u8g2_uint_t x, u8g2_uint_t y, char c)
+{
+    uint8_t row;
+    uint8_t column;
+    if((c < FIRST_GLYPH) || (c > LAST_GLYPH))
+    {
+        c = '?';
+    }
+
+    // Same reference as U8g2 fonts: <y> is the baseline
+    uint16_t glyph = hostFont[c - FIRST_GLYPH];
+    for(row = 0; row < GLYPH_HEIGHT; row++)
+    {
+        for(column = 0; column < GLYPH_WIDTH; column++)
+        {
+            if(glyph & (1u << ((GLYPH_HEIGHT * GLYPH_WIDTH - 1u) - (row * GLYPH_WIDTH + column))))
+            {
+                v_setPixel(x + column, (int16_t)y - (int16_t)GLYPH_HEIGHT + row);
+            }
+        }
+    }
+    return GLYPH_ADVANCE;
+}
+
+u8g2_uint_t U8G2::drawStr(u8g2_uint_t x, u8g2_uint_t y, const char* s)
+{
+    u8g2_uint_t width = 0;
+    while(*s != '\0')
+    {
+        width += u8_drawGlyph(x + width, y, *s++);
+    }
+    return width;
+}
+
+u8g2_uint_t U8G2::getStrWidth(const char* s)
+{
+    return (u8g2_uint_t)(strlen(s) * GLYPH_ADVANCE);
+}
+
+void U8G2::setCursor(u8g2_uint_t x, u8g2_uint_t y)
+{
+    cursorX = x;
+    cursorY = y;
+}
+
+size_t U8G2::write(uint8_t c)
+{
+    cursorX += u8_drawGlyph(cursorX, cursorY, (char)c);
+    return 1;
+}
+
+
+/** C API, custom transports **/
+
+void u8x8_SetPin(u8x8_t* u8x8, uint8_t pin, uint8_t val)
+{
+    if(pin < U8X8_PIN_CNT)
+    {
+        u8x8->pins[pin] = val;
+    }
+}
+
+uint8_t u8x8_gpio_and_delay_arduino(u8x8_t* u8x8, uint8_t msg, uint8_t arg_int, void* arg_ptr)
+{
+    (void)u8x8;
+    (void)msg;
+    (void)arg_int;
+    (void)arg_ptr;
+    return 1;
+}
+
+void u8g2_Setup_ssd1306_i2c_128x64_noname_1(u8g2_t* u8g2, const u8g2_cb_t* rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb)
+{
+    (void)rotation;
+    u8g2->tile_buf_height        = 1;
+    u8g2->u8x8.byte_cb           = byte_cb;
+    u8g2->u8x8.gpio_and_delay_cb = gpio_and_delay_cb;
+}
+
+void u8g2_Setup_ssd1306_i2c_128x64_noname_f(u8g2_t* u8g2, const u8g2_cb_t* rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb)
+{
+    (void)rotation;
+    u8g2->tile_buf_height        = U8G2_TILE_ROWS;
+    u8g2->u8x8.byte_cb           = byte_cb;
+    u8g2->u8x8.gpio_and_delay_cb = gpio_and_delay_cb;
+}
+
+
+/** Host harness controls **/
+
+const uint8_t* U8G2::host_getDisplayRam(void)
+{
+    return displayRam;
+}
+
+bool U8G2::host_writePBM(const char* path)
+{
+    uint8_t x;
+    uint8_t y;
+    FILE* pFile = fopen(path, "wb");
+    if(pFile == NULL)
+    {
+        return false;
+    }
+
+    // Binary (P4) PBM: rows packed MSB first, 1 is black. The display shows set pixels lit, so they are written as black on white.
+    fprintf(pFile, "P4\n%u %u\n", U8G2_DISPLAY_WIDTH, U8G2_DISPLAY_HEIGHT);
+    for(y = 0; y < U8G2_DISPLAY_HEIGHT; y++)
+    {
+        for(x = 0; x < U8G2_DISPLAY_WIDTH; x += 8)
+        {
+            uint8_t packed = 0;
+            uint8_t bitIdx;
+            for(bitIdx = 0; bitIdx < 8; bitIdx++)
+            {
+                if(displayRam[((y >> 3) * U8G2_DISPLAY_WIDTH) + x + bitIdx] & (1u << (y & 7)))
+                {
+                    packed |= (uint8_t)(0x80u >> bitIdx);
+                }
+            }
+            fputc(packed, pFile);
+        }
+    }
+    fclose(pFile);
+    return true;
+}
+
+uint32_t U8G2::host_getTileRowTransfers(void)
+{
+    return tileRowTransfers;
+}
+
+uint32_t U8G2::host_getTransferBytes(void)
+{
+    return transferBytes;
+}
+
+U8G2* host_getDisplay(void)
+{
+    return hostDisplay;
+}
+
+void host_setDisplayBusClock(uint32_t hz)
+{
+    displayBusClock = hz;
+}
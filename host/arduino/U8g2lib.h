@@ -0,0 +1,164 @@
+/**
+ * @file U8g2lib.h
+ * @author Marcelo Fraga
+ * @brief Host stand-in for the subset of U8g2 used by UiCoreFramework. Drawing goes into a page/tile buffer with the
+ *        same vertical byte layout as the SSD1306 (and U8g2), buffers are "transferred" into an emulated 128x64 display
+ *        RAM that the harness can dump as a PBM image. Only a built-in 3x5 font is available, whatever font is set.
+ *        The I2C transfer time of the real display can optionally be emulated (host_setDisplayBusClock).
+ *        Displays set up with a custom byte callback (u8g2_Setup_*) send the SSD1306 I2C stream of U8g2 through it,
+ *        the callback then accounts for the transfer time.
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef U8G2LIB_H
+#define U8G2LIB_H
+
+#include <Arduino.h>
+
+#define U8X8_PIN_NONE 255
+#define U8X8_PIN_RESET 0u
+#define U8X8_PIN_CNT   1u
+
+/** Byte callback messages **/
+#define U8X8_MSG_BYTE_INIT           20
+#define U8X8_MSG_BYTE_SEND           23
+#define U8X8_MSG_BYTE_START_TRANSFER 24
+#define U8X8_MSG_BYTE_END_TRANSFER   25
+#define U8X8_MSG_BYTE_SET_DC         32
+
+#define U8G2_DISPLAY_WIDTH   128u
+#define U8G2_DISPLAY_HEIGHT  64u
+#define U8G2_TILE_ROWS       (U8G2_DISPLAY_HEIGHT / 8u)
+
+#define U8G2_DRAW_ALL 0x0F
+
+typedef uint8_t u8g2_uint_t;
+typedef struct u8g2_cb_struct { uint8_t rotation; } u8g2_cb_t;
+extern const u8g2_cb_t u8g2_cb_r0;
+#define U8G2_R0 (&u8g2_cb_r0)
+
+typedef struct u8x8_struct u8x8_t;
+typedef uint8_t (*u8x8_msg_cb)(u8x8_t* u8x8, uint8_t msg, uint8_t arg_int, void* arg_ptr);
+struct u8x8_struct
+{
+    u8x8_msg_cb byte_cb;            // NULL: the built-in HW I2C transport
+    u8x8_msg_cb gpio_and_delay_cb;
+    uint8_t     i2c_address;        // 8 bit form, R/W bit clear
+    uint8_t     pins[U8X8_PIN_CNT];
+};
+typedef struct u8g2_struct
+{
+    u8x8_t  u8x8;
+    uint8_t tile_buf_height;
+}u8g2_t;
+
+#define u8x8_GetI2CAddress(u8x8) ((u8x8)->i2c_address)
+void    u8x8_SetPin(u8x8_t* u8x8, uint8_t pin, uint8_t val);
+uint8_t u8x8_gpio_and_delay_arduino(u8x8_t* u8x8, uint8_t msg, uint8_t arg_int, void* arg_ptr);
+void    u8g2_Setup_ssd1306_i2c_128x64_noname_1(u8g2_t* u8g2, const u8g2_cb_t* rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb);
+void    u8g2_Setup_ssd1306_i2c_128x64_noname_f(u8g2_t* u8g2, const u8g2_cb_t* rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb);
+
+extern const uint8_t u8g2_font_4x6_tf[];
+
+
+class U8G2 : public Print
+{
+public:
+    explicit U8G2(uint8_t bufferTileHeight);
+
+    bool        begin(void);
+    void        setBusClock(uint32_t clockSpeed);
+    u8x8_t*     getU8x8(void) { return &u8g2.u8x8; }
+    void        clearDisplay(void);
+    void        setFont(const uint8_t* font);
+    void        setDrawColor(uint8_t color);
+
+    /** Page buffer loop **/
+    void        firstPage(void);
+    uint8_t     nextPage(void);
+
+    /** Manual buffer handling **/
+    void        clearBuffer(void);
+    void        sendBuffer(void);
+    void        setBufferCurrTileRow(uint8_t row);
+    uint8_t     getBufferCurrTileRow(void);
+    uint8_t     getBufferTileHeight(void);
+    uint8_t*    getBufferPtr(void);
+    void        updateDisplayArea(uint8_t tx, uint8_t ty, uint8_t tw, uint8_t th);
+    void        updateDisplay(void);
+
+    u8g2_uint_t getDisplayWidth(void)  { return U8G2_DISPLAY_WIDTH; }
+    u8g2_uint_t getDisplayHeight(void) { return U8G2_DISPLAY_HEIGHT; }
+
+    /** Drawing **/
+    void        drawPixel(u8g2_uint_t x, u8g2_uint_t y);
+    void        drawHLine(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w);
+    void        drawVLine(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t h);
+    void        drawLine(u8g2_uint_t x1, u8g2_uint_t y1, u8g2_uint_t x2, u8g2_uint_t y2);
+    void        drawBox(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h);
+    void        drawFrame(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h);
+    void        drawCircle(u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rad, uint8_t opt = U8G2_DRAW_ALL);
+    u8g2_uint_t drawStr(u8g2_uint_t x, u8g2_uint_t y, const char* s);
+    u8g2_uint_t getStrWidth(const char* s);
+    void        setCursor(u8g2_uint_t x, u8g2_uint_t y);
+
+    size_t      write(uint8_t c);
+    using Print::write;
+
+    /** Host harness controls. Not part of the U8g2 API **/
+    const uint8_t* host_getDisplayRam(void);
+    bool           host_writePBM(const char* path);
+    uint32_t       host_getTileRowTransfers(void);
+    uint32_t       host_getTransferBytes(void);   // Bytes sent over the bus, addressing and framing included
+
+protected:
+    U8G2(void); // Set up later with a u8g2_Setup_* function
+
+    u8g2_t   u8g2;
+
+private:
+    void        v_init(uint8_t tileHeight);
+    void        v_sendI2C(uint8_t control, const uint8_t* pBytes, uint8_t nBytes);
+    void        v_setPixel(int16_t x, int16_t y);
+    void        v_transferTileRows(uint8_t firstRow, uint8_t nRows, uint8_t firstColumn, uint8_t nColumns);
+    u8g2_uint_t u8_drawGlyph(u8g2_uint_t x, u8g2_uint_t y, char c);
+
+    uint8_t  tileBuffer[U8G2_TILE_ROWS * U8G2_DISPLAY_WIDTH];
+    uint8_t  displayRam[U8G2_TILE_ROWS * U8G2_DISPLAY_WIDTH];
+    uint8_t  currentTileRow;
+    uint8_t  drawColor;
+    uint8_t  cursorX;
+    uint8_t  cursorY;
+    uint32_t tileRowTransfers;
+    uint32_t transferBytes;
+};
+
+class U8G2_SSD1306_128X64_NONAME_1_HW_I2C : public U8G2
+{
+public:
+    U8G2_SSD1306_128X64_NONAME_1_HW_I2C(const u8g2_cb_t* /* rotation */, uint8_t /* reset */ = U8X8_PIN_NONE, uint8_t /* clock */ = U8X8_PIN_NONE, uint8_t /* data */ = U8X8_PIN_NONE) : U8G2(1) {}
+};
+
+class U8G2_SSD1306_128X64_NONAME_2_HW_I2C : public U8G2
+{
+public:
+    U8G2_SSD1306_128X64_NONAME_2_HW_I2C(const u8g2_cb_t* /* rotation */, uint8_t /* reset */ = U8X8_PIN_NONE, uint8_t /* clock */ = U8X8_PIN_NONE, uint8_t /* data */ = U8X8_PIN_NONE) : U8G2(2) {}
+};
+
+class U8G2_SSD1306_128X64_NONAME_F_HW_I2C : public U8G2
+{
+public:
+    U8G2_SSD1306_128X64_NONAME_F_HW_I2C(const u8g2_cb_t* /* rotation */, uint8_t /* reset */ = U8X8_PIN_NONE, uint8_t /* clock */ = U8X8_PIN_NONE, uint8_t /* data */ = U8X8_PIN_NONE) : U8G2(U8G2_TILE_ROWS) {}
+};
+
+
+/** Host harness controls. Not part of the U8g2 API **/
+U8G2* host_getDisplay(void); // Last display constructed by the sketch, NULL if none
+// Emulates the blocking I2C transfer time of each display update at the given bus clock. 0 (default) disables it.
+void host_setDisplayBusClock(uint32_t hz);
+
+#endif
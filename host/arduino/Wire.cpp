@@ -0,0 +1,14 @@
+/**
+ * @file Wire.cpp
+ * @author Marcelo Fraga
+ * @brief Host instance of the Wire stand-in. See Wire.h
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "Wire.h"
+
+TwoWire Wire;
@@ -0,0 +1,30 @@
+/**
+ * @file Wire.h
+ * @author Marcelo Fraga
+ * @brief Host stand-in for the Arduino Wire (I2C) library. Transfers are accepted and discarded, the display
+ *        stand-in doesn't go through it.
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef WIRE_H
+#define WIRE_H
+
+#include <Arduino.h>
+
+class TwoWire
+{
+public:
+    void    begin(void)                      {}
+    void    setClock(uint32_t clock)         { (void)clock; }
+    void    beginTransmission(uint8_t addr)  { (void)addr; }
+    size_t  write(uint8_t data)              { (void)data; return 1; }
+    uint8_t endTransmission(bool stop = true){ (void)stop; return 0; }
+};
+
+extern TwoWire Wire;
+
+#endif
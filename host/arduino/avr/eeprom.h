@@ -0,0 +1,36 @@
+/**
+ * @file eeprom.h
+ * @author Marcelo Fraga
+ * @brief Host stand-in for avr/eeprom.h. 1KB of EEPROM (ATmega328), erased to 0xFF. A byte write keeps the EEPROM
+ *        busy for 3.3ms of (host) time like the real one, eeprom_is_ready() reports it. Writing while busy waits,
+ *        like avr-libc does. The contents can be loaded from / saved to a file to emulate power cycles.
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef EEPROM_H
+#define EEPROM_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#define E2END 0x3FF
+
+bool    eeprom_is_ready(void);
+uint8_t eeprom_read_byte(const uint8_t* addr);
+void    eeprom_read_block(void* dst, const void* src, size_t n);
+void    eeprom_write_byte(uint8_t* addr, uint8_t value);
+void    eeprom_update_byte(uint8_t* addr, uint8_t value);
+
+
+/** Host harness controls. Not part of avr-libc **/
+bool     host_loadEeprom(const char* path);   // False if the file can't be read, the EEPROM then stays erased
+bool     host_saveEeprom(const char* path);
+void     host_eraseEeprom(void);              // Every byte back to 0xFF, like a chip erase
+uint32_t host_getEepromWrites(void);          // Byte writes so far (updates that changed nothing aren't writes)
+
+#endif
@@ -0,0 +1,33 @@
+/**
+ * @file pgmspace.h
+ * @author Marcelo Fraga
+ * @brief Host stand-in for avr/pgmspace.h. There is a single address space on the host, so PROGMEM
+ *        data is ordinary const data and the pgm_read_* accessors are plain dereferences.
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef PGMSPACE_H
+#define PGMSPACE_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PGM_P              const char*
+#define PSTR(s)            (s)
+
+#define pgm_read_byte(addr)  (*(const uint8_t*)(addr))
+#define pgm_read_word(addr)  (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+#define pgm_read_ptr(addr)   (*(void* const*)(addr))
+
+#define memcpy_P   memcpy
+#define strlen_P   strlen
+#define strncpy_P  strncpy
+#define strcmp_P   strcmp
+
+#endif
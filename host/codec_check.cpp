@@ -0,0 +1,117 @@
+/**
+ * @file codec_check.cpp
+ * @brief Known input, expected output checks of the payload codec (libraries/RCLink/PayloadCodec): keyframe and delta
+ *        round trips, no delta before the keyframe is acknowledged, a step too wide for a delta, and inputs above
+ *        PAYLOAD_CHANNEL_MAX_VALUE in both frame kinds. Each case is a few frames encoded and decoded in turn, with
+ *        the expected frame kind and the hand computed decoded values. The exit code is 1 if any frame is off.
+ *
+ *        Usage: codec_check
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "PayloadCodec.h"
+
+#define CHECK_MAX_FRAMES  4u
+
+typedef struct CheckFrame_t
+{
+    uint16_t inputs[PAYLOAD_N_CHANNELS];
+    bool     b_Ack;                        // The receiver acknowledges the frame
+    char     kind;                         // 'K' keyframe, 'D' delta frame
+    uint16_t expected[PAYLOAD_N_CHANNELS];
+}CheckFrame_t;
+
+typedef struct CheckCase_t
+{
+    const char*  name;
+    uint8_t      nFrames;
+    CheckFrame_t frames[CHECK_MAX_FRAMES];
+}CheckCase_t;
+
+// Channels 0 - 5 analog, 6 and 7 switches (PAYLOAD_DIGITAL_CHANNEL_MASK)
+static const CheckCase_t checkCases[] =
+{
+    {"round trip", 3u, {{{0, 1023, 512, 300, 7, 900, 1023, 0}, true, 'K', {0, 1023, 512, 300, 7, 900, 1023, 0}},
+                        {{1, 1022, 513, 299, 7, 900, 0, 1023}, true, 'D', {1, 1022, 513, 299, 7, 900, 0, 1023}},
+                        {{40, 990, 560, 250, 7, 900, 0, 1023}, true, 'D', {40, 990, 560, 250, 7, 900, 0, 1023}}}},
+
+    // Deltas only refer to an acknowledged keyframe
+    {"no ack", 3u, {{{512, 512, 512, 512, 512, 512, 0, 0}, false, 'K', {512, 512, 512, 512, 512, 512, 0, 0}},
+                    {{513, 512, 512, 512, 512, 512, 0, 0}, true, 'K', {513, 512, 512, 512, 512, 512, 0, 0}},
+                    {{514, 512, 512, 512, 512, 512, 0, 0}, true, 'D', {514, 512, 512, 512, 512, 512, 0, 0}}}},
+
+    // Switches are sent as 1 bit, above or below half range
+    {"switches", 2u, {{{0, 0, 0, 0, 0, 0, 511, 512}, true, 'K', {0, 0, 0, 0, 0, 0, 0, 1023}},
+                      {{0, 0, 0, 0, 0, 0, 900, 3}, true, 'D', {0, 0, 0, 0, 0, 0, 1023, 0}}}},
+
+    // A delta frame as big as a keyframe is sent as a keyframe
+    {"wide step", 2u, {{{0, 0, 0, 0, 0, 0, 0, 0}, true, 'K', {0, 0, 0, 0, 0, 0, 0, 0}},
+                       {{1023, 0, 0, 0, 0, 0, 0, 0}, true, 'K', {1023, 0, 0, 0, 0, 0, 0, 0}}}},
+
+    {"clamp key", 1u, {{{1024, 1500, 0xFFFF, 512, 512, 512, 0, 0}, true, 'K', {1023, 1023, 1023, 512, 512, 512, 0, 0}}}},
+
+    // The deltas are taken from the clamped input: 1030 against 1020 is +3, not +10 (wrapped to 6 by the receiver)
+    {"clamp delta", 3u, {{{1020, 1020, 512, 512, 512, 512, 0, 0}, true, 'K', {1020, 1020, 512, 512, 512, 512, 0, 0}},
+                         {{1030, 1020, 512, 512, 512, 512, 0, 0}, true, 'D', {1023, 1020, 512, 512, 512, 512, 0, 0}},
+                         {{1021, 1040, 512, 512, 512, 512, 0, 0}, true, 'D', {1021, 1023, 512, 512, 512, 512, 0, 0}}}},
+};
+
+
+int main()
+{
+    PldEncoder_t encoder;
+    PldDecoder_t decoder;
+    uint8_t      buffer[PAYLOAD_MAX_SIZE];
+    uint16_t     outputs[PAYLOAD_N_CHANNELS];
+    unsigned int failures = 0;
+    uint8_t      c;
+    uint8_t      f;
+    uint8_t      d;
+
+    for(c = 0; c < (sizeof(checkCases) / sizeof(checkCases[0])); c++)
+    {
+        const CheckCase_t* pCase  = &checkCases[c];
+        bool               caseOk = true;
+
+        v_Pld_initEncoder(&encoder, true);
+        v_Pld_initDecoder(&decoder);
+
+        for(f = 0; f < pCase->nFrames; f++)
+        {
+            const CheckFrame_t* pFrame = &pCase->frames[f];
+            uint8_t             size   = u8_Pld_encode(&encoder, pFrame->inputs, buffer);
+            char                kind   = (buffer[0] & 0x08u) ? 'D' : 'K'; // Delta flag of the header
+
+            memset(outputs, 0, sizeof(outputs));
+            if(!b_Pld_decode(&decoder, buffer, size, outputs))
+            {
+                printf("  %s: frame %u (%u bytes) not decoded\n", pCase->name, f, size);
+                caseOk = false;
+                continue;
+            }
+            if(kind != pFrame->kind)
+            {
+                printf("  %s: frame %u is a %c frame, expected %c\n", pCase->name, f, kind, pFrame->kind);
+                caseOk = false;
+            }
+            for(d = 0; d < PAYLOAD_N_CHANNELS; d++)
+            {
+                if(outputs[d] != pFrame->expected[d])
+                {
+                    printf("  %s: frame %u channel %u is %u, expected %u\n", pCase->name, f, d, outputs[d], pFrame->expected[d]);
+                    caseOk = false;
+                }
+            }
+            if(pFrame->b_Ack)
+            {
+                v_Pld_acknowledge(&encoder);
+            }
+        }
+        printf("%-13s %-4s %u frames\n", pCase->name, caseOk ? "ok" : "FAIL", pCase->nFrames);
+        failures += caseOk ? 0u : 1u;
+    }
+
+    printf("%u failed\n", failures);
+    return (failures == 0u) ? 0 : 1;
+}
@@ -0,0 +1,207 @@
+/**
+ * @file filter_bench.cpp
+ * @brief Lag and noise of the channel input filters (RCRemote/ChannelFilter), at SAMPLE_RATE_HZ.
+ *        Synthetic traces, all with the same seeded noise:
+ *          rest   Stick centered, gaussian noise (sigma 1.5 LSB) and a +-60 LSB spike every 200 samples.
+ *                 Reports the RMS and the maximum deviation from the center.
+ *          step   Noise free step from 200 to 800. Reports the time to 50% and to 90% of the step.
+ *          sweep  Noisy 2Hz full range sine, like a stick moved fast. Reports the lag (the delay of the noise free
+ *                 input that best matches the output) and the RMS error left at that delay.
+ *        With --trace FILE, a recorded trace (one 10 bit sample per line, e.g. logged u16_RawValue values with every
+ *        filter off) is run through every filter as well: lag and RMS error are then measured against the trace itself.
+ *
+ *        Usage: filter_bench [--trace FILE]
+ */
+
+#include <Arduino.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ChannelFilter.h"
+
+#define BENCH_MAX_SAMPLES 20000u
+#define BENCH_MAX_SHIFT   100u // Lags searched, in samples
+
+typedef struct BenchFilter_t
+{
+    const char* name;
+    FltConfig_t config;
+}BenchFilter_t;
+
+static const BenchFilter_t benchFilters[] =
+    // Name,              Median,          Smoothing,              EMA alpha,                   Min cutoff,                  Beta
+    {{"none",            {FLT_MEDIAN_NONE, FLT_SMOOTHING_NONE,     0u,                          0u,                          0u}},
+     {"ema 0.85",        {FLT_MEDIAN_NONE, FLT_SMOOTHING_EMA,      FLT_EMA_ALPHA_Q8(0.85f),     0u,                          0u}},
+     {"ema 0.25",        {FLT_MEDIAN_NONE, FLT_SMOOTHING_EMA,      FLT_EMA_ALPHA_Q8(0.25f),     0u,                          0u}},
+     {"median 3",        {FLT_MEDIAN_3,    FLT_SMOOTHING_NONE,     0u,                          0u,                          0u}},
+     {"median 5",        {FLT_MEDIAN_5,    FLT_SMOOTHING_NONE,     0u,                          0u,                          0u}},
+     {"1-euro",          {FLT_MEDIAN_NONE, FLT_SMOOTHING_ONE_EURO, 0u,                          FLT_MIN_CUTOFF_X10(ONE_EURO_MIN_CUTOFF_HZ), FLT_BETA_MILLI(ONE_EURO_BETA)}},
+     {"median 3+1-euro", {FLT_MEDIAN_3,    FLT_SMOOTHING_ONE_EURO, 0u,                          FLT_MIN_CUTOFF_X10(ONE_EURO_MIN_CUTOFF_HZ), FLT_BETA_MILLI(ONE_EURO_BETA)}},
+     {"median 3+ema",    {FLT_MEDIAN_3,    FLT_SMOOTHING_EMA,      FLT_EMA_ALPHA_Q8(EMA_ALPHA_VALUE), 0u,                    0u}}};
+#define N_BENCH_FILTERS (sizeof(benchFilters) / sizeof(BenchFilter_t))
+
+static uint16_t clean[BENCH_MAX_SAMPLES];
+static uint16_t input[BENCH_MAX_SAMPLES];
+static uint16_t output[BENCH_MAX_SAMPLES];
+static uint32_t randomState = 12345u;
+
+
+static double d_uniform()
+{
+    randomState = randomState * 1103515245u + 12345u;
+    return ((randomState >> 8) + 0.5) / 16777216.0;
+}
+
+static double d_gaussian(double sigma)
+{
+    return sigma * sqrt(-2.0 * log(d_uniform())) * cos(2.0 * PI * d_uniform());
+}
+
+static uint16_t u16_clampSample(double value)
+{
+    return (uint16_t)constrain(lround(value), (long)ANALOG_MIN_VALUE, (long)ANALOG_MAX_VALUE);
+}
+
+static void v_run(const FltConfig_t* pConfig, const uint16_t* pInput, uint16_t* pOutput, uint32_t nSamples)
+{
+    uint32_t i;
+    v_Flt_init(pConfig); // Channel 0 only
+    for(i = 0; i < nSamples; i++)
+    {
+        pOutput[i] = u16_Flt_apply(0u, pInput[i]);
+    }
+}
+
+// Delay (in samples) of <pReference> that best matches <pOutput>, and the RMS error at that delay
+static uint32_t u32_lag(const uint16_t* pReference, const uint16_t* pOutput, uint32_t nSamples, double* pRms)
+{
+    uint32_t bestShift = 0u;
+    double   bestError = -1.0;
+    uint32_t shift;
+    uint32_t i;
+    for(shift = 0; shift <= BENCH_MAX_SHIFT; shift++)
+    {
+        double error = 0.0;
+        for(i = BENCH_MAX_SHIFT; i < nSamples; i++)
+        {
+            double difference = (double)pOutput[i] - pReference[i - shift];
+            error += difference * difference;
+        }
+        if((bestError < 0.0) || (error < bestError))
+        {
+            bestError = error;
+            bestShift = shift;
+        }
+    }
+    *pRms = sqrt(bestError / (nSamples - BENCH_MAX_SHIFT));
+    return bestShift;
+}
+
+static double d_samplesToMs(double samples)
+{
+    return (samples * 1000.0) / SAMPLE_RATE_HZ;
+}
+
+static uint32_t u32_readTrace(const char* path)
+{
+    FILE*         file = fopen(path, "r");
+    unsigned long value;
+    uint32_t      nSamples = 0u;
+    if(file == NULL)
+    {
+        return 0u;
+    }
+    while((nSamples < BENCH_MAX_SAMPLES) && (fscanf(file, "%lu", &value) == 1))
+    {
+        input[nSamples++] = (uint16_t)min(value, (unsigned long)ANALOG_MAX_VALUE);
+    }
+    fclose(file);
+    return nSamples;
+}
+
+int main(int argc, char** argv)
+{
+    const uint32_t nSamples = 4u * SAMPLE_RATE_HZ;
+    const char*    tracePath = NULL;
+    uint32_t       f;
+    uint32_t       i;
+
+    if((argc == 3) && !strcmp(argv[1], "--trace"))
+    {
+        tracePath = argv[2];
+    }
+    else if(argc != 1)
+    {
+        fprintf(stderr, "Usage: %s [--trace FILE]\n", argv[0]);
+        return 2;
+    }
+
+    printf("%u Hz sampling. Times in ms\n", (unsigned)SAMPLE_RATE_HZ);
+    printf("%-16s %10s %10s %10s %10s %10s %10s\n", "filter", "rest rms", "rest max", "step 50%", "step 90%", "sweep lag", "sweep rms");
+    for(f = 0; f < N_BENCH_FILTERS; f++)
+    {
+        double   restRms = 0.0;
+        uint16_t restMax = 0u;
+        double   sweepRms;
+        int32_t  step50  = -1;
+        int32_t  step90  = -1;
+
+        randomState = 12345u;
+        for(i = 0; i < nSamples; i++)
+        {
+            input[i] = u16_clampSample(ANALOG_HALF_VALUE + d_gaussian(1.5) + (((i % 200u) == 199u) ? ((i & 0x100u) ? 60.0 : -60.0) : 0.0));
+        }
+        v_run(&benchFilters[f].config, input, output, nSamples);
+        for(i = SAMPLE_RATE_HZ / 2u; i < nSamples; i++) // Half a second to settle
+        {
+            int32_t deviation = (int32_t)output[i] - ANALOG_HALF_VALUE;
+            restRms += (double)deviation * deviation;
+            restMax  = max(restMax, (uint16_t)abs(deviation));
+        }
+        restRms = sqrt(restRms / (nSamples - SAMPLE_RATE_HZ / 2u));
+
+        for(i = 0; i < nSamples; i++)
+        {
+            input[i] = (i < SAMPLE_RATE_HZ) ? 200u : 800u;
+        }
+        v_run(&benchFilters[f].config, input, output, nSamples);
+        for(i = SAMPLE_RATE_HZ; i < nSamples; i++)
+        {
+            if((step50 < 0) && (output[i] >= 500u)) step50 = (int32_t)(i - SAMPLE_RATE_HZ);
+            if((step90 < 0) && (output[i] >= 740u)) step90 = (int32_t)(i - SAMPLE_RATE_HZ);
+        }
+
+        randomState = 12345u;
+        for(i = 0; i < nSamples; i++)
+        {
+            clean[i] = u16_clampSample(ANALOG_HALF_VALUE + 500.0 * sin((2.0 * PI * 2.0 * i) / SAMPLE_RATE_HZ));
+            input[i] = u16_clampSample(clean[i] + d_gaussian(1.5));
+        }
+        v_run(&benchFilters[f].config, input, output, nSamples);
+        uint32_t sweepLag = u32_lag(clean, output, nSamples, &sweepRms);
+
+        printf("%-16s %10.2f %10u %10.1f %10.1f %10.1f %10.2f\n", benchFilters[f].name, restRms, restMax,
+               d_samplesToMs(step50), d_samplesToMs(step90), d_samplesToMs(sweepLag), sweepRms);
+    }
+
+    if(tracePath != NULL)
+    {
+        uint32_t nTrace = u32_readTrace(tracePath);
+        if(nTrace <= BENCH_MAX_SHIFT)
+        {
+            fprintf(stderr, "%s: not enough samples\n", tracePath);
+            return 1;
+        }
+        printf("\n%s, %u samples\n", tracePath, (unsigned)nTrace);
+        printf("%-16s %10s %10s\n", "filter", "lag", "rms");
+        for(f = 0; f < N_BENCH_FILTERS; f++)
+        {
+            double rms;
+            v_run(&benchFilters[f].config, input, output, nTrace);
+            uint32_t lag = u32_lag(input, output, nTrace, &rms);
+            printf("%-16s %10.1f %10.2f\n", benchFilters[f].name, d_samplesToMs(lag), rms);
+        }
+    }
+    return 0;
+}
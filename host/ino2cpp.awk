@@ -0,0 +1,43 @@
+# Turns an Arduino sketch (.ino) into a plain C++ translation unit the same way the Arduino builder does:
+# Arduino.h is included first and a prototype for every top level function is inserted before the first
+# function definition, so functions can be used before they are defined.
+# Usage: awk -f ino2cpp.awk Sketch.ino Sketch.ino > Sketch.ino.cpp (the sketch is read twice)
+
+function isFunctionDefinition(line)
+{
+    if(line ~ /;/ || line ~ /^(if|else|for|while|switch|return|typedef|struct|enum|class|static_assert)[ (]/)
+    {
+        return 0;
+    }
+    return line ~ /^[A-Za-z_][A-Za-z0-9_<>:\*& ]*[ \*&]+[A-Za-z_][A-Za-z0-9_]*[ ]*\(.*\)[ ]*(\/\/.*)?$/;
+}
+
+FNR == NR {
+    if(isFunctionDefinition($0))
+    {
+        prototype = $0;
+        sub(/[ ]*\/\/.*$/, "", prototype);
+        sub(/[ ]+$/, "", prototype);
+        gsub(/=[^,)]*/, "", prototype); # Default arguments can only be given once
+        prototypes[nPrototypes++] = prototype ";";
+    }
+    next;
+}
+
+FNR == 1 {
+    print "#include <Arduino.h>";
+    printf "#line 1 \"%s\"\n", FILENAME;
+}
+
+!inserted && isFunctionDefinition($0) {
+    for(i = 0; i < nPrototypes; i++)
+    {
+        print prototypes[i];
+    }
+    printf "#line %d \"%s\"\n", FNR, FILENAME;
+    inserted = 1;
+}
+
+{
+    print;
+}
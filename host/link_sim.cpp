@@ -0,0 +1,360 @@
+/**
+ * @file link_sim.cpp
+ * @author Marcelo Fraga
+ * @brief End to end host simulation of the radio link: the transmitter sketch (RCRemote) and the receiver sketch
+ *        (RCReceiver) run in the same process, on the same virtual time, one loop() of each per step. Their RF24
+ *        stand-ins share the simulated ether, which loses attempts (--loss, --interference, --path-loss) and delays
+ *        every payload before the receiver can read it (--latency, --jitter). Nothing is looped back to the harness:
+ *        a frame only gets an ACK when the receiver is listening on its channel, at its data rate.
+ *
+ *        The harness measures, from the outside of both sketches:
+ *         - Throughput: channel frames the receiver got per second, and the frames it missed (its telemetry).
+ *         - End to end latency: the left switch of the transmitter is toggled every 100 - 140ms, the time until its
+ *           servo output follows is taken, from the input pin to the pulse width.
+ *         - Failsafe: during each --outage START_MS:LENGTH_MS every attempt is lost. Time until the throttle output
+ *           goes to its failsafe value, and time after the outage until the receiver acknowledges frames again (its
+ *           telemetry moves) with the outputs out of failsafe. Failsafe entries before that count for the outage.
+ *        The exit code is 1 if no frame got through, if an outage longer than FAILSAFE_TIMEOUT_MS didn't end in
+ *        failsafe within FAILSAFE_TIMEOUT_MS plus a TX period, if an outage shorter than FAILSAFE_TIMEOUT_MS minus two
+ *        TX periods did, or if the link never came back.
+ *
+ *        Usage: rclink_host [--seconds S] [--step US] [--loss PERCENT] [--latency US] [--jitter US]
+ *                           [--interference FIRST-LAST:PERCENT]... [--path-loss DB] [--outage START_MS:LENGTH_MS]...
+ *                           [--verbose]
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <Arduino.h>
+#include <RF24.h>
+#include <Servo.h>
+#include "Configuration.h"
+#include "ReceiverConfiguration.h"
+#include "RateControl.h"
+
+void setup();
+void loop();
+void receiver_setup(); // RCReceiver setup() and loop(), renamed by the Makefile
+void receiver_loop();
+extern RemoteCommunicationState_t RemoteCommunicationState;
+
+#define LINK_MAX_INTERFERENCE   4u
+#define LINK_MAX_OUTAGES        4u
+#define LINK_MAX_PROBES         4096u
+#define LINK_PROBE_PERIOD_MS    100ul // Plus 0 - LINK_PROBE_SPREAD_MS, so probes land anywhere in the TX period
+#define LINK_PROBE_SPREAD_MS    40ul
+#define LINK_NONE               0xFFFFFFFFul
+#define LINK_THROTTLE_IDX       JOYSTICK_LEFT_AXIS_Y_CHANNEL_IDX
+#define LINK_PROBE_IDX          SWITCH_SP_LEFT_CHANNEL_IDX
+#define LINK_FAILSAFE_MARGIN_MS (1000ul / TX_RATE_HZ)
+
+typedef struct LinkInterference_t
+{
+    uint8_t firstChannel;
+    uint8_t lastChannel;
+    uint8_t percent;
+}LinkInterference_t;
+
+typedef struct LinkOutage_t
+{
+    unsigned long start;       // In ms of simulated time
+    unsigned long length;
+    unsigned long failsafeAt;  // LINK_NONE until seen
+    unsigned long recoveredAt; // Same
+}LinkOutage_t;
+
+typedef struct LinkOptions_t
+{
+    unsigned long seconds;
+    unsigned long step;        // uSeconds of virtual time per loop() of each sketch
+    uint8_t       lossPercent;
+    unsigned long latency;
+    unsigned long jitter;
+    uint8_t       pathLoss;
+    bool          verbose;
+    LinkInterference_t interference[LINK_MAX_INTERFERENCE];
+    uint8_t       nInterference;
+    LinkOutage_t  outages[LINK_MAX_OUTAGES];
+    uint8_t       nOutages;
+}LinkOptions_t;
+
+typedef struct LinkProbes_t
+{
+    unsigned long nextToggle;  // millis()
+    unsigned long toggleTime;  // micros() of the pending probe, LINK_NONE if none
+    bool          level;
+    unsigned long missed;      // Still pending at the next toggle
+    uint16_t      count;
+    unsigned long latencies[LINK_MAX_PROBES];
+    uint32_t      random;
+}LinkProbes_t;
+
+typedef struct LinkFailsafe_t
+{
+    bool          active;
+    unsigned long entries;
+    unsigned long spuriousEntries; // Outside of any outage and its recovery
+    unsigned long time;            // uSeconds spent in failsafe
+    uint16_t      rxReceived;      // Receiver telemetry of the previous step
+}LinkFailsafe_t;
+
+static LinkProbes_t probes; // Large, kept off the stack
+
+
+static void v_printUsage(const char* program)
+{
+    fprintf(stderr, "Usage: %s [--seconds S] [--step US] [--loss PERCENT] [--latency US] [--jitter US]\n"
+                    "          [--interference FIRST-LAST:PERCENT]... [--path-loss DB] [--outage START_MS:LENGTH_MS]...\n"
+                    "          [--verbose]\n", program);
+}
+
+static bool b_parseOptions(int argc, char** argv, LinkOptions_t* pOptions)
+{
+    int i;
+    for(i = 1; i < argc; i++)
+    {
+        bool hasValue = (i + 1) < argc;
+        if(!strcmp(argv[i], "--seconds") && hasValue)        { pOptions->seconds = strtoul(argv[++i], NULL, 10); }
+        else if(!strcmp(argv[i], "--step") && hasValue)      { pOptions->step = strtoul(argv[++i], NULL, 10); }
+        else if(!strcmp(argv[i], "--loss") && hasValue)      { pOptions->lossPercent = (uint8_t)strtoul(argv[++i], NULL, 10); }
+        else if(!strcmp(argv[i], "--latency") && hasValue)   { pOptions->latency = strtoul(argv[++i], NULL, 10); }
+        else if(!strcmp(argv[i], "--jitter") && hasValue)    { pOptions->jitter = strtoul(argv[++i], NULL, 10); }
+        else if(!strcmp(argv[i], "--path-loss") && hasValue) { pOptions->pathLoss = (uint8_t)strtoul(argv[++i], NULL, 10); }
+        else if(!strcmp(argv[i], "--verbose"))               { pOptions->verbose = true; }
+        else if(!strcmp(argv[i], "--interference") && hasValue && (pOptions->nInterference < LINK_MAX_INTERFERENCE))
+        {
+            unsigned int first;
+            unsigned int last;
+            unsigned int percent;
+            if(sscanf(argv[++i], "%u-%u:%u", &first, &last, &percent) != 3)
+            {
+                return false;
+            }
+            pOptions->interference[pOptions->nInterference++] = {(uint8_t)first, (uint8_t)last, (uint8_t)percent};
+        }
+        else if(!strcmp(argv[i], "--outage") && hasValue && (pOptions->nOutages < LINK_MAX_OUTAGES))
+        {
+            unsigned long start;
+            unsigned long length;
+            if(sscanf(argv[++i], "%lu:%lu", &start, &length) != 2)
+            {
+                return false;
+            }
+            pOptions->outages[pOptions->nOutages++] = {start, length, LINK_NONE, LINK_NONE};
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return (pOptions->step > 0ul) && (pOptions->seconds > 0ul);
+}
+
+// Outage of the current time, NULL if none
+static LinkOutage_t* p_activeOutage(LinkOptions_t* pOptions, unsigned long now)
+{
+    uint8_t i;
+    for(i = 0; i < pOptions->nOutages; i++)
+    {
+        if((now >= pOptions->outages[i].start) && (now < (pOptions->outages[i].start + pOptions->outages[i].length)))
+        {
+            return &pOptions->outages[i];
+        }
+    }
+    return NULL;
+}
+
+// Failsafe entry and recovery of every outage, and failsafe seen outside of them
+static void v_watchFailsafe(LinkOptions_t* pOptions, LinkFailsafe_t* pFailsafe, bool inFailsafe, unsigned long now)
+{
+    bool    entered  = inFailsafe && !pFailsafe->active;
+    bool    frames   = RemoteCommunicationState.u16_RxReceived != pFailsafe->rxReceived;
+    bool    spurious = entered;
+    uint8_t i;
+
+    for(i = 0; i < pOptions->nOutages; i++)
+    {
+        LinkOutage_t* pOutage = &pOptions->outages[i];
+        if((now < pOutage->start) || (pOutage->recoveredAt != LINK_NONE))
+        {
+            continue;
+        }
+        spurious = false;
+        if(entered && (pOutage->failsafeAt == LINK_NONE))
+        {
+            pOutage->failsafeAt = now;
+        }
+        if(frames && !inFailsafe && (now >= (pOutage->start + pOutage->length)))
+        {
+            pOutage->recoveredAt = now;
+        }
+    }
+    pFailsafe->entries         += entered ? 1u : 0u;
+    pFailsafe->spuriousEntries += spurious ? 1u : 0u;
+    pFailsafe->active           = inFailsafe;
+    pFailsafe->time            += inFailsafe ? pOptions->step : 0ul;
+    pFailsafe->rxReceived       = RemoteCommunicationState.u16_RxReceived;
+}
+
+// Toggles the left switch of the transmitter and times its servo output. No new probe in failsafe
+static void v_runProbes(LinkProbes_t* pProbes, bool inFailsafe, bool outage)
+{
+    unsigned long now   = micros();
+    uint16_t      pulse = host_getServoPulse(LINK_PROBE_IDX);
+
+    if((pProbes->toggleTime != LINK_NONE) && ((pulse > ((SERVO_PULSE_MIN_US + SERVO_PULSE_MAX_US) / 2u)) == pProbes->level))
+    {
+        if(pProbes->count < LINK_MAX_PROBES)
+        {
+            pProbes->latencies[pProbes->count++] = now - pProbes->toggleTime;
+        }
+        pProbes->toggleTime = LINK_NONE;
+    }
+    if(millis() < pProbes->nextToggle)
+    {
+        return;
+    }
+    if(pProbes->toggleTime != LINK_NONE)
+    {
+        pProbes->missed++;
+        pProbes->toggleTime = LINK_NONE;
+    }
+    pProbes->random     = pProbes->random * 1103515245ul + 12345ul;
+    pProbes->nextToggle = millis() + LINK_PROBE_PERIOD_MS + ((pProbes->random >> 16) % (LINK_PROBE_SPREAD_MS + 1ul));
+    if(inFailsafe || outage)
+    {
+        return;
+    }
+    pProbes->level      = !pProbes->level;
+    pProbes->toggleTime = now;
+    host_setDigitalValue(SWITCH_SP_LEFT_PIN, pProbes->level ? HIGH : LOW);
+}
+
+static int i_compareLatencies(const void* a, const void* b)
+{
+    unsigned long x = *(const unsigned long*)a;
+    unsigned long y = *(const unsigned long*)b;
+    return (x > y) - (x < y);
+}
+
+int main(int argc, char** argv)
+{
+    LinkOptions_t  options = {10ul, 100ul, 0u, 0ul, 0ul, 0u, false, {}, 0u, {}, 0u};
+    LinkFailsafe_t failsafe = {true, 0ul, 0ul, 0ul, 0u};
+    uint16_t       failsafePulse;
+    unsigned long  steps;
+    unsigned long  i;
+    uint8_t        pin;
+    bool           errors = false;
+
+    if(!b_parseOptions(argc, argv, &options))
+    {
+        v_printUsage(argv[0]);
+        return 1;
+    }
+
+    host_setSerialOutput(options.verbose ? stdout : NULL);
+    host_useVirtualTime(true);
+    host_setRadioLoopbackAck(false); // Only the receiver sketch ACKs
+    host_setRadioLossPercent(options.lossPercent);
+    host_setRadioLatency(options.latency, options.jitter);
+    host_setRadioPathLoss(options.pathLoss);
+    for(i = 0; i < options.nInterference; i++)
+    {
+        host_setRadioInterference(options.interference[i].firstChannel, options.interference[i].lastChannel, options.interference[i].percent);
+    }
+    for(pin = 2; pin < 8; pin++)
+    {
+        host_setDigitalValue(pin, HIGH); // Buttons released, switches up
+    }
+    for(pin = A0; pin <= A7; pin++)
+    {
+        host_setAnalogValue(pin, ANALOG_HALF_VALUE); // Sticks and pots centered
+    }
+    failsafePulse = (uint16_t)map(FailsafeValues[LINK_THROTTLE_IDX], ANALOG_MIN_VALUE, ANALOG_MAX_VALUE, SERVO_PULSE_MIN_US, SERVO_PULSE_MAX_US);
+    memset(&probes, 0, sizeof(probes));
+    probes.toggleTime = LINK_NONE;
+    probes.level      = true;
+    probes.random     = 1u;
+
+    receiver_setup();
+    setup(); // Channel scan, the receiver isn't running yet
+
+    steps = (options.seconds * 1000000ul) / options.step;
+    for(i = 0; i < steps; i++)
+    {
+        unsigned long now      = millis();
+        LinkOutage_t* pOutage  = p_activeOutage(&options, now);
+        bool          inFailsafe;
+
+        host_setRadioLossPercent((pOutage != NULL) ? 100u : options.lossPercent);
+        loop();
+        receiver_loop();
+        inFailsafe = (host_getServoPulse(LINK_THROTTLE_IDX) == failsafePulse);
+        v_watchFailsafe(&options, &failsafe, inFailsafe, now);
+        v_runProbes(&probes, inFailsafe, pOutage != NULL);
+        host_advanceMicros(options.step);
+    }
+
+    printf("simulated:      %lu s, step %lu us, loss %u%%, latency %lu us, jitter %lu us\n", options.seconds, options.step,
+           options.lossPercent, options.latency, options.jitter);
+    printf("receiver:       %u frames (%.1f per s), %u lost, loop time %u us\n", RemoteCommunicationState.u16_RxReceived,
+           (double)RemoteCommunicationState.u16_RxReceived / options.seconds, RemoteCommunicationState.u16_RxLost,
+           RemoteCommunicationState.u16_RxLoopTime);
+    printf("link quality:   %u%% loss, %u.%u retries, time to ACK p50 %u us p95 %u us (transmitter)\n",
+           RemoteCommunicationState.u8_LossPercent, RemoteCommunicationState.u8_RetriesX10 / 10u, RemoteCommunicationState.u8_RetriesX10 % 10u,
+           RemoteCommunicationState.u16_LatencyP50, RemoteCommunicationState.u16_LatencyP95);
+#if RATE_CONTROL == ON
+    static const char* const dataRateNames[] = {"1Mbps", "2Mbps", "250kbps"};
+    static const char* const paLevelNames[]  = {"min", "low", "high", "max"};
+    printf("rate control:   %s PA %s, %u changes\n", dataRateNames[RCT_SETTING_DATA_RATE(u8_Rct_getSetting())],
+           paLevelNames[RCT_SETTING_PA_LEVEL(u8_Rct_getSetting())], u16_Rct_getChanges());
+#endif
+    if(probes.count > 0u)
+    {
+        qsort(probes.latencies, probes.count, sizeof(probes.latencies[0]), i_compareLatencies);
+        printf("end to end:     %u probes, latency p50 %lu us p95 %lu us max %lu us, %lu missed\n", probes.count,
+               probes.latencies[probes.count / 2u], probes.latencies[(probes.count * 95u) / 100u], probes.latencies[probes.count - 1u],
+               probes.missed);
+    }
+    else
+    {
+        printf("end to end:     no probe went through, %lu missed\n", probes.missed);
+    }
+    printf("failsafe:       %lu entries (%lu outside outages), %lu ms in failsafe\n", failsafe.entries, failsafe.spuriousEntries,
+           failsafe.time / 1000ul);
+    for(i = 0; i < options.nOutages; i++)
+    {
+        LinkOutage_t* pOutage = &options.outages[i];
+        bool          expected = pOutage->length > (FAILSAFE_TIMEOUT_MS + LINK_FAILSAFE_MARGIN_MS);
+        // The last frame may be a TX period before the outage, the first one a period after
+        bool          held     = (pOutage->length + 2u * LINK_FAILSAFE_MARGIN_MS) <= FAILSAFE_TIMEOUT_MS;
+
+        printf("outage:         %lu ms at %lu ms, ", pOutage->length, pOutage->start);
+        if(pOutage->failsafeAt != LINK_NONE)
+        {
+            printf("failsafe after %lu ms, ", pOutage->failsafeAt - pOutage->start);
+        }
+        else
+        {
+            printf("no failsafe, ");
+        }
+        if(pOutage->recoveredAt != LINK_NONE)
+        {
+            printf("link back %lu ms after the end\n", pOutage->recoveredAt - (pOutage->start + pOutage->length));
+        }
+        else
+        {
+            printf("link never back\n");
+        }
+        errors |= expected && ((pOutage->failsafeAt == LINK_NONE) ||
+                               ((pOutage->failsafeAt - pOutage->start) > (FAILSAFE_TIMEOUT_MS + LINK_FAILSAFE_MARGIN_MS)));
+        errors |= held && (pOutage->failsafeAt != LINK_NONE);
+        errors |= pOutage->recoveredAt == LINK_NONE;
+    }
+    errors |= RemoteCommunicationState.u16_RxReceived == 0u;
+    return errors ? 1 : 0;
+}
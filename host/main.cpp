@@ -0,0 +1,402 @@
+/**
+ * @file main.cpp
+ * @author Marcelo Fraga
+ * @brief Host harness for the transmitter sketch. Runs setup() once and loop() for a number of iterations against the
+ *        host stand-ins, animating the analog inputs, and reports loop() throughput. Display frames can be dumped as
+ *        PBM images to inspect the UI. Every looped back radio frame is decoded with the receiver side of
+ *        PayloadCodec and compared to the channel values the sketch packed, the exit code is 1 on any mismatch.
+ *        The harness then plays the receiver: its telemetry goes back in the ACK payload of the next frame. With
+ *        FREQUENCY_HOPPING, it takes the hop sequence from the bind frames and checks that every frame after the bind
+ *        went on air on its hop channel. --interference makes a range of channels busy, e.g. --interference 70-82:60.
+ *        With RATE_CONTROL, it switches its data rate on the link setting trailers like the receiver, and checks that
+ *        every other frame goes out on the agreed setting. --path-loss makes the link depend on the PA level and rate.
+ *        With --eeprom, the EEPROM contents are loaded from FILE before setup() (if it exists) and saved back at the end,
+ *        so saved configurations survive from one run to the next like a power cycle.
+ *        Every loop() advances the virtual time by 100 us unless --virtual-time sets another step, --virtual-time 0 runs
+ *        on the real clock (throughput only: the harness runs faster than the TX period, so few frames go out). Loop
+ *        time and rate are measured on the host clock either way. The exit code is also 1 if no frame was checked, bind
+ *        frames included.
+ *
+ *        Usage: rcremote_host [--loops N] [--dump-dir DIR] [--dump-every N] [--virtual-time US]
+ *                             [--i2c-clock HZ] [--static-inputs] [--no-ack] [--loss PERCENT] [--eeprom FILE]
+ *                             [--interference FIRST-LAST:PERCENT]... [--path-loss DB]
+ *                             [--verbose]
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <Arduino.h>
+#include <RF24.h>
+#include <U8g2lib.h>
+#include <avr/eeprom.h>
+#include <time.h>
+#include "Configuration.h"
+#include <PayloadCodec.h>
+#include "Diagnostics.h"
+#include "RateControl.h"
+#include "Scheduler.h"
+
+void setup();
+void loop();
+extern RFPayload payload; // Channel values of the last frame the sketch packed
+extern RemoteCommunicationState_t RemoteCommunicationState;
+
+#define HOST_RECEIVER_VOLTAGE 7400u // In mV, reported in the simulated receiver telemetry (2S pack)
+#define HOST_MAX_INTERFERENCE 4u
+#define HOST_INPUT_PERIOD_MS  6000ul // Of the first animated input, the next ones are slower
+
+typedef struct HostInterference_t
+{
+    uint8_t firstChannel;
+    uint8_t lastChannel;
+    uint8_t percent;
+}HostInterference_t;
+
+typedef struct HostOptions_t
+{
+    unsigned long loops;
+    const char*   dumpDir;
+    unsigned long dumpEvery;
+    unsigned long virtualLoopTime; // 0 means real time, 100 us by default so the TX period is reached at any loop count
+    uint32_t      i2cClock;
+    bool          staticInputs;
+    bool          acknowledge;
+    uint8_t       lossPercent;
+    const char*   eepromFile;
+    bool          verbose;
+    HostInterference_t interference[HOST_MAX_INTERFERENCE];
+    uint8_t       nInterference;
+    uint8_t       pathLoss;
+}HostOptions_t;
+
+typedef struct HostPayloadCheck_t
+{
+    PldDecoder_t  decoder;
+    uint32_t      lastLoopbackCount;
+    unsigned long frames;
+    unsigned long deltaFrames;
+    unsigned long undecodable;
+    unsigned long mismatches;
+    unsigned long bytes;
+    unsigned long bindFrames;
+    unsigned long hopErrors;      // Frames on another channel than their hop channel, or before any bind
+    uint8_t       hopChannels[PAYLOAD_MAX_HOP_CHANNELS];
+    uint8_t       nHopChannels;
+    uint8_t       hopFirstSequence; // Sent on the first hop channel after the bind
+    bool          hopBound;       // Bind heard, hopFirstSequence taken from the next frame
+    uint8_t       rxSetting;      // Link setting of the receiver played by the harness
+    unsigned long rxLastFrameTime; // millis()
+    unsigned long settingChanges;
+    unsigned long settingErrors;  // Frames without trailer sent on another setting than the agreed one
+}HostPayloadCheck_t;
+
+static const uint8_t animatedPins[] = {JOYSTICK_LEFT_AXIS_X_PIN, JOYSTICK_LEFT_AXIS_Y_PIN, JOYSTICK_RIGHT_AXIS_X_PIN,
+                                       JOYSTICK_RIGHT_AXIS_Y_PIN, POT_LEFT_PIN, POT_RIGHT_PIN};
+
+
+// Host clock, not the sketch's micros(): with virtual time that one only moves between loops
+static uint64_t u64_hostClockNanos(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000ull) + (uint64_t)now.tv_nsec;
+}
+
+static void v_printUsage(const char* program)
+{
+    fprintf(stderr, "Usage: %s [--loops N] [--dump-dir DIR] [--dump-every N] [--virtual-time US]\n"
+                    "          [--i2c-clock HZ] [--static-inputs] [--no-ack] [--loss PERCENT] [--eeprom FILE]\n"
+                    "          [--interference FIRST-LAST:PERCENT]... [--path-loss DB] [--verbose]\n", program);
+}
+
+static bool b_parseOptions(int argc, char** argv, HostOptions_t* pOptions)
+{
+    int i;
+    for(i = 1; i < argc; i++)
+    {
+        bool hasValue = (i + 1) < argc;
+        if(!strcmp(argv[i], "--loops") && hasValue)             { pOptions->loops = strtoul(argv[++i], NULL, 10); }
+        else if(!strcmp(argv[i], "--dump-dir") && hasValue)     { pOptions->dumpDir = argv[++i]; }
+        else if(!strcmp(argv[i], "--dump-every") && hasValue)   { pOptions->dumpEvery = strtoul(argv[++i], NULL, 10); }
+        else if(!strcmp(argv[i], "--virtual-time") && hasValue) { pOptions->virtualLoopTime = strtoul(argv[++i], NULL, 10); }
+        else if(!strcmp(argv[i], "--i2c-clock") && hasValue)    { pOptions->i2cClock = strtoul(argv[++i], NULL, 10); }
+        else if(!strcmp(argv[i], "--static-inputs"))            { pOptions->staticInputs = true; }
+        else if(!strcmp(argv[i], "--no-ack"))                   { pOptions->acknowledge = false; }
+        else if(!strcmp(argv[i], "--loss") && hasValue)         { pOptions->lossPercent = (uint8_t)strtoul(argv[++i], NULL, 10); }
+        else if(!strcmp(argv[i], "--eeprom") && hasValue)       { pOptions->eepromFile = argv[++i]; }
+        else if(!strcmp(argv[i], "--verbose"))                  { pOptions->verbose = true; }
+        else if(!strcmp(argv[i], "--path-loss") && hasValue)    { pOptions->pathLoss = (uint8_t)strtoul(argv[++i], NULL, 10); }
+        else if(!strcmp(argv[i], "--interference") && hasValue && (pOptions->nInterference < HOST_MAX_INTERFERENCE))
+        {
+            unsigned int first;
+            unsigned int last;
+            unsigned int percent;
+            if(sscanf(argv[++i], "%u-%u:%u", &first, &last, &percent) != 3)
+            {
+                return false;
+            }
+            pOptions->interference[pOptions->nInterference++] = {(uint8_t)first, (uint8_t)last, (uint8_t)percent};
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Triangle waves with a different period per input, so every monitor bar on the UI moves
+// Triangle sweeps at stick speed: a full swing takes 3 s and more, on the sketch's clock (virtual time by default)
+static void v_animateInputs(void)
+{
+    uint8_t i;
+    for(i = 0; i < sizeof(animatedPins); i++)
+    {
+        unsigned long period = HOST_INPUT_PERIOD_MS + (i * 1300ul);
+        unsigned long phase  = millis() % period;
+        unsigned long value  = (phase < (period / 2)) ? (phase * 2 * ANALOG_MAX_VALUE) / period : ((period - phase) * 2 * ANALOG_MAX_VALUE) / period;
+        host_setAnalogValue(animatedPins[i], (uint16_t)value);
+    }
+}
+
+static void v_dumpFrame(const char* dumpDir, unsigned long iteration)
+{
+    char path[512];
+    U8G2* pDisplay = host_getDisplay();
+    if(pDisplay == NULL)
+    {
+        return;
+    }
+    snprintf(path, sizeof(path), "%s/frame_%06lu.pbm", dumpDir, iteration);
+    if(!pDisplay->host_writePBM(path))
+    {
+        fprintf(stderr, "Could not write %s\n", path);
+    }
+}
+
+// Round trip of the frame the sketch just sent, if any: packed by the sketch, unpacked here as the receiver would
+static void v_checkPayload(HostPayloadCheck_t* pCheck)
+{
+    uint16_t       channels[PAYLOAD_N_CHANNELS];
+    uint8_t        len;
+    const uint8_t* pFrame = host_getRadioLoopbackPayload(&len);
+    PldTelemetry_t telemetry;
+    uint8_t        telemetryFrame[PAYLOAD_TELEMETRY_SIZE];
+#if RATE_CONTROL == ON
+    uint8_t        setting;
+#endif
+
+#if RATE_CONTROL == ON
+    if((pCheck->rxSetting != RCT_BASE_SETTING) && ((millis() - pCheck->rxLastFrameTime) > RF_RECEIVER_LINK_LOST_MS))
+    {
+        pCheck->rxSetting = RCT_BASE_SETTING; // Link lost, same as the transmitter after RF_RATE_FALLBACK_MS
+        pCheck->settingChanges++;
+        host_setRadioLoopbackDataRate(RCT_SETTING_DATA_RATE(pCheck->rxSetting));
+    }
+#endif
+    if(host_getRadioLoopbackCount() == pCheck->lastLoopbackCount)
+    {
+        return;
+    }
+    pCheck->lastLoopbackCount = host_getRadioLoopbackCount();
+    pCheck->rxLastFrameTime   = millis();
+#if FREQUENCY_HOPPING == ON
+    if(b_Pld_decodeBind(pFrame, len, pCheck->hopChannels, &pCheck->nHopChannels))
+    {
+        pCheck->bindFrames++;
+        pCheck->hopBound = true;
+        return; // Acknowledged, with no telemetry
+    }
+#endif
+    pCheck->frames++;
+    pCheck->bytes += len;
+    pCheck->deltaFrames += (pFrame[0] & 0x08u) ? 1u : 0u;
+
+    if(!b_Pld_decode(&pCheck->decoder, pFrame, len, channels))
+    {
+        pCheck->undecodable++;
+    }
+    else if(memcmp(channels, payload.u16_Channels, sizeof(channels)) != 0)
+    {
+        pCheck->mismatches++;
+    }
+#if RATE_CONTROL == ON
+    // Received, and acknowledged right away: the next frame is on the new setting
+    if(b_Pld_decodeLinkSetting(pFrame, len, &setting))
+    {
+        pCheck->settingChanges += (setting != pCheck->rxSetting) ? 1u : 0u;
+        pCheck->rxSetting       = setting;
+        host_setRadioLoopbackDataRate(RCT_SETTING_DATA_RATE(setting));
+    }
+    else if(host_getRadioLoopbackPALevel() != RCT_SETTING_PA_LEVEL(pCheck->rxSetting))
+    {
+        pCheck->settingErrors++; // The data rate matches, other frames aren't received
+    }
+#endif
+#if FREQUENCY_HOPPING == ON
+    else if(pCheck->nHopChannels == 0u)
+    {
+        pCheck->hopErrors++;
+    }
+    else
+    {
+        uint8_t i;
+        for(i = 0; pCheck->hopBound && (i < pCheck->nHopChannels); i++)
+        {
+            if(pCheck->hopChannels[i] == host_getRadioLoopbackChannel())
+            {
+                pCheck->hopFirstSequence = pCheck->decoder.u8_LastSequence - i; // The first frames may have been lost
+                pCheck->hopBound         = false;
+            }
+        }
+        if(host_getRadioLoopbackChannel() != pCheck->hopChannels[(uint8_t)(pCheck->decoder.u8_LastSequence - pCheck->hopFirstSequence) & (pCheck->nHopChannels - 1u)])
+        {
+            pCheck->hopErrors++;
+        }
+    }
+#endif
+
+    telemetry.u8_LastSequence = pCheck->decoder.u8_LastSequence;
+    telemetry.u16_Received    = pCheck->decoder.u16_Received;
+    telemetry.u16_Lost        = pCheck->decoder.u16_Lost;
+    telemetry.u16_LoopTime    = 0u;
+    telemetry.u16_Voltage     = HOST_RECEIVER_VOLTAGE;
+    host_setRadioLoopbackAckPayload(telemetryFrame, u8_Pld_encodeTelemetry(&telemetry, telemetryFrame));
+}
+
+int main(int argc, char** argv)
+{
+    HostOptions_t options = {1000ul, NULL, 0ul, 100ul, 0u, false, true, 0u, NULL, false, {}, 0u, 0u};
+    unsigned long i;
+    uint64_t      minLoopTime = UINT64_MAX; // Host clock, ns
+    uint64_t      maxLoopTime = 0;
+    uint64_t      sumLoopTime = 0;
+    uint64_t      startTime;
+    uint64_t      totalTime;
+    unsigned long startMicros;
+    HostPayloadCheck_t payloadCheck;
+
+    if(!b_parseOptions(argc, argv, &options))
+    {
+        v_printUsage(argv[0]);
+        return 1;
+    }
+
+    host_setSerialOutput(options.verbose ? stdout : NULL);
+    host_setRadioLoopbackAck(options.acknowledge);
+    host_setRadioLossPercent(options.lossPercent);
+    for(i = 0; i < options.nInterference; i++)
+    {
+        host_setRadioInterference(options.interference[i].firstChannel, options.interference[i].lastChannel, options.interference[i].percent);
+    }
+    host_setDisplayBusClock(options.i2cClock);
+    host_useVirtualTime(options.virtualLoopTime != 0);
+    v_animateInputs();
+    memset(&payloadCheck, 0, sizeof(payloadCheck));
+    v_Pld_initDecoder(&payloadCheck.decoder);
+    host_setRadioPathLoss(options.pathLoss);
+#if RATE_CONTROL == ON
+    payloadCheck.rxSetting = RCT_BASE_SETTING;
+    host_setRadioLoopbackDataRate(RCT_SETTING_DATA_RATE(RCT_BASE_SETTING));
+#endif
+    if(options.eepromFile != NULL)
+    {
+        host_loadEeprom(options.eepromFile); // A missing file is an erased EEPROM
+    }
+
+    setup();
+
+    startTime   = u64_hostClockNanos();
+    startMicros = micros();
+    for(i = 0; i < options.loops; i++)
+    {
+        if(!options.staticInputs)
+        {
+            v_animateInputs();
+        }
+
+        uint64_t loopStart = u64_hostClockNanos();
+        loop();
+        uint64_t loopTime = u64_hostClockNanos() - loopStart;
+        minLoopTime = min(minLoopTime, loopTime);
+        maxLoopTime = max(maxLoopTime, loopTime);
+        sumLoopTime += loopTime;
+        v_checkPayload(&payloadCheck);
+
+        if(options.virtualLoopTime != 0)
+        {
+            host_advanceMicros(options.virtualLoopTime);
+        }
+        if((options.dumpDir != NULL) && ((options.dumpEvery == 0) || ((i % options.dumpEvery) == 0)))
+        {
+            v_dumpFrame(options.dumpDir, i);
+        }
+    }
+    totalTime = u64_hostClockNanos() - startTime;
+    if((options.eepromFile != NULL) && !host_saveEeprom(options.eepromFile))
+    {
+        fprintf(stderr, "Could not write %s\n", options.eepromFile);
+    }
+
+    printf("loops:          %lu\n", options.loops);
+    printf("total time:     %lu us\n", (unsigned long)(totalTime / 1000ull));
+    if(options.virtualLoopTime != 0)
+    {
+        printf("virtual time:   %lu us\n", micros() - startMicros);
+    }
+    // Loop time only covers loop() itself, total time also includes the harness work (input animation, frame dumps)
+    printf("loop time:      min %.2f us, mean %.2f us, max %.2f us\n", options.loops ? minLoopTime / 1000.0 : 0.0,
+           options.loops ? (double)sumLoopTime / (options.loops * 1000.0) : 0.0, maxLoopTime / 1000.0);
+    printf("loop rate:      %.1f Hz\n", sumLoopTime ? (options.loops * 1000000000.0) / sumLoopTime : 0.0);
+    printf("radio writes:   %lu (looped back)\n", (unsigned long)host_getRadioLoopbackCount());
+    printf("payload check:  %lu frames (%lu delta), mean %.2f bytes, %lu undecodable, %lu mismatches\n", payloadCheck.frames,
+           payloadCheck.deltaFrames, payloadCheck.frames ? (double)payloadCheck.bytes / payloadCheck.frames : 0.0,
+           payloadCheck.undecodable, payloadCheck.mismatches);
+    printf("link quality:   %u%% loss, %u.%u retries, latency p50 %u us p95 %u us, receiver %u received %u lost\n",
+           RemoteCommunicationState.u8_LossPercent, RemoteCommunicationState.u8_RetriesX10 / 10u, RemoteCommunicationState.u8_RetriesX10 % 10u,
+           RemoteCommunicationState.u16_LatencyP50, RemoteCommunicationState.u16_LatencyP95,
+           RemoteCommunicationState.u16_RxReceived, RemoteCommunicationState.u16_RxLost);
+#if FREQUENCY_HOPPING == ON
+    printf("rf hopping:     %lu bind frames, %u channels, %lu frames off their hop channel\n", payloadCheck.bindFrames,
+           payloadCheck.nHopChannels, payloadCheck.hopErrors);
+#endif
+#if RATE_CONTROL == ON
+    static const char* const dataRateNames[] = {"1Mbps", "2Mbps", "250kbps"};
+    static const char* const paLevelNames[]  = {"min", "low", "high", "max"};
+    printf("rate control:   %s PA %s, %u changes (receiver %lu), %lu frames off the agreed setting\n",
+           dataRateNames[RCT_SETTING_DATA_RATE(u8_Rct_getSetting())], paLevelNames[RCT_SETTING_PA_LEVEL(u8_Rct_getSetting())],
+           u16_Rct_getChanges(), payloadCheck.settingChanges, payloadCheck.settingErrors);
+#endif
+    printf("air time:       %lu us, %.1f us per frame received\n", host_getRadioAirTime(),
+           host_getRadioLoopbackCount() ? (double)host_getRadioAirTime() / host_getRadioLoopbackCount() : 0.0);
+    printf("eeprom writes:  %lu bytes\n", (unsigned long)host_getEepromWrites());
+    if(host_getDisplay() != NULL)
+    {
+        printf("display rows:   %lu tile row transfers, %lu bytes\n", (unsigned long)host_getDisplay()->host_getTileRowTransfers(),
+               (unsigned long)host_getDisplay()->host_getTransferBytes());
+    }
+#if TASK_SCHEDULER == ON
+    printf("scheduler:      overruns per task");
+    for(i = 0; i < SCH_MAX_TASKS; i++)
+    {
+        printf(" %u", u16_Sch_getOverruns((uint8_t)i)); // 0 past the last task of the table
+    }
+    printf("\n");
+#endif
+#if LOOP_TIMING == ON
+    // Statistics since the last reset: the last Serial dump, if any
+    const DiagStageStats_t* pFrameStats = &p_Diag_getStats()->stages[DIAG_STAGE_UI_FRAME];
+    printf("ui frames:      %u, mean %lu us, max %lu us\n", pFrameStats->u16_Count, (unsigned long)u32_Diag_getStageMean(DIAG_STAGE_UI_FRAME),
+           pFrameStats->u16_Count ? (unsigned long)pFrameStats->u32_Max : 0ul);
+#endif
+    // Without ACKs the link never binds: the bind frames are all that goes out, they are checked too
+    if((payloadCheck.frames + payloadCheck.bindFrames) == 0)
+    {
+        fprintf(stderr, "No radio frame was checked\n");
+        return 1;
+    }
+    return ((payloadCheck.mismatches == 0) && (payloadCheck.hopErrors == 0) && (payloadCheck.settingErrors == 0)) ? 0 : 1;
+}
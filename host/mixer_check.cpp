@@ -0,0 +1,150 @@
+/**
+ * @file mixer_check.cpp
+ * @brief Known input, expected output checks of the channel mixer (RCRemote/Mixer): pass-through, elevon, V-tail,
+ *        differential, the end points of a curve table and the clamping of weights (+-125%) and outputs. Each case
+ *        is a mix table and a few input frames with the hand computed outputs of the mixed channels, within 1 LSB
+ *        (Q14 weights round down). The exit code is 1 if any output is off.
+ *
+ *        Usage: mixer_check
+ */
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Mixer.h"
+
+#define CHECK_MAX_RULES   4u
+#define CHECK_MAX_FRAMES  4u
+#define CHECK_TOLERANCE   1
+#define CHECK_UNMIXED     0xFFFFu // Expected output of a channel the case doesn't look at
+
+typedef struct CheckFrame_t
+{
+    uint16_t inputs[N_ANALOG_CHANNELS];
+    uint16_t expected[N_ANALOG_CHANNELS];
+}CheckFrame_t;
+
+typedef struct CheckCase_t
+{
+    const char*  name;
+    uint8_t      nRules;
+    MixRule_t    rules[CHECK_MAX_RULES];
+    bool         b_Curve;                  // Curve table 0 replaced by <curve>, otherwise the default linear table
+    int8_t       curve[MIX_CURVE_POINTS];
+    uint8_t      nFrames;
+    CheckFrame_t frames[CHECK_MAX_FRAMES];
+}CheckCase_t;
+
+#define X CHECK_UNMIXED
+
+// Channels: 0 aileron, 1 elevator, 2 throttle, 3 rudder. Rules: source, destination, weight, offset, curve
+static const CheckCase_t checkCases[] =
+{
+    {"pass-through", 0u, {}, false, {},
+     3u, {{{0, 1023, 512, 300, 7, 900}, {0, 1023, 512, 300, 7, 900}},
+          {{512, 512, 512, 512, 512, 512}, {512, 512, 512, 512, 512, 512}},
+          {{1023, 0, 1, 1022, 100, 0}, {1023, 0, 1, 1022, 100, 0}}}},
+
+    // out0 = 50% ail + 50% ele, out1 = -50% ail + 50% ele
+    {"elevon", 4u, {{0u, 0u, 50, 0, MIX_CURVE_LINEAR}, {1u, 0u, 50, 0, MIX_CURVE_LINEAR},
+                    {0u, 1u, -50, 0, MIX_CURVE_LINEAR}, {1u, 1u, 50, 0, MIX_CURVE_LINEAR}}, false, {},
+     4u, {{{1023, 512, 0, 0, 0, 0}, {767, 256, X, X, X, X}},
+          {{512, 1023, 0, 0, 0, 0}, {767, 767, X, X, X, X}},
+          {{1023, 1023, 0, 0, 0, 0}, {1023, 512, X, X, X, X}},
+          {{0, 0, 0, 0, 0, 0}, {0, 512, X, X, X, X}}}},
+
+    // out1 = 50% ele + 50% rud, out3 = 50% ele - 50% rud
+    {"v-tail", 4u, {{1u, 1u, 50, 0, MIX_CURVE_LINEAR}, {3u, 1u, 50, 0, MIX_CURVE_LINEAR},
+                    {1u, 3u, 50, 0, MIX_CURVE_LINEAR}, {3u, 3u, -50, 0, MIX_CURVE_LINEAR}}, false, {},
+     2u, {{{0, 512, 0, 0, 0, 0}, {X, 256, X, 768, X, X}},
+          {{0, 1023, 0, 1023, 0, 0}, {X, 1023, X, 512, X, X}}}},
+
+    // Aileron differential: full travel up, half travel down
+    {"differential", 2u, {{0u, 0u, 100, 0, MIX_CURVE_POSITIVE}, {0u, 0u, 50, 0, MIX_CURVE_NEGATIVE}}, false, {},
+     3u, {{{1023, 0, 0, 0, 0, 0}, {1023, X, X, X, X, X}},
+          {{0, 0, 0, 0, 0, 0}, {256, X, X, X, X, X}},
+          {{512, 0, 0, 0, 0, 0}, {512, X, X, X, X, X}}}},
+
+    // Throttle curve -100, -20, 0, 60, 100%: points at 0, 256, 512, 768, the last segment ends 1 LSB short of 1024
+    {"curve", 1u, {{2u, 2u, 100, 0, MIX_CURVE_TABLE}}, true, {-100, -20, 0, 60, 100},
+     4u, {{{0, 0, 0, 0, 0, 0}, {X, X, 0, X, X, X}},
+          {{0, 0, 256, 0, 0, 0}, {X, X, 410, X, X, X}},
+          {{0, 0, 768, 0, 0, 0}, {X, X, 819, X, X, X}},
+          {{0, 0, 1023, 0, 0, 0}, {X, X, 1023, X, X, X}}}},
+
+    // +125% saturates at the end points, a weight beyond it is clamped to 125%
+    {"weight +125", 1u, {{0u, 0u, 125, 0, MIX_CURVE_LINEAR}}, false, {},
+     3u, {{{1023, 0, 0, 0, 0, 0}, {1023, X, X, X, X, X}},
+          {{0, 0, 0, 0, 0, 0}, {0, X, X, X, X, X}},
+          {{768, 0, 0, 0, 0, 0}, {832, X, X, X, X, X}}}},
+    {"weight -125", 1u, {{0u, 0u, -125, 0, MIX_CURVE_LINEAR}}, false, {},
+     3u, {{{1023, 0, 0, 0, 0, 0}, {0, X, X, X, X, X}},
+          {{0, 0, 0, 0, 0, 0}, {1023, X, X, X, X, X}},
+          {{768, 0, 0, 0, 0, 0}, {192, X, X, X, X, X}}}},
+    {"weight 127", 1u, {{0u, 0u, 127, 0, MIX_CURVE_LINEAR}}, false, {},
+     1u, {{{768, 0, 0, 0, 0, 0}, {832, X, X, X, X, X}}}},
+
+    // Offsets move the center, the sum is clamped to the channel range
+    {"offset", 2u, {{0u, 0u, 100, 50, MIX_CURVE_LINEAR}, {1u, 1u, 100, -100, MIX_CURVE_LINEAR}}, false, {},
+     2u, {{{512, 512, 0, 0, 0, 0}, {768, 0, X, X, X, X}},
+          {{1023, 1023, 0, 0, 0, 0}, {1023, 511, X, X, X, X}}}},
+};
+
+#undef X
+
+
+int main()
+{
+    RemoteChannelInput_t inputs[N_CHANNELS];
+    uint16_t             outputs[N_CHANNELS];
+    MixConfig_t          config;
+    unsigned int         failures = 0;
+    uint8_t              c;
+    uint8_t              f;
+    uint8_t              d;
+
+    for(c = 0; c < (sizeof(checkCases) / sizeof(checkCases[0])); c++)
+    {
+        const CheckCase_t* pCase   = &checkCases[c];
+        unsigned int       maxDiff = 0;
+
+        v_Mix_initConfig(&config);
+        memcpy(config.rules, pCase->rules, pCase->nRules * sizeof(MixRule_t));
+        if(pCase->b_Curve)
+        {
+            memcpy(config.i8_Curves[0], pCase->curve, sizeof(pCase->curve));
+        }
+        v_Mix_compile(&config);
+
+        for(f = 0; f < pCase->nFrames; f++)
+        {
+            const CheckFrame_t* pFrame = &pCase->frames[f];
+            memset(inputs, 0, sizeof(inputs));
+            for(d = 0; d < N_ANALOG_CHANNELS; d++)
+            {
+                inputs[d].u16_Value = pFrame->inputs[d];
+            }
+            v_Mix_apply(inputs, outputs);
+            for(d = 0; d < N_ANALOG_CHANNELS; d++)
+            {
+                if(pFrame->expected[d] == CHECK_UNMIXED)
+                {
+                    continue;
+                }
+                unsigned int diff = (unsigned int)abs((int)outputs[d] - (int)pFrame->expected[d]);
+                maxDiff = max(maxDiff, diff);
+                if(diff > CHECK_TOLERANCE)
+                {
+                    printf("  %s: frame %u channel %u is %u, expected %u\n", pCase->name, f, d, outputs[d], pFrame->expected[d]);
+                }
+            }
+        }
+        printf("%-13s %-4s %u frames, max error %u LSB\n", pCase->name, (maxDiff <= CHECK_TOLERANCE) ? "ok" : "FAIL",
+               pCase->nFrames, maxDiff);
+        failures += (maxDiff <= CHECK_TOLERANCE) ? 0u : 1u;
+    }
+
+    printf("%u failed\n", failures);
+    return (failures == 0u) ? 0 : 1;
+}
@@ -0,0 +1,353 @@
+/**
+ * @file store_check.cpp
+ * @brief Recovery checks of the configuration store (RCRemote/ConfigStore), on the EEPROM stand-in and virtual time.
+ *        Every check starts from an erased EEPROM, saves records through the sketch API and reloads them with
+ *        b_Cfg_load like a power cycle:
+ *          torn     A save cut halfway (power lost) and a newest record with a flipped byte are both rejected by
+ *                   their CRC, the previous record of the model is loaded instead.
+ *          wrap     Records numbered 0xFFFF then 0x0000: the one after the wraparound is the newest, and the next
+ *                   save continues from it.
+ *          models   Saving one model over and over goes round every slot but never overwrites the newest record of
+ *                   another model.
+ *          wear     With every model saved, the saves of one model rotate over CFG_WEAR_SLOTS slots, evenly, and
+ *                   a trim change rewrites a few bytes of the slot only.
+ *        The exit code is 1 if any check fails.
+ *
+ *        Usage: store_check
+ */
+
+#include <Arduino.h>
+#include <avr/eeprom.h>
+#include <stdio.h>
+#include <string.h>
+#include "ConfigStore.h"
+
+#define CHECK_TRIM_BASE  300u  // Channel 0 trim of the n-th record saved in a check, trim base + n
+#define CHECK_STEP_US    1000u // Virtual time between v_Cfg_process calls, a storage task run
+#define CHECK_SAVE_STEPS ((CFG_SAVE_DELAY_MS * 1000ul) / CHECK_STEP_US + (CFG_RECORD_SIZE * 4u)) // Delay, then ~3.3ms per byte
+#define CHECK_IDLE_STEPS 20u   // Storage task runs after a save, the active model is written then
+#define CHECK_WEAR_SAVES (CFG_WEAR_SLOTS * 10u)
+#define CHECK_WEAR_BYTES 6u    // Sequence, trim and CRC, once the slots a model rotates over all hold one of its records
+
+static RemoteChannelInput_t checkChannels[N_CHANNELS];
+static MixConfig_t          checkMixes;
+static const CfgModel_t     checkModel = {checkChannels, &checkMixes};
+static unsigned int         checkFailures;
+
+
+/** Internal functions **/
+static void     v_check(const char* name, bool passed, const char* detail);
+static void     v_powerUp(bool* pLoaded);
+static bool     b_save(uint16_t trim, unsigned long maxSteps);
+static void     v_switchModel(uint8_t model);
+static uint8_t  u8_newestSlot(uint8_t model);
+static bool     b_readRecord(uint8_t slot, uint8_t* pRecordId, uint16_t* pSequence, uint16_t* pTrim);
+static void     v_setSequence(uint8_t slot, uint16_t sequence);
+static uint16_t u16_crc(uint8_t slot);
+static void     v_checkTornRecord();
+static void     v_checkSequenceWrap();
+static void     v_checkOtherModels();
+static void     v_checkWear();
+
+
+int main()
+{
+    host_useVirtualTime(true);
+    host_setSerialOutput(NULL);
+    printf("%u slots of %u bytes, %u models\n", (unsigned int)CFG_SLOT_COUNT, (unsigned int)CFG_SLOT_SIZE, (unsigned int)N_MODELS);
+
+    v_checkTornRecord();
+    v_checkSequenceWrap();
+    v_checkOtherModels();
+    v_checkWear();
+
+    printf("%u failed\n", checkFailures);
+    return (checkFailures == 0u) ? 0 : 1;
+}
+
+
+static void v_check(const char* name, bool passed, const char* detail)
+{
+    printf("%-8s %-4s %s\n", name, passed ? "ok" : "FAIL", detail);
+    checkFailures += passed ? 0u : 1u;
+}
+
+// Working set reset to the sketch defaults, then loaded from the EEPROM as at boot
+static void v_powerUp(bool* pLoaded)
+{
+    uint8_t i;
+    memset(checkChannels, 0, sizeof(checkChannels));
+    for(i = 0; i < N_CHANNELS; i++)
+    {
+        checkChannels[i].u16_Trim     = ANALOG_HALF_VALUE;
+        checkChannels[i].u16_MaxValue = ANALOG_MAX_VALUE;
+        snprintf(checkChannels[i].c_Name, sizeof(checkChannels[i].c_Name), "C%u", i);
+    }
+    v_Mix_initConfig(&checkMixes);
+    *pLoaded = b_Cfg_load(&checkModel);
+}
+
+// Sets the channel 0 trim and runs the storage task until the save is written and a while after, or for <maxSteps>
+// runs at most. Returns whether the save completed
+static bool b_save(uint16_t trim, unsigned long maxSteps)
+{
+    unsigned long step;
+    unsigned long idleSteps = 0;
+    checkChannels[0].u16_Trim = trim;
+    v_Cfg_requestSave();
+    for(step = 0; (step < maxSteps) && (idleSteps < CHECK_IDLE_STEPS); step++)
+    {
+        host_advanceMicros(CHECK_STEP_US);
+        v_Cfg_process(&checkModel);
+        idleSteps = b_Cfg_isBusy() ? 0u : (idleSteps + 1u);
+    }
+    while(!eeprom_is_ready())
+    {
+        host_advanceMicros(CHECK_STEP_US);
+    }
+    return !b_Cfg_isBusy();
+}
+
+// Runs the storage task until the switch to <model> is applied
+static void v_switchModel(uint8_t model)
+{
+    unsigned long step;
+    v_Cfg_selectModel(model);
+    for(step = 0; (step < CHECK_SAVE_STEPS) && !b_Cfg_applyModelSwitch(&checkModel); step++)
+    {
+        host_advanceMicros(CHECK_STEP_US);
+        v_Cfg_process(&checkModel);
+    }
+}
+
+// Slot of the valid record of <model> with the highest sequence number, CFG_SLOT_COUNT if there is none
+static uint8_t u8_newestSlot(uint8_t model)
+{
+    uint8_t  newest = CFG_SLOT_COUNT;
+    uint16_t newestSequence = 0u;
+    uint8_t  recordId;
+    uint16_t sequence;
+    uint16_t trim;
+    uint8_t  slot;
+    for(slot = 0; slot < CFG_SLOT_COUNT; slot++)
+    {
+        if(b_readRecord(slot, &recordId, &sequence, &trim) && (recordId == model) &&
+           ((newest == CFG_SLOT_COUNT) || ((int16_t)(sequence - newestSequence) > 0)))
+        {
+            newest         = slot;
+            newestSequence = sequence;
+        }
+    }
+    return newest;
+}
+
+// Header and channel 0 trim of the record in <slot>. Returns false if its CRC doesn't match
+static bool b_readRecord(uint8_t slot, uint8_t* pRecordId, uint16_t* pSequence, uint16_t* pTrim)
+{
+    uint8_t  record[CFG_RECORD_SIZE];
+    uint16_t crc = u16_crc(slot);
+
+    eeprom_read_block(record, (const void*)(uintptr_t)(slot * CFG_SLOT_SIZE), CFG_RECORD_SIZE);
+    *pRecordId = record[1];
+    *pSequence = (uint16_t)record[2] | ((uint16_t)record[3] << 8);
+    *pTrim     = (uint16_t)record[CFG_HEADER_SIZE] | ((uint16_t)record[CFG_HEADER_SIZE + 1u] << 8);
+    return (record[0] == CFG_FORMAT_VERSION) &&
+           (record[CFG_RECORD_SIZE - 2u] == (uint8_t)crc) && (record[CFG_RECORD_SIZE - 1u] == (uint8_t)(crc >> 8));
+}
+
+// Renumbers the record in <slot>, with a matching CRC
+static void v_setSequence(uint8_t slot, uint16_t sequence)
+{
+    uint8_t* pRecord = (uint8_t*)(uintptr_t)(slot * CFG_SLOT_SIZE);
+    uint16_t crc;
+
+    eeprom_write_byte(pRecord + 2u, (uint8_t)sequence);
+    eeprom_write_byte(pRecord + 3u, (uint8_t)(sequence >> 8));
+    crc = u16_crc(slot);
+    eeprom_write_byte(pRecord + CFG_RECORD_SIZE - 2u, (uint8_t)crc);
+    eeprom_write_byte(pRecord + CFG_RECORD_SIZE - 1u, (uint8_t)(crc >> 8));
+}
+
+// CRC16-CCITT of the record in <slot>, header and payload, as ConfigStore computes it
+static uint16_t u16_crc(uint8_t slot)
+{
+    uint16_t crc = 0xFFFFu;
+    uint8_t  offset;
+    uint8_t  i;
+    for(offset = 0; offset < (CFG_RECORD_SIZE - CFG_CRC_SIZE); offset++)
+    {
+        crc ^= (uint16_t)eeprom_read_byte((const uint8_t*)(uintptr_t)(slot * CFG_SLOT_SIZE + offset)) << 8;
+        for(i = 0; i < 8u; i++)
+        {
+            crc = (crc & 0x8000u) ? (uint16_t)((crc << 1) ^ 0x1021u) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static void v_checkTornRecord()
+{
+    char     detail[96];
+    bool     loaded;
+    uint8_t  recordId;
+    uint16_t sequence;
+    uint16_t trim;
+
+    host_eraseEeprom();
+    v_powerUp(&loaded);
+    v_check("torn", !loaded, "erased EEPROM holds no record");
+    b_save(CHECK_TRIM_BASE, CHECK_SAVE_STEPS);
+    b_save(CHECK_TRIM_BASE + 1u, CHECK_SAVE_STEPS);
+
+    // Power lost in the middle of the third save (slot 2): only the delay and half of the record went through
+    bool completed = b_save(CHECK_TRIM_BASE + 2u, (CFG_SAVE_DELAY_MS * 1000ul) / CHECK_STEP_US + (CFG_RECORD_SIZE / 2u) * 4u);
+    bool rejected  = !b_readRecord(2u, &recordId, &sequence, &trim);
+    v_powerUp(&loaded);
+    snprintf(detail, sizeof(detail), "save cut halfway: record %s, trim %u loaded (expected %u)",
+             rejected ? "rejected" : "accepted", checkChannels[0].u16_Trim, CHECK_TRIM_BASE + 1u);
+    v_check("torn", !completed && rejected && loaded && (checkChannels[0].u16_Trim == CHECK_TRIM_BASE + 1u), detail);
+
+    // The newest complete record (slot 1) with one payload byte flipped
+    uint8_t* pByte = (uint8_t*)(uintptr_t)(1u * CFG_SLOT_SIZE + CFG_HEADER_SIZE + 10u);
+    eeprom_write_byte(pByte, (uint8_t)~eeprom_read_byte(pByte));
+    v_powerUp(&loaded);
+    snprintf(detail, sizeof(detail), "newest record corrupted: trim %u loaded (expected %u)",
+             checkChannels[0].u16_Trim, CHECK_TRIM_BASE);
+    v_check("torn", loaded && (checkChannels[0].u16_Trim == CHECK_TRIM_BASE), detail);
+
+    // Writing goes on after the last valid record, the previous one is kept until a new one is complete
+    b_save(CHECK_TRIM_BASE + 3u, CHECK_SAVE_STEPS);
+    bool previousKept = b_readRecord(0u, &recordId, &sequence, &trim) && (trim == CHECK_TRIM_BASE);
+    v_powerUp(&loaded);
+    snprintf(detail, sizeof(detail), "save after recovery: trim %u loaded (expected %u), previous record %s",
+             checkChannels[0].u16_Trim, CHECK_TRIM_BASE + 3u, previousKept ? "kept" : "lost");
+    v_check("torn", loaded && previousKept && (checkChannels[0].u16_Trim == CHECK_TRIM_BASE + 3u), detail);
+}
+
+static void v_checkSequenceWrap()
+{
+    char     detail[96];
+    bool     loaded;
+    uint8_t  recordId;
+    uint16_t sequence;
+    uint16_t trim;
+
+    host_eraseEeprom();
+    v_powerUp(&loaded);
+    b_save(CHECK_TRIM_BASE, CHECK_SAVE_STEPS);
+    b_save(CHECK_TRIM_BASE + 1u, CHECK_SAVE_STEPS);
+    v_setSequence(0u, 0xFFFFu);
+    v_setSequence(1u, 0x0000u);
+
+    v_powerUp(&loaded);
+    snprintf(detail, sizeof(detail), "0xFFFF then 0x0000: trim %u loaded (expected %u)", checkChannels[0].u16_Trim, CHECK_TRIM_BASE + 1u);
+    v_check("wrap", loaded && (checkChannels[0].u16_Trim == CHECK_TRIM_BASE + 1u), detail);
+
+    b_save(CHECK_TRIM_BASE + 2u, CHECK_SAVE_STEPS);
+    bool written = b_readRecord(2u, &recordId, &sequence, &trim);
+    snprintf(detail, sizeof(detail), "next save: slot 2 holds sequence 0x%04X (expected 0x0001)", sequence);
+    v_check("wrap", written && (sequence == 0x0001u) && (trim == CHECK_TRIM_BASE + 2u), detail);
+
+    v_powerUp(&loaded);
+    snprintf(detail, sizeof(detail), "after the wraparound: trim %u loaded (expected %u)", checkChannels[0].u16_Trim, CHECK_TRIM_BASE + 2u);
+    v_check("wrap", loaded && (checkChannels[0].u16_Trim == CHECK_TRIM_BASE + 2u), detail);
+}
+
+static void v_checkOtherModels()
+{
+    char          detail[96];
+    bool          loaded;
+    bool          kept = true;
+    uint8_t       recordId;
+    uint16_t      sequence;
+    uint16_t      trim;
+    uint8_t       slot;
+    uint8_t       slotsUsed = 0u;
+    uint16_t      i;
+
+    host_eraseEeprom();
+    v_powerUp(&loaded);
+    b_save(CHECK_TRIM_BASE, CHECK_SAVE_STEPS); // Model 0, slot 0
+
+    v_switchModel(1u);
+    for(i = 1u; i <= (CFG_SLOT_COUNT * 3u); i++)
+    {
+        b_save(CHECK_TRIM_BASE + i, CHECK_SAVE_STEPS);
+        kept &= b_readRecord(0u, &recordId, &sequence, &trim) && (recordId == 0u) && (trim == CHECK_TRIM_BASE);
+    }
+    for(slot = 0; slot < CFG_SLOT_COUNT; slot++)
+    {
+        slotsUsed += (b_readRecord(slot, &recordId, &sequence, &trim) && (recordId == 1u)) ? 1u : 0u;
+    }
+    snprintf(detail, sizeof(detail), "%u saves of model 1 over %u slots, model 0 record %s",
+             (unsigned int)(CFG_SLOT_COUNT * 3u), slotsUsed, kept ? "kept" : "overwritten");
+    v_check("models", kept && (slotsUsed == (CFG_SLOT_COUNT - 1u)), detail);
+
+    v_powerUp(&loaded);
+    snprintf(detail, sizeof(detail), "model 1 after power up: trim %u loaded (expected %u)",
+             checkChannels[0].u16_Trim, (unsigned int)(CHECK_TRIM_BASE + CFG_SLOT_COUNT * 3u));
+    v_check("models", loaded && (u8_Cfg_getActiveModel() == 1u) && (checkChannels[0].u16_Trim == CHECK_TRIM_BASE + CFG_SLOT_COUNT * 3u), detail);
+
+    v_switchModel(0u);
+    snprintf(detail, sizeof(detail), "switch back to model 0: trim %u loaded (expected %u)", checkChannels[0].u16_Trim, CHECK_TRIM_BASE);
+    v_check("models", (u8_Cfg_getActiveModel() == 0u) && (checkChannels[0].u16_Trim == CHECK_TRIM_BASE), detail);
+}
+
+static void v_checkWear()
+{
+    char     detail[128];
+    bool     loaded;
+    bool     even        = true;
+    uint8_t  slotsUsed   = 0u;
+    uint32_t maxBytes    = 0u;
+    uint16_t slotSaves[CFG_SLOT_COUNT];
+    uint32_t slotBytes[CFG_SLOT_COUNT];
+    uint8_t  model;
+    uint8_t  slot;
+    uint16_t i;
+    int      length;
+
+    host_eraseEeprom();
+    v_powerUp(&loaded);
+    for(model = 0; model < N_MODELS; model++)
+    {
+        if(model != 0u)
+        {
+            v_switchModel(model);
+        }
+        b_save(CHECK_TRIM_BASE + model, CHECK_SAVE_STEPS);
+    }
+
+    // Saves of the last model, each counted on the slot it went to with the bytes it actually wrote
+    memset(slotSaves, 0, sizeof(slotSaves));
+    memset(slotBytes, 0, sizeof(slotBytes));
+    for(i = 0; i < CHECK_WEAR_SAVES; i++)
+    {
+        uint32_t writes = host_getEepromWrites();
+        b_save(CHECK_TRIM_BASE + N_MODELS + i, CHECK_SAVE_STEPS);
+        writes = host_getEepromWrites() - writes;
+        slot   = u8_newestSlot(N_MODELS - 1u);
+        if(slot < CFG_SLOT_COUNT)
+        {
+            slotSaves[slot]++;
+            slotBytes[slot] += writes;
+        }
+        if(i >= CFG_WEAR_SLOTS) // Every slot of the rotation holds a record of the model by now
+        {
+            maxBytes = max(maxBytes, writes);
+        }
+    }
+
+    length = snprintf(detail, sizeof(detail), "%u saves of model %u, saves (bytes) per slot:", (unsigned int)CHECK_WEAR_SAVES, N_MODELS - 1u);
+    for(slot = 0; slot < CFG_SLOT_COUNT; slot++)
+    {
+        length += snprintf(&detail[length], sizeof(detail) - length, " %u (%lu)", slotSaves[slot], (unsigned long)slotBytes[slot]);
+        slotsUsed += (slotSaves[slot] != 0u) ? 1u : 0u;
+        even      &= (slotSaves[slot] == 0u) || (slotSaves[slot] == (CHECK_WEAR_SAVES / CFG_WEAR_SLOTS));
+    }
+    v_check("wear", (slotsUsed == CFG_WEAR_SLOTS) && even, detail);
+
+    snprintf(detail, sizeof(detail), "trim change: at most %lu bytes written per save (expected %u at most)",
+             (unsigned long)maxBytes, CHECK_WEAR_BYTES);
+    v_check("wear", maxBytes <= CHECK_WEAR_BYTES, detail);
+}
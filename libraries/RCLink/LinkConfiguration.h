@@ -0,0 +1,64 @@
+/**
+ * @file LinkConfiguration.h
+ * @author Marcelo Fraga
+ * @brief Configuration both ends of the radio link must agree on: channel layout, frame rate, address, retries,
+ *        link loss timing and the link features (FREQUENCY_HOPPING, RATE_CONTROL). Included by the transmitter
+ *        (RCRemote/Configuration.h) and by the receiver (RCReceiver/ReceiverConfiguration.h): flash both after a change.
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef LINKCONFIGURATION_H
+#define LINKCONFIGURATION_H
+#include <Arduino.h>
+
+#define ON  1u
+#define OFF 0u
+
+
+/*
+*
+*   Link features
+*
+*/
+
+#define FREQUENCY_HOPPING         ON  // Quietest channels picked by a scan at startup, frames hop over them in an order given to the receiver at bind (FrequencyHopping.h). OFF stays on RF_CHANNEL
+#define RATE_CONTROL              ON  // Data rate and PA level stepped from the ACK statistics, changes agreed with the receiver (RateControl.h). OFF stays on 1Mbps, PA low
+
+
+/* Channels */
+
+// 17/06 -> Stopped considering joystick buttons
+// 24/07/2024 -> Re-done wiring on a physical level, allowing for more channels
+// NOTE: Changing this requires that you flash new software on the receiver, with the same nr of channels
+// This is due to thte fact that this macro is used on the payload definition as well.
+#define N_CHANNELS 8u
+#define N_ANALOG_CHANNELS 6u
+
+#define ANALOG_MAX_VALUE 1023
+#define ANALOG_MIN_VALUE 0
+#define ANALOG_HALF_VALUE 512
+
+
+/* Radio configuration */
+#define TX_RATE_HZ        100u  // Radio frames. 50 - 250Hz
+#define RF_RETRY_DELAY    5u     // Auto retransmit delay, in 250us steps. 1500us leaves room for the ACK payload at 250kbps
+#define RF_ATTEMPT_MAX_US 2500ul // Retransmit delay plus the air time of a full frame and its ACK at 250kbps
+// Auto retransmits. A frame that failed ends within its TX period: one frame per period, which keeps a receiver that
+// lost frames on the hop channel of the next one (see ReceiverLink.h)
+#define RF_RETRY_COUNT    ((uint8_t)min(((1000000ul / TX_RATE_HZ) / RF_ATTEMPT_MAX_US) - 1ul, 15ul))
+#define RF_CHANNEL           76u  // 2.476GHz. Fixed channel, and bind channel with FREQUENCY_HOPPING. RF24 library default
+#define RF_RATE_BASE_DATA_RATE   RF24_250KBPS // Settings both sides start from, and fall back to when the link is lost
+#define RF_RATE_BASE_PA_LEVEL    RF24_PA_MAX
+#define RF_RECEIVER_LINK_LOST_MS 500u // Receiver side: no frame for this long, back to the base settings (and bind channel)
+
+/*
+* NRF24L01 RFCom related
+*/
+#define RF_ADDRESS_SIZE 3u
+const byte RF_Address[RF_ADDRESS_SIZE] = "FG";
+
+#endif
@@ -0,0 +1,25 @@
+/**
+ * @file LinkSetting.h
+ * @author Marcelo Fraga
+ * @brief Link setting byte of the channel frame trailer (RATE_CONTROL, see PayloadCodec.h): the data rate and PA level
+ * both ends switch to. Chosen by the rate controller of the transmitter (RCRemote/RateControl.h), followed by the
+ * receiver (RCReceiver/ReceiverLink.h).
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef LINKSETTING_H
+#define LINKSETTING_H
+#include <LinkConfiguration.h>
+#include <RF24.h>
+
+// Data rate (rf24_datarate_e) in bits 0 - 1, PA level (rf24_pa_dbm_e) in bits 2 - 3
+#define RCT_SETTING(dataRate, paLevel) ((uint8_t)(((dataRate) & 0x03u) | (((paLevel) & 0x03u) << 2)))
+#define RCT_SETTING_DATA_RATE(setting) ((rf24_datarate_e)((setting) & 0x03u))
+#define RCT_SETTING_PA_LEVEL(setting)  ((uint8_t)(((setting) >> 2) & 0x03u))
+#define RCT_BASE_SETTING               RCT_SETTING(RF_RATE_BASE_DATA_RATE, RF_RATE_BASE_PA_LEVEL)
+
+#endif
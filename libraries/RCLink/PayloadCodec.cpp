@@ -0,0 +1,386 @@
+/**
+ * @file PayloadCodec.cpp
+ * @author Marcelo Fraga
+ * @brief Packed wire format of the RF frames. See PayloadCodec.h
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "PayloadCodec.h"
+
+#define PAYLOAD_DELTA_FLAG       0x08u
+#define PAYLOAD_DELTA_WIDTH_MASK 0x07u
+#define PAYLOAD_BIND_MARK        PAYLOAD_DELTA_WIDTH_MASK // Width bits of a frame without the delta flag
+
+static constexpr uint8_t u8_countBits(uint8_t mask)
+{
+    return (mask == 0u) ? 0u : (uint8_t)((mask & 1u) + u8_countBits(mask >> 1));
+}
+
+#define PAYLOAD_N_DIGITAL_CHANNELS u8_countBits(PAYLOAD_DIGITAL_CHANNEL_MASK)
+#define PAYLOAD_N_ANALOG_CHANNELS  (PAYLOAD_N_CHANNELS - PAYLOAD_N_DIGITAL_CHANNELS)
+
+static constexpr uint8_t u8_keyframeSize()
+{
+    return PAYLOAD_HEADER_SIZE + ((PAYLOAD_N_ANALOG_CHANNELS * PAYLOAD_ANALOG_BITS) + PAYLOAD_N_DIGITAL_CHANNELS + 7u) / 8u;
+}
+
+static constexpr uint8_t u8_deltaFrameSize(uint8_t deltaBits)
+{
+    return PAYLOAD_HEADER_SIZE + 1u + ((PAYLOAD_N_ANALOG_CHANNELS * deltaBits) + PAYLOAD_N_DIGITAL_CHANNELS + 7u) / 8u;
+}
+
+static_assert(PAYLOAD_N_CHANNELS <= 8u, "Digital channel mask is 8 bits wide");
+static_assert(PAYLOAD_FORMAT_VERSION <= 0x0Fu, "Format version is a 4 bit field");
+static_assert(u8_keyframeSize() <= PAYLOAD_MAX_SIZE, "Keyframe doesn't fit PAYLOAD_MAX_SIZE");
+static_assert(u8_deltaFrameSize(PAYLOAD_DELTA_MAX_BITS) <= PAYLOAD_MAX_SIZE, "Delta frame doesn't fit PAYLOAD_MAX_SIZE");
+static_assert(PAYLOAD_BIND_SIZE(PAYLOAD_MAX_HOP_CHANNELS) <= 32u, "Bind frame doesn't fit a radio payload");
+static_assert(u8_keyframeSize() + 1u <= PAYLOAD_MAX_SIZE, "Keyframe with a link setting doesn't fit PAYLOAD_MAX_SIZE");
+
+
+/** Internal functions **/
+static void     v_Pld_writeBits(uint8_t* pBuffer, uint16_t* pBitPos, uint16_t value, uint8_t nBits);
+static uint16_t u16_Pld_readBits(const uint8_t* pBuffer, uint16_t* pBitPos, uint8_t nBits);
+static bool     b_Pld_isDigital(uint8_t channelIdx);
+// Value the receiver decodes for an analog input: both frame kinds clamp to PAYLOAD_CHANNEL_MAX_VALUE
+static uint16_t u16_Pld_clamp(uint16_t value);
+// Smallest width (in PAYLOAD_DELTA_MIN_BITS - PAYLOAD_DELTA_MAX_BITS) holding every analog delta, 0 if none does
+static uint8_t  u8_Pld_deltaBits(const PldEncoder_t* pEncoder, const uint16_t* pChannels);
+static uint8_t  u8_Pld_encodeKeyframe(PldEncoder_t* pEncoder, const uint16_t* pChannels, uint8_t* pBuffer);
+static uint8_t  u8_Pld_encodeDelta(PldEncoder_t* pEncoder, const uint16_t* pChannels, uint8_t* pBuffer, uint8_t deltaBits);
+static void     v_Pld_countSequence(PldDecoder_t* pDecoder, uint8_t sequence);
+// Size of the channel fields of a frame starting with <header>, 0 if it isn't a channel frame
+static uint8_t  u8_Pld_channelFrameSize(uint8_t header);
+static void     v_Pld_writeU16(uint8_t* pBuffer, uint16_t value);
+static uint16_t u16_Pld_readU16(const uint8_t* pBuffer);
+
+
+void v_Pld_initEncoder(PldEncoder_t* pEncoder, bool deltaEnabled)
+{
+    memset(pEncoder, 0, sizeof(PldEncoder_t));
+    pEncoder->b_DeltaEnabled = deltaEnabled;
+}
+
+uint8_t u8_Pld_encode(PldEncoder_t* pEncoder, const uint16_t* pChannels, uint8_t* pBuffer)
+{
+    uint8_t deltaBits = 0u;
+    uint8_t size;
+
+    if(pEncoder->b_DeltaEnabled && pEncoder->b_KeyAcknowledged && (pEncoder->u8_FramesSinceKey < PAYLOAD_KEYFRAME_INTERVAL))
+    {
+        deltaBits = u8_Pld_deltaBits(pEncoder, pChannels);
+    }
+
+    // A delta frame as big as a keyframe has no point, a new keyframe also brings the deltas back down
+    if((deltaBits != 0u) && (u8_deltaFrameSize(deltaBits) < u8_keyframeSize()))
+    {
+        size = u8_Pld_encodeDelta(pEncoder, pChannels, pBuffer, deltaBits);
+        pEncoder->u8_FramesSinceKey++;
+    }
+    else
+    {
+        size = u8_Pld_encodeKeyframe(pEncoder, pChannels, pBuffer);
+    }
+    pEncoder->u8_Sequence++;
+    return size;
+}
+
+void v_Pld_acknowledge(PldEncoder_t* pEncoder)
+{
+    if(pEncoder->b_LastWasKey)
+    {
+        pEncoder->b_KeyAcknowledged = true;
+        pEncoder->u8_FramesSinceKey = 0u;
+    }
+}
+
+void v_Pld_initDecoder(PldDecoder_t* pDecoder)
+{
+    memset(pDecoder, 0, sizeof(PldDecoder_t));
+}
+
+bool b_Pld_decode(PldDecoder_t* pDecoder, const uint8_t* pBuffer, uint8_t size, uint16_t* pChannels)
+{
+    uint16_t bitPos = 0u;
+    uint8_t  i;
+    bool     isDelta;
+    uint8_t  deltaBits;
+
+    if((size < PAYLOAD_HEADER_SIZE) || ((pBuffer[0] >> 4) != PAYLOAD_FORMAT_VERSION))
+    {
+        return false;
+    }
+    isDelta   = (pBuffer[0] & PAYLOAD_DELTA_FLAG) != 0u;
+    deltaBits = (pBuffer[0] & PAYLOAD_DELTA_WIDTH_MASK) + PAYLOAD_DELTA_MIN_BITS;
+    if(!isDelta && ((pBuffer[0] & PAYLOAD_DELTA_WIDTH_MASK) != 0u)) // Bind frame, no sequence number
+    {
+        return false;
+    }
+    v_Pld_countSequence(pDecoder, pBuffer[1]);
+
+    if(!isDelta)
+    {
+        if(size < u8_keyframeSize())
+        {
+            return false;
+        }
+        for(i = 0; i < PAYLOAD_N_CHANNELS; i++)
+        {
+            pDecoder->u16_KeyChannels[i] = b_Pld_isDigital(i) ? (u16_Pld_readBits(&pBuffer[PAYLOAD_HEADER_SIZE], &bitPos, 1u) * PAYLOAD_CHANNEL_MAX_VALUE)
+                                                               : u16_Pld_readBits(&pBuffer[PAYLOAD_HEADER_SIZE], &bitPos, PAYLOAD_ANALOG_BITS);
+        }
+        pDecoder->b_HasKey       = true;
+        pDecoder->u8_KeySequence = pBuffer[1];
+        memcpy(pChannels, pDecoder->u16_KeyChannels, sizeof(pDecoder->u16_KeyChannels));
+    }
+    else
+    {
+        if((size < u8_deltaFrameSize(deltaBits)) || !pDecoder->b_HasKey || (pBuffer[PAYLOAD_HEADER_SIZE] != pDecoder->u8_KeySequence))
+        {
+            return false;
+        }
+        for(i = 0; i < PAYLOAD_N_CHANNELS; i++)
+        {
+            if(b_Pld_isDigital(i))
+            {
+                pChannels[i] = u16_Pld_readBits(&pBuffer[PAYLOAD_HEADER_SIZE + 1u], &bitPos, 1u) * PAYLOAD_CHANNEL_MAX_VALUE;
+            }
+            else
+            {
+                // Sign extension of the <deltaBits> wide two's complement field
+                int16_t delta = (int16_t)(u16_Pld_readBits(&pBuffer[PAYLOAD_HEADER_SIZE + 1u], &bitPos, deltaBits) << (16u - deltaBits)) >> (16u - deltaBits);
+                pChannels[i]  = (uint16_t)((int16_t)pDecoder->u16_KeyChannels[i] + delta) & PAYLOAD_CHANNEL_MAX_VALUE;
+            }
+        }
+    }
+    return true;
+}
+
+uint8_t u8_Pld_encodeBind(const uint8_t* pChannels, uint8_t nChannels, uint8_t* pBuffer)
+{
+    pBuffer[0] = (uint8_t)((PAYLOAD_FORMAT_VERSION << 4) | PAYLOAD_BIND_MARK);
+    pBuffer[1] = nChannels;
+    memcpy(&pBuffer[PAYLOAD_HEADER_SIZE], pChannels, nChannels);
+    return PAYLOAD_BIND_SIZE(nChannels);
+}
+
+bool b_Pld_decodeBind(const uint8_t* pBuffer, uint8_t size, uint8_t* pChannels, uint8_t* pNChannels)
+{
+    uint8_t nChannels;
+
+    if((size < PAYLOAD_HEADER_SIZE) || (pBuffer[0] != (uint8_t)((PAYLOAD_FORMAT_VERSION << 4) | PAYLOAD_BIND_MARK)))
+    {
+        return false;
+    }
+    nChannels = pBuffer[1];
+    if((nChannels == 0u) || (nChannels > PAYLOAD_MAX_HOP_CHANNELS) || ((nChannels & (nChannels - 1u)) != 0u) || (size < PAYLOAD_BIND_SIZE(nChannels)))
+    {
+        return false;
+    }
+    memcpy(pChannels, &pBuffer[PAYLOAD_HEADER_SIZE], nChannels);
+    *pNChannels = nChannels;
+    return true;
+}
+
+uint8_t u8_Pld_appendLinkSetting(uint8_t* pBuffer, uint8_t size, uint8_t setting)
+{
+    pBuffer[size] = setting;
+    return size + 1u;
+}
+
+bool b_Pld_decodeLinkSetting(const uint8_t* pBuffer, uint8_t size, uint8_t* pSetting)
+{
+    uint8_t fieldsSize;
+
+    if((size < PAYLOAD_HEADER_SIZE) || ((pBuffer[0] >> 4) != PAYLOAD_FORMAT_VERSION))
+    {
+        return false;
+    }
+    fieldsSize = u8_Pld_channelFrameSize(pBuffer[0]);
+    if((fieldsSize == 0u) || (size != fieldsSize + 1u))
+    {
+        return false;
+    }
+    *pSetting = pBuffer[fieldsSize];
+    return true;
+}
+
+uint8_t u8_Pld_encodeTelemetry(const PldTelemetry_t* pTelemetry, uint8_t* pBuffer)
+{
+    pBuffer[0] = (uint8_t)(PAYLOAD_FORMAT_VERSION << 4);
+    pBuffer[1] = pTelemetry->u8_LastSequence;
+    v_Pld_writeU16(&pBuffer[2], pTelemetry->u16_Received);
+    v_Pld_writeU16(&pBuffer[4], pTelemetry->u16_Lost);
+    v_Pld_writeU16(&pBuffer[6], pTelemetry->u16_LoopTime);
+    v_Pld_writeU16(&pBuffer[8], pTelemetry->u16_Voltage);
+    return PAYLOAD_TELEMETRY_SIZE;
+}
+
+bool b_Pld_decodeTelemetry(const uint8_t* pBuffer, uint8_t size, PldTelemetry_t* pTelemetry)
+{
+    if((size < PAYLOAD_TELEMETRY_SIZE) || ((pBuffer[0] >> 4) != PAYLOAD_FORMAT_VERSION))
+    {
+        return false;
+    }
+    pTelemetry->u8_LastSequence = pBuffer[1];
+    pTelemetry->u16_Received    = u16_Pld_readU16(&pBuffer[2]);
+    pTelemetry->u16_Lost        = u16_Pld_readU16(&pBuffer[4]);
+    pTelemetry->u16_LoopTime    = u16_Pld_readU16(&pBuffer[6]);
+    pTelemetry->u16_Voltage     = u16_Pld_readU16(&pBuffer[8]);
+    return true;
+}
+
+
+static void v_Pld_writeBits(uint8_t* pBuffer, uint16_t* pBitPos, uint16_t value, uint8_t nBits)
+{
+    uint8_t i;
+    for(i = 0; i < nBits; i++)
+    {
+        uint8_t mask = (uint8_t)(1u << (*pBitPos & 7u));
+        if(value & (1u << i))
+        {
+            pBuffer[*pBitPos >> 3] |= mask;
+        }
+        else
+        {
+            pBuffer[*pBitPos >> 3] &= (uint8_t)~mask;
+        }
+        (*pBitPos)++;
+    }
+}
+
+static uint16_t u16_Pld_readBits(const uint8_t* pBuffer, uint16_t* pBitPos, uint8_t nBits)
+{
+    uint8_t  i;
+    uint16_t value = 0u;
+    for(i = 0; i < nBits; i++)
+    {
+        if(pBuffer[*pBitPos >> 3] & (1u << (*pBitPos & 7u)))
+        {
+            value |= (1u << i);
+        }
+        (*pBitPos)++;
+    }
+    return value;
+}
+
+// A repeated sequence number (retransmission whose ACK was lost) is received again but isn't a gap
+static void v_Pld_countSequence(PldDecoder_t* pDecoder, uint8_t sequence)
+{
+    if(pDecoder->b_HasSequence && (sequence != pDecoder->u8_LastSequence))
+    {
+        pDecoder->u16_Lost += (uint8_t)(sequence - pDecoder->u8_LastSequence - 1u);
+    }
+    pDecoder->b_HasSequence   = true;
+    pDecoder->u8_LastSequence = sequence;
+    pDecoder->u16_Received++;
+}
+
+static uint8_t u8_Pld_channelFrameSize(uint8_t header)
+{
+    if(header & PAYLOAD_DELTA_FLAG)
+    {
+        return u8_deltaFrameSize((header & PAYLOAD_DELTA_WIDTH_MASK) + PAYLOAD_DELTA_MIN_BITS);
+    }
+    return ((header & PAYLOAD_DELTA_WIDTH_MASK) == 0u) ? u8_keyframeSize() : 0u; // Bind frame otherwise
+}
+
+static void v_Pld_writeU16(uint8_t* pBuffer, uint16_t value)
+{
+    pBuffer[0] = (uint8_t)(value & 0xFFu);
+    pBuffer[1] = (uint8_t)(value >> 8);
+}
+
+static uint16_t u16_Pld_readU16(const uint8_t* pBuffer)
+{
+    return (uint16_t)pBuffer[0] | ((uint16_t)pBuffer[1] << 8);
+}
+
+static bool b_Pld_isDigital(uint8_t channelIdx)
+{
+    return (PAYLOAD_DIGITAL_CHANNEL_MASK & (1u << channelIdx)) != 0u;
+}
+
+static uint16_t u16_Pld_clamp(uint16_t value)
+{
+    return (value > PAYLOAD_CHANNEL_MAX_VALUE) ? PAYLOAD_CHANNEL_MAX_VALUE : value;
+}
+
+static uint8_t u8_Pld_deltaBits(const PldEncoder_t* pEncoder, const uint16_t* pChannels)
+{
+    uint8_t i;
+    uint8_t deltaBits = PAYLOAD_DELTA_MIN_BITS;
+    for(i = 0; i < PAYLOAD_N_CHANNELS; i++)
+    {
+        int16_t delta;
+        if(b_Pld_isDigital(i))
+        {
+            continue;
+        }
+        delta = (int16_t)u16_Pld_clamp(pChannels[i]) - (int16_t)pEncoder->u16_KeyChannels[i];
+        while((delta < -(1 << (deltaBits - 1u))) || (delta > ((1 << (deltaBits - 1u)) - 1)))
+        {
+            if(++deltaBits > PAYLOAD_DELTA_MAX_BITS)
+            {
+                return 0u;
+            }
+        }
+    }
+    return deltaBits;
+}
+
+static uint8_t u8_Pld_encodeKeyframe(PldEncoder_t* pEncoder, const uint16_t* pChannels, uint8_t* pBuffer)
+{
+    uint16_t bitPos = 0u;
+    uint8_t  i;
+
+    pBuffer[0] = (uint8_t)(PAYLOAD_FORMAT_VERSION << 4);
+    pBuffer[1] = pEncoder->u8_Sequence;
+    for(i = 0; i < PAYLOAD_N_CHANNELS; i++)
+    {
+        uint16_t value = u16_Pld_clamp(pChannels[i]);
+        if(b_Pld_isDigital(i))
+        {
+            value = (value > (PAYLOAD_CHANNEL_MAX_VALUE / 2u)) ? PAYLOAD_CHANNEL_MAX_VALUE : 0u;
+            v_Pld_writeBits(&pBuffer[PAYLOAD_HEADER_SIZE], &bitPos, (value != 0u) ? 1u : 0u, 1u);
+        }
+        else
+        {
+            v_Pld_writeBits(&pBuffer[PAYLOAD_HEADER_SIZE], &bitPos, value, PAYLOAD_ANALOG_BITS);
+        }
+        pEncoder->u16_KeyChannels[i] = value; // Deltas are computed against what the receiver decoded, not the raw input
+    }
+
+    // Until this keyframe is acknowledged the receiver may still hold the previous one, so no deltas are sent
+    pEncoder->u8_KeySequence    = pEncoder->u8_Sequence;
+    pEncoder->b_KeyAcknowledged = false;
+    pEncoder->b_LastWasKey      = true;
+    return u8_keyframeSize();
+}
+
+static uint8_t u8_Pld_encodeDelta(PldEncoder_t* pEncoder, const uint16_t* pChannels, uint8_t* pBuffer, uint8_t deltaBits)
+{
+    uint16_t bitPos = 0u;
+    uint8_t  i;
+
+    pBuffer[0] = (uint8_t)((PAYLOAD_FORMAT_VERSION << 4) | PAYLOAD_DELTA_FLAG | (deltaBits - PAYLOAD_DELTA_MIN_BITS));
+    pBuffer[1] = pEncoder->u8_Sequence;
+    pBuffer[PAYLOAD_HEADER_SIZE] = pEncoder->u8_KeySequence;
+    for(i = 0; i < PAYLOAD_N_CHANNELS; i++)
+    {
+        if(b_Pld_isDigital(i))
+        {
+            v_Pld_writeBits(&pBuffer[PAYLOAD_HEADER_SIZE + 1u], &bitPos, (pChannels[i] > (PAYLOAD_CHANNEL_MAX_VALUE / 2u)) ? 1u : 0u, 1u);
+        }
+        else
+        {
+            int16_t delta = (int16_t)u16_Pld_clamp(pChannels[i]) - (int16_t)pEncoder->u16_KeyChannels[i];
+            v_Pld_writeBits(&pBuffer[PAYLOAD_HEADER_SIZE + 1u], &bitPos, (uint16_t)delta, deltaBits);
+        }
+    }
+    pEncoder->b_LastWasKey = false;
+    return u8_deltaFrameSize(deltaBits);
+}
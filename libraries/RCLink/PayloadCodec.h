@@ -0,0 +1,126 @@
+/**
+ * @file PayloadCodec.h
+ * @author Marcelo Fraga
+ * @brief Packed wire format of the RF frames, shared by the transmitter and the receiver (RCLink library). Only
+ * depends on <stdint.h> and <string.h>, so host tools can build these two files as they are.
+ *
+ * Every frame starts with a 2 byte header: format version (4 bits), delta flag (1 bit), delta width - 2 (3 bits),
+ * followed by an 8 bit sequence number. Channel fields follow, packed LSB first:
+ *  - Keyframe:    every analog channel as a PAYLOAD_ANALOG_BITS value, every digital channel as 1 bit.
+ *  - Delta frame: 1 byte with the sequence number of the reference keyframe, then every analog channel as a signed
+ *                 difference to that keyframe, all of the same width (2 - 9 bits), and the digital channels as 1 bit.
+ * The transmitter only sends deltas against a keyframe that was acknowledged, and keeps sending keyframes until one is,
+ * so the last keyframe received is always the one the deltas refer to. A frame that can't be decoded is dropped.
+ *
+ * A bind frame gives the receiver the channel hop sequence (FREQUENCY_HOPPING): header byte with the delta width bits
+ * all set and no delta flag (keyframes leave them clear), the number of hop channels (a power of 2, up to
+ * PAYLOAD_MAX_HOP_CHANNELS), then the channels in hop order. It is sent on the bind channel, which is never a hop
+ * channel. Once acknowledged, the frame of sequence number s goes on channel (s - s0) % n of the sequence, s0 being the
+ * first frame sent after the bind: it goes on the first channel, where the receiver waits for it. A receiver that heard
+ * any frame since knows where the next one will be.
+ *
+ * A channel frame (keyframe or delta) one byte longer than its fields carries a link setting (RATE_CONTROL, see
+ * LinkSetting.h): the receiver switches to it once it has received the frame, the transmitter once the frame is
+ * acknowledged, so the next frame is the first one on the new setting. Receivers ignoring the trailer decode it as usual.
+ *
+ * The receiver answers with a telemetry frame in the ACK payload (receiver -> transmitter): format version, then
+ * little endian counters, see PldTelemetry_t. It is preloaded, so it travels with the ACK of the next frame.
+ * @version 0.1
+ * @date 2026 - 10 - 17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef PAYLOADCODEC_H
+#define PAYLOADCODEC_H
+#include <stdint.h>
+#include <string.h>
+
+// Changes in this block involve changes on the receiver as well
+#define PAYLOAD_FORMAT_VERSION       1u
+#define PAYLOAD_N_CHANNELS           8u
+#define PAYLOAD_DIGITAL_CHANNEL_MASK 0xC0u  // Bit i set: channel i is a 2 position switch, sent as 1 bit
+#define PAYLOAD_ANALOG_BITS          10u
+#define PAYLOAD_CHANNEL_MAX_VALUE    ((1u << PAYLOAD_ANALOG_BITS) - 1u)
+
+#define PAYLOAD_KEYFRAME_INTERVAL    16u    // Frames sent against the same keyframe before a new one is sent
+#define PAYLOAD_HEADER_SIZE          2u
+#define PAYLOAD_DELTA_MIN_BITS       2u
+#define PAYLOAD_DELTA_MAX_BITS       9u
+#define PAYLOAD_MAX_SIZE             (PAYLOAD_HEADER_SIZE + ((PAYLOAD_N_CHANNELS * PAYLOAD_ANALOG_BITS) + 7u) / 8u)
+#define PAYLOAD_TELEMETRY_SIZE       10u
+#define PAYLOAD_MAX_HOP_CHANNELS     16u
+#define PAYLOAD_BIND_SIZE(nChannels) (PAYLOAD_HEADER_SIZE + (nChannels))
+
+typedef struct PldEncoder_t
+{
+    uint8_t  u8_Sequence;             // Sequence number of the next frame
+    uint8_t  u8_KeySequence;          // Sequence number of the current keyframe
+    uint8_t  u8_FramesSinceKey;
+    bool     b_LastWasKey;            // Kind of the last encoded frame, to know what an acknowledge refers to
+    bool     b_KeyAcknowledged;       // Deltas can be sent against the current keyframe
+    bool     b_DeltaEnabled;
+    uint16_t u16_KeyChannels[PAYLOAD_N_CHANNELS];
+}PldEncoder_t;
+
+typedef struct PldDecoder_t
+{
+    bool     b_HasKey;
+    bool     b_HasSequence;           // At least one frame was received, u8_LastSequence is valid
+    uint8_t  u8_KeySequence;
+    uint8_t  u8_LastSequence;         // Sequence number of the last received frame
+    uint16_t u16_Received;            // Frames with a valid header, decodable or not. Wraps around
+    uint16_t u16_Lost;                // Frames missing from the sequence numbers. Wraps around
+    uint16_t u16_KeyChannels[PAYLOAD_N_CHANNELS];
+}PldDecoder_t;
+
+typedef struct PldTelemetry_t
+{
+    uint8_t  u8_LastSequence;         // Sequence number of the last frame received
+    uint16_t u16_Received;            // See PldDecoder_t
+    uint16_t u16_Lost;
+    uint16_t u16_LoopTime;            // Receiver loop time, in uSeconds
+    uint16_t u16_Voltage;             // Receiver supply, in mV. 0 when not measured
+}PldTelemetry_t;
+
+
+/// @brief <deltaEnabled> false makes every frame a keyframe (no acknowledge needed).
+void    v_Pld_initEncoder(PldEncoder_t* pEncoder, bool deltaEnabled);
+
+/// @brief Encodes PAYLOAD_N_CHANNELS values (0 - PAYLOAD_CHANNEL_MAX_VALUE) into <pBuffer>, which must hold
+///        PAYLOAD_MAX_SIZE bytes. Returns the frame size. Every encoded frame is expected to be sent.
+uint8_t u8_Pld_encode(PldEncoder_t* pEncoder, const uint16_t* pChannels, uint8_t* pBuffer);
+
+/// @brief Reports that the last encoded frame was acknowledged by the receiver.
+void    v_Pld_acknowledge(PldEncoder_t* pEncoder);
+
+void    v_Pld_initDecoder(PldDecoder_t* pDecoder);
+
+/// @brief Decodes a frame of <size> bytes into PAYLOAD_N_CHANNELS values. Digital channels come out as 0 or
+///        PAYLOAD_CHANNEL_MAX_VALUE. Returns false, leaving <pChannels> untouched, if the frame is invalid or refers to
+///        a keyframe that wasn't received.
+bool    b_Pld_decode(PldDecoder_t* pDecoder, const uint8_t* pBuffer, uint8_t size, uint16_t* pChannels);
+
+/// @brief Writes the bind frame of the hop sequence <pChannels> (<nChannels>, a power of 2) into <pBuffer>, which must
+///        hold PAYLOAD_BIND_SIZE(nChannels) bytes. Returns the frame size.
+uint8_t u8_Pld_encodeBind(const uint8_t* pChannels, uint8_t nChannels, uint8_t* pBuffer);
+
+/// @brief Returns false, leaving the outputs untouched, if the frame isn't a valid bind frame of this format version.
+///        <pChannels> must hold PAYLOAD_MAX_HOP_CHANNELS channels.
+bool    b_Pld_decodeBind(const uint8_t* pBuffer, uint8_t size, uint8_t* pChannels, uint8_t* pNChannels);
+
+/// @brief Appends <setting> to the channel frame of <size> bytes in <pBuffer>, which must hold PAYLOAD_MAX_SIZE bytes.
+///        Returns the new frame size.
+uint8_t u8_Pld_appendLinkSetting(uint8_t* pBuffer, uint8_t size, uint8_t setting);
+
+/// @brief Returns false, leaving <pSetting> untouched, if the frame is not a channel frame carrying a link setting.
+bool    b_Pld_decodeLinkSetting(const uint8_t* pBuffer, uint8_t size, uint8_t* pSetting);
+
+/// @brief Writes <pTelemetry> into <pBuffer> (PAYLOAD_TELEMETRY_SIZE bytes). Returns the frame size.
+uint8_t u8_Pld_encodeTelemetry(const PldTelemetry_t* pTelemetry, uint8_t* pBuffer);
+
+/// @brief Returns false, leaving <pTelemetry> untouched, if the frame isn't a telemetry frame of this format version.
+bool    b_Pld_decodeTelemetry(const uint8_t* pBuffer, uint8_t size, PldTelemetry_t* pTelemetry);
+
+#endif